@@ -0,0 +1,99 @@
+/**
+ * @file BackendBenchmarks.cpp
+ *
+ * This module contains the benchmarks which compare the cryptographic
+ * backends built into the CryptoSigning library.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <CryptoSigning/Backends.hpp>
+#include <CryptoSigning/KeyGen.hpp>
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/Verify.hpp>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function compares the latency of making and verifying
+     * signatures with each backend which supports the given kind of key.
+     *
+     * @param[in] name
+     *     This is the name to use for the kind of key in the report.
+     *
+     * @param[in] spec
+     *     This describes the key to use.
+     *
+     * @param[in] iterations
+     *     This is the number of signatures to make and verify
+     *     with each backend.
+     */
+    void CompareBackends(
+        const std::string& name,
+        const CryptoSigning::KeySpec& spec,
+        size_t iterations
+    ) {
+        const auto key = CryptoSigning::GenerateKey(spec);
+        const std::vector< uint8_t > data(256, 0x5a);
+        for (const auto& backendName: CryptoSigning::GetBackendNames()) {
+            CryptoSigning::Sign sign;
+            CryptoSigning::Verify verify;
+            (void)sign.SetBackend(backendName);
+            (void)verify.SetBackend(backendName);
+            if (
+                !sign.Configure(key.privateKeyPem)
+                || !verify.Configure(key.publicKeyPem)
+            ) {
+                continue;
+            }
+            const auto prefix = name + " " + backendName;
+            const auto signOnce = [&]{ (void)sign(data); };
+            (void)Benchmark::Measure(signOnce, iterations / 10);
+            Benchmark::Report(
+                prefix + " sign",
+                Benchmark::Measure(signOnce, iterations)
+            );
+            const auto signature = sign(data);
+            const auto verifyOnce = [&]{ (void)verify(data, signature); };
+            (void)Benchmark::Measure(verifyOnce, iterations / 10);
+            Benchmark::Report(
+                prefix + " verify",
+                Benchmark::Measure(verifyOnce, iterations)
+            );
+        }
+    }
+
+    const Benchmark::Registration compareRsa2048(
+        "Backend/RSA-2048",
+        []{
+            CryptoSigning::KeySpec spec;
+            spec.type = CryptoSigning::KeyType::Rsa;
+            spec.bits = 2048;
+            CompareBackends("RSA-2048", spec, 5000);
+        }
+    );
+
+    const Benchmark::Registration compareEcP256(
+        "Backend/EC-P256",
+        []{
+            CryptoSigning::KeySpec spec;
+            spec.type = CryptoSigning::KeyType::EcP256;
+            CompareBackends("EC-P256", spec, 20000);
+        }
+    );
+
+    const Benchmark::Registration compareEd25519(
+        "Backend/Ed25519",
+        []{
+            CryptoSigning::KeySpec spec;
+            spec.type = CryptoSigning::KeyType::Ed25519;
+            CompareBackends("Ed25519", spec, 20000);
+        }
+    );
+
+}
@@ -0,0 +1,129 @@
+/**
+ * @file Benchmark.cpp
+ *
+ * This module contains the implementation of the functions shared
+ * by the benchmarks of the CryptoSigning library.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <CryptoSigning/KeyGen.hpp>
+#include <map>
+#include <stdio.h>
+
+namespace {
+
+    /**
+     * This function returns the registry of benchmarks.
+     *
+     * @return
+     *     The registry of benchmarks, indexed by name, is returned.
+     */
+    std::map< std::string, Benchmark::Runner >& GetRegistry() {
+        static std::map< std::string, Benchmark::Runner > registry;
+        return registry;
+    }
+
+    /**
+     * This function returns the given percentile of the given sorted
+     * measurements.
+     *
+     * @param[in] samples
+     *     These are the sorted measurements.
+     *
+     * @param[in] percentile
+     *     This is the percentile to return.
+     *
+     * @return
+     *     The given percentile of the measurements is returned.
+     */
+    double Percentile(
+        const std::vector< double >& samples,
+        double percentile
+    ) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        auto index = (size_t)(percentile / 100.0 * (double)samples.size());
+        if (index >= samples.size()) {
+            index = samples.size() - 1;
+        }
+        return samples[index];
+    }
+
+}
+
+namespace Benchmark {
+
+    Registration::Registration(
+        const std::string& name,
+        Runner runner
+    ) {
+        GetRegistry()[name] = runner;
+    }
+
+    void RunAll(const std::string& filter) {
+        for (const auto& benchmark: GetRegistry()) {
+            if (benchmark.first.find(filter) == std::string::npos) {
+                continue;
+            }
+            printf("== %s\n", benchmark.first.c_str());
+            benchmark.second();
+        }
+    }
+
+    std::vector< double > Measure(
+        Operation operation,
+        size_t iterations
+    ) {
+        std::vector< double > samples;
+        samples.reserve(iterations);
+        for (size_t i = 0; i < iterations; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            operation();
+            const auto end = std::chrono::steady_clock::now();
+            samples.push_back(
+                std::chrono::duration< double, std::micro >(end - start).count()
+            );
+        }
+        return samples;
+    }
+
+    void Report(
+        const std::string& name,
+        std::vector< double > samples
+    ) {
+        std::sort(samples.begin(), samples.end());
+        double total = 0.0;
+        for (const auto sample: samples) {
+            total += sample;
+        }
+        const auto mean = samples.empty() ? 0.0 : total / samples.size();
+        printf(
+            "%-40s n=%-6zu mean=%10.1fus p50=%10.1fus p99=%10.1fus p999=%10.1fus %10.1f ops/s\n",
+            name.c_str(),
+            samples.size(),
+            mean,
+            Percentile(samples, 50.0),
+            Percentile(samples, 99.0),
+            Percentile(samples, 99.9),
+            (mean > 0.0) ? 1e6 / mean : 0.0
+        );
+    }
+
+    std::string GenerateRsaKey(
+        int bits,
+        int primes
+    ) {
+        CryptoSigning::KeySpec spec;
+        spec.type = CryptoSigning::KeyType::Rsa;
+        spec.bits = bits;
+        spec.primes = primes;
+        return CryptoSigning::GenerateKey(spec).privateKeyPem;
+    }
+
+}
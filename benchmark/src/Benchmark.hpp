@@ -0,0 +1,116 @@
+#ifndef CRYPTO_SIGNING_BENCHMARK_HPP
+#define CRYPTO_SIGNING_BENCHMARK_HPP
+
+/**
+ * @file Benchmark.hpp
+ *
+ * This module declares the functions shared by the benchmarks
+ * of the CryptoSigning library.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <functional>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Benchmark {
+
+    /**
+     * This is the type of function which runs one benchmark.
+     */
+    typedef std::function< void() > Runner;
+
+    /**
+     * This is the type of function which performs one operation
+     * being measured.
+     */
+    typedef std::function< void() > Operation;
+
+    /**
+     * Declaring a static instance of this structure registers a benchmark
+     * to be run by the benchmark program.
+     */
+    struct Registration {
+        /**
+         * This constructor registers the given benchmark.
+         *
+         * @param[in] name
+         *     This is the name of the benchmark, used to select it
+         *     on the command line.
+         *
+         * @param[in] runner
+         *     This is the function which runs the benchmark.
+         */
+        Registration(
+            const std::string& name,
+            Runner runner
+        );
+    };
+
+    /**
+     * This function runs every registered benchmark whose name contains
+     * the given filter.
+     *
+     * @param[in] filter
+     *     This is the text which must be contained in the name of each
+     *     benchmark to run.  If empty, all benchmarks are run.
+     */
+    void RunAll(const std::string& filter);
+
+    /**
+     * This function times the given operation repeatedly.
+     *
+     * @param[in] operation
+     *     This is the operation to time.
+     *
+     * @param[in] iterations
+     *     This is the number of times to time the operation.
+     *
+     * @return
+     *     The time taken by each run of the operation, in microseconds,
+     *     is returned.
+     */
+    std::vector< double > Measure(
+        Operation operation,
+        size_t iterations
+    );
+
+    /**
+     * This function prints a summary line for the given measurements:
+     * the mean latency, the 50th, 99th and 99.9th percentile latencies,
+     * and the rate at which operations were completed.
+     *
+     * @param[in] name
+     *     This is the name to give the measurements.
+     *
+     * @param[in] samples
+     *     These are the times taken by each run of the operation,
+     *     in microseconds.
+     */
+    void Report(
+        const std::string& name,
+        std::vector< double > samples
+    );
+
+    /**
+     * This function generates a new RSA private key.
+     *
+     * @param[in] bits
+     *     This is the size of the modulus of the key, in bits.
+     *
+     * @param[in] primes
+     *     This is the number of prime factors of the modulus.
+     *
+     * @return
+     *     The new private key, in PEM format, is returned.
+     */
+    std::string GenerateRsaKey(
+        int bits,
+        int primes = 2
+    );
+
+}
+
+#endif /* CRYPTO_SIGNING_BENCHMARK_HPP */
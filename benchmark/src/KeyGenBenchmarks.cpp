@@ -0,0 +1,80 @@
+/**
+ * @file KeyGenBenchmarks.cpp
+ *
+ * This module contains the benchmarks of the CryptoSigning::GenerateKey
+ * function and the CryptoSigning::KeyPool class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <CryptoSigning/KeyGen.hpp>
+#include <CryptoSigning/KeyPool.hpp>
+#include <string>
+#include <thread>
+
+namespace {
+
+    /**
+     * This function compares the latency of generating keys on demand
+     * with that of taking them from a pool filled ahead of time.
+     *
+     * @param[in] name
+     *     This is the name to use for the kind of key in the report.
+     *
+     * @param[in] spec
+     *     This describes the keys to generate.
+     *
+     * @param[in] iterations
+     *     This is the number of keys to obtain in each mode.
+     */
+    void Pool(
+        const std::string& name,
+        const CryptoSigning::KeySpec& spec,
+        size_t iterations
+    ) {
+        Benchmark::Report(
+            name + " generate",
+            Benchmark::Measure(
+                [&]{ (void)CryptoSigning::GenerateKey(spec); },
+                iterations
+            )
+        );
+        CryptoSigning::KeyPool pool;
+        if (!pool.Configure(spec, iterations)) {
+            return;
+        }
+        while (pool.GetPoolLevel() < iterations) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        Benchmark::Report(
+            name + " take from pool",
+            Benchmark::Measure(
+                [&]{ (void)pool.Take(); },
+                iterations
+            )
+        );
+    }
+
+    const Benchmark::Registration poolEcP256(
+        "KeyGen/Pool/EC-P256",
+        []{
+            CryptoSigning::KeySpec spec;
+            spec.type = CryptoSigning::KeyType::EcP256;
+            Pool("EC-P256", spec, 1000);
+        }
+    );
+
+    const Benchmark::Registration poolRsa2048(
+        "KeyGen/Pool/2048",
+        []{
+            CryptoSigning::KeySpec spec;
+            spec.type = CryptoSigning::KeyType::Rsa;
+            spec.bits = 2048;
+            Pool("RSA-2048", spec, 20);
+        }
+    );
+
+}
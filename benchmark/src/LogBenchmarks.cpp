@@ -0,0 +1,100 @@
+/**
+ * @file LogBenchmarks.cpp
+ *
+ * This module contains the benchmarks of the CryptoSigning::LogSign
+ * and CryptoSigning::LogVerify classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <CryptoSigning/LogSign.hpp>
+#include <CryptoSigning/LogVerify.hpp>
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/Verify.hpp>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function compares the latency of re-verifying a growing log
+     * by checking a signature of the whole log with that of checking
+     * only the entries appended since the last verified checkpoint.
+     *
+     * @param[in] logEntries
+     *     This is the number of entries in the log already verified.
+     *
+     * @param[in] newEntries
+     *     This is the number of entries appended since.
+     *
+     * @param[in] entrySize
+     *     This is the size, in bytes, of each entry.
+     *
+     * @param[in] iterations
+     *     This is the number of times to re-verify the log in each mode.
+     */
+    void Reverify(
+        size_t logEntries,
+        size_t newEntries,
+        size_t entrySize,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(2048);
+        auto sign = std::make_shared< CryptoSigning::Sign >();
+        auto verify = std::make_shared< CryptoSigning::Verify >();
+        (void)sign->Configure(keyPem);
+        (void)verify->Configure(keyPem);
+        std::vector< std::vector< uint8_t > > entries;
+        std::vector< uint8_t > wholeLog;
+        for (size_t i = 0; i < logEntries + newEntries; ++i) {
+            entries.emplace_back(entrySize, (uint8_t)i);
+            wholeLog.insert(wholeLog.end(), entries.back().begin(), entries.back().end());
+        }
+        const auto wholeLogSignature = (*sign)(wholeLog);
+        CryptoSigning::LogSign logSign;
+        logSign.Configure(sign);
+        for (size_t i = 0; i < logEntries; ++i) {
+            logSign.Append(entries[i]);
+        }
+        const auto verifiedCheckpoint = logSign.Checkpoint();
+        for (size_t i = logEntries; i < entries.size(); ++i) {
+            logSign.Append(entries[i]);
+        }
+        const auto newCheckpoint = logSign.Checkpoint();
+        const std::vector< std::vector< uint8_t > > appended(
+            entries.begin() + logEntries,
+            entries.end()
+        );
+        const auto prefix = (
+            std::to_string(logEntries) + "+" + std::to_string(newEntries)
+            + " entries of " + std::to_string(entrySize) + "B"
+        );
+        const auto verifyWholeLog = [&]{ (void)(*verify)(wholeLog, wholeLogSignature); };
+        (void)Benchmark::Measure(verifyWholeLog, iterations / 10);
+        Benchmark::Report(
+            prefix + " whole log",
+            Benchmark::Measure(verifyWholeLog, iterations)
+        );
+        CryptoSigning::LogVerify logVerify;
+        const auto verifyNewEntries = [&]{
+            logVerify.Configure(verify);
+            (void)logVerify.Resume(verifiedCheckpoint);
+            (void)logVerify(appended, newCheckpoint);
+        };
+        (void)Benchmark::Measure(verifyNewEntries, iterations / 10);
+        Benchmark::Report(
+            prefix + " from checkpoint",
+            Benchmark::Measure(verifyNewEntries, iterations)
+        );
+    }
+
+    const Benchmark::Registration reverify(
+        "Log/Reverify/2048",
+        []{ Reverify(100000, 100, 256, 200); }
+    );
+
+}
@@ -0,0 +1,317 @@
+/**
+ * @file SignBenchmarks.cpp
+ *
+ * This module contains the benchmarks of the CryptoSigning::Sign class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/SignPipeline.hpp>
+#include <CryptoSigning/SignScheduler.hpp>
+#include <future>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function compares the latency of making signatures with and
+     * without the RSA blinding factor pool turned on.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] iterations
+     *     This is the number of signatures to make in each mode.
+     */
+    void BlindingPool(
+        int bits,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        const std::vector< uint8_t > data(256, 0x5a);
+        CryptoSigning::Sign sign;
+        (void)sign.Configure(keyPem);
+        const auto signOnce = [&]{ (void)sign(data); };
+        const auto prefix = "RSA-" + std::to_string(bits);
+        (void)Benchmark::Measure(signOnce, iterations / 10);
+        Benchmark::Report(
+            prefix + " default",
+            Benchmark::Measure(signOnce, iterations)
+        );
+        (void)sign.SetBlindingPoolSize(64);
+        (void)Benchmark::Measure(signOnce, iterations / 10);
+        Benchmark::Report(
+            prefix + " blinding pool",
+            Benchmark::Measure(signOnce, iterations)
+        );
+    }
+
+    /**
+     * This function compares the latency of making signatures with RSA
+     * keys of the same size but with different numbers of prime factors.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA keys to use, in bits.
+     *
+     * @param[in] maxPrimes
+     *     This is the largest number of prime factors to try.
+     *
+     * @param[in] iterations
+     *     This is the number of signatures to make with each key.
+     */
+    void MultiPrime(
+        int bits,
+        int maxPrimes,
+        size_t iterations
+    ) {
+        const std::vector< uint8_t > data(256, 0x5a);
+        for (int primes = 2; primes <= maxPrimes; ++primes) {
+            const auto keyPem = Benchmark::GenerateRsaKey(bits, primes);
+            CryptoSigning::Sign sign;
+            (void)sign.Configure(keyPem);
+            const auto signOnce = [&]{ (void)sign(data); };
+            const auto prefix = (
+                "RSA-" + std::to_string(bits)
+                + " " + std::to_string(primes) + "-prime"
+            );
+            (void)Benchmark::Measure(signOnce, iterations / 10);
+            Benchmark::Report(
+                prefix + " default",
+                Benchmark::Measure(signOnce, iterations)
+            );
+            (void)sign.SetBlindingPoolSize(64);
+            (void)Benchmark::Measure(signOnce, iterations / 10);
+            Benchmark::Report(
+                prefix + " blinding pool",
+                Benchmark::Measure(signOnce, iterations)
+            );
+        }
+    }
+
+    /**
+     * This function measures the latency of interactive signing requests
+     * made while a backlog of bulk requests is waiting, first with the
+     * interactive requests in the same class as the bulk ones, and then
+     * with them marked as urgent.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] backlog
+     *     This is the number of bulk requests to keep waiting.
+     *
+     * @param[in] iterations
+     *     This is the number of interactive requests to make in each mode.
+     */
+    void Scheduler(
+        int bits,
+        size_t backlog,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        const std::vector< uint8_t > data(256, 0x5a);
+        const auto sign = std::make_shared< CryptoSigning::Sign >();
+        (void)sign->Configure(keyPem);
+        const auto prefix = "RSA-" + std::to_string(bits);
+        const struct {
+            const char* name;
+            CryptoSigning::SignPriority priority;
+        } modes[] = {
+            {" interactive as bulk", CryptoSigning::SignPriority::Bulk},
+            {" interactive as urgent", CryptoSigning::SignPriority::Urgent},
+        };
+        for (const auto& mode: modes) {
+            CryptoSigning::SignScheduler scheduler;
+            scheduler.Start(sign);
+            const auto signOnce = [&]{
+                const auto waiting = scheduler.GetMetrics(
+                    CryptoSigning::SignPriority::Bulk
+                ).queueDepth;
+                for (size_t i = waiting; i < backlog; ++i) {
+                    (void)scheduler.Submit(
+                        data,
+                        CryptoSigning::SignPriority::Bulk
+                    );
+                }
+                (void)scheduler.Submit(data, mode.priority).get();
+            };
+            Benchmark::Report(
+                prefix + mode.name,
+                Benchmark::Measure(signOnce, iterations)
+            );
+            scheduler.Stop();
+        }
+    }
+
+    /**
+     * This function compares the latency of signing one data chunk with
+     * several keys, one key at a time, and all at once with the data
+     * chunk digested only once.
+     *
+     * @param[in] numKeys
+     *     This is the number of RSA-2048 keys with which to sign.
+     *
+     * @param[in] dataSize
+     *     This is the size, in bytes, of the data chunk to sign.
+     *
+     * @param[in] iterations
+     *     This is the number of times to sign the data chunk in each mode.
+     */
+    void FanOut(
+        size_t numKeys,
+        size_t dataSize,
+        size_t iterations
+    ) {
+        const std::vector< uint8_t > data(dataSize, 0x5a);
+        std::vector< std::unique_ptr< CryptoSigning::Sign > > signs;
+        std::vector< CryptoSigning::Sign* > signers;
+        for (size_t i = 0; i < numKeys; ++i) {
+            signs.emplace_back(new CryptoSigning::Sign());
+            (void)signs.back()->Configure(Benchmark::GenerateRsaKey(2048));
+            signers.push_back(signs.back().get());
+        }
+        const auto prefix = (
+            std::to_string(numKeys) + " keys "
+            + std::to_string(dataSize / 1024) + "KiB"
+        );
+        const auto signOneAtATime = [&]{
+            for (const auto signer: signers) {
+                (void)(*signer)(data);
+            }
+        };
+        (void)Benchmark::Measure(signOneAtATime, iterations / 10);
+        Benchmark::Report(
+            prefix + " one at a time",
+            Benchmark::Measure(signOneAtATime, iterations)
+        );
+        const auto signWithEach = [&]{
+            (void)CryptoSigning::Sign::SignWithEach(signers, data, 1);
+        };
+        (void)Benchmark::Measure(signWithEach, iterations / 10);
+        Benchmark::Report(
+            prefix + " hash once",
+            Benchmark::Measure(signWithEach, iterations)
+        );
+        const auto signWithEachInParallel = [&]{
+            (void)CryptoSigning::Sign::SignWithEach(signers, data);
+        };
+        (void)Benchmark::Measure(signWithEachInParallel, iterations / 10);
+        Benchmark::Report(
+            prefix + " hash once, parallel",
+            Benchmark::Measure(signWithEachInParallel, iterations)
+        );
+    }
+
+    /**
+     * This function compares the time taken to sign a stream of data
+     * chunks one after another, and through a pipeline which digests each
+     * data chunk while the one before it is being signed.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] dataSize
+     *     This is the size, in bytes, of each data chunk.
+     *
+     * @param[in] streamLength
+     *     This is the number of data chunks in the stream.
+     *
+     * @param[in] iterations
+     *     This is the number of times to sign the stream in each mode.
+     */
+    void Pipeline(
+        int bits,
+        size_t dataSize,
+        size_t streamLength,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        const std::vector< uint8_t > data(dataSize, 0x5a);
+        const auto sign = std::make_shared< CryptoSigning::Sign >();
+        (void)sign->Configure(keyPem);
+        const auto perDataChunk = [streamLength](std::vector< double > samples){
+            for (auto& sample: samples) {
+                sample /= (double)streamLength;
+            }
+            return samples;
+        };
+        const auto prefix = (
+            "RSA-" + std::to_string(bits) + " "
+            + std::to_string(dataSize / 1024) + "KiB"
+        );
+        const auto signSerially = [&]{
+            for (size_t i = 0; i < streamLength; ++i) {
+                (void)(*sign)(data);
+            }
+        };
+        (void)Benchmark::Measure(signSerially, iterations / 10);
+        Benchmark::Report(
+            prefix + " serial",
+            perDataChunk(Benchmark::Measure(signSerially, iterations))
+        );
+        CryptoSigning::SignPipeline pipeline;
+        pipeline.Start(sign, 8);
+        const auto signThroughPipeline = [&]{
+            std::thread producer(
+                [&]{
+                    for (size_t i = 0; i < streamLength; ++i) {
+                        (void)pipeline.Push(data);
+                    }
+                }
+            );
+            std::vector< uint8_t > signature;
+            for (size_t i = 0; i < streamLength; ++i) {
+                (void)pipeline.Pop(signature);
+            }
+            producer.join();
+        };
+        (void)Benchmark::Measure(signThroughPipeline, iterations / 10);
+        Benchmark::Report(
+            prefix + " pipeline",
+            perDataChunk(Benchmark::Measure(signThroughPipeline, iterations))
+        );
+    }
+
+    const Benchmark::Registration blindingPool2048(
+        "Sign/BlindingPool/2048",
+        []{ BlindingPool(2048, 5000); }
+    );
+
+    const Benchmark::Registration blindingPool4096(
+        "Sign/BlindingPool/4096",
+        []{ BlindingPool(4096, 1000); }
+    );
+
+    const Benchmark::Registration fanOut(
+        "Sign/FanOut/2048",
+        []{ FanOut(3, 1024 * 1024, 500); }
+    );
+
+    const Benchmark::Registration multiPrime2048(
+        "Sign/MultiPrime/2048",
+        []{ MultiPrime(2048, 3, 5000); }
+    );
+
+    const Benchmark::Registration multiPrime4096(
+        "Sign/MultiPrime/4096",
+        []{ MultiPrime(4096, 4, 1000); }
+    );
+
+    const Benchmark::Registration pipeline2048(
+        "Sign/Pipeline/2048",
+        []{ Pipeline(2048, 1024 * 1024, 32, 50); }
+    );
+
+    const Benchmark::Registration scheduler2048(
+        "Sign/Scheduler/2048",
+        []{ Scheduler(2048, 32, 100); }
+    );
+
+}
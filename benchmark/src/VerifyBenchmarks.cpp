@@ -0,0 +1,406 @@
+/**
+ * @file VerifyBenchmarks.cpp
+ *
+ * This module contains the benchmarks of the CryptoSigning::Verify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/Verify.hpp>
+#include <memory>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function encodes the given data in unpadded base64url.
+     *
+     * @param[in] data
+     *     This is the data to encode.
+     *
+     * @return
+     *     The unpadded base64url encoding of the data is returned.
+     */
+    std::string Base64UrlEncode(const std::string& data) {
+        std::string output(((data.size() + 2) / 3) * 4 + 1, '\0');
+        const auto length = EVP_EncodeBlock(
+            (unsigned char*)&output[0],
+            (const unsigned char*)data.data(),
+            (int)data.size()
+        );
+        output.resize((size_t)length);
+        while (!output.empty() && (output.back() == '=')) {
+            output.pop_back();
+        }
+        std::replace(output.begin(), output.end(), '+', '-');
+        std::replace(output.begin(), output.end(), '/', '_');
+        return output;
+    }
+
+    /**
+     * This function verifies the given token the way callers did before
+     * Verify::VerifyJwsCompact existed: by splitting the token, copying
+     * the signing input, and decoding the signature into new buffers.
+     *
+     * @param[in] verify
+     *     This is the instance to use to verify the signature.
+     *
+     * @param[in] token
+     *     This is the token to verify.
+     *
+     * @return
+     *     An indication of whether or not the token's signature
+     *     is valid is returned.
+     */
+    bool VerifyByCopying(
+        CryptoSigning::Verify& verify,
+        const std::string& token
+    ) {
+        const auto secondPeriod = token.rfind('.');
+        const std::vector< uint8_t > signingInput(
+            token.begin(),
+            token.begin() + secondPeriod
+        );
+        auto encodedSignature = token.substr(secondPeriod + 1);
+        std::replace(encodedSignature.begin(), encodedSignature.end(), '-', '+');
+        std::replace(encodedSignature.begin(), encodedSignature.end(), '_', '/');
+        const auto padding = (4 - encodedSignature.size() % 4) % 4;
+        encodedSignature.append(padding, '=');
+        std::vector< uint8_t > signature(encodedSignature.size() / 4 * 3);
+        const auto length = EVP_DecodeBlock(
+            signature.data(),
+            (const unsigned char*)encodedSignature.data(),
+            (int)encodedSignature.size()
+        );
+        if (length < 0) {
+            return false;
+        }
+        signature.resize((size_t)length - padding);
+        return verify(signingInput, signature);
+    }
+
+    /**
+     * This function compares the latency of verifying a JSON Web Signature
+     * by copying its parts with that of Verify::VerifyJwsCompact.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] iterations
+     *     This is the number of tokens to verify in each mode.
+     */
+    void JwsCompact(
+        int bits,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        const auto signingInput = (
+            Base64UrlEncode("{\"alg\":\"RS256\",\"typ\":\"JWT\"}")
+            + "."
+            + Base64UrlEncode(std::string(512, 'x'))
+        );
+        CryptoSigning::Sign sign;
+        (void)sign.Configure(keyPem);
+        const auto signature = sign(
+            std::vector< uint8_t >(signingInput.begin(), signingInput.end())
+        );
+        const auto token = (
+            signingInput
+            + "."
+            + Base64UrlEncode(std::string(signature.begin(), signature.end()))
+        );
+        CryptoSigning::Verify verify;
+        (void)verify.Configure(keyPem);
+        const auto prefix = "RSA-" + std::to_string(bits);
+        const auto verifyByCopying = [&]{ (void)VerifyByCopying(verify, token); };
+        (void)Benchmark::Measure(verifyByCopying, iterations / 10);
+        Benchmark::Report(
+            prefix + " split and copy",
+            Benchmark::Measure(verifyByCopying, iterations)
+        );
+        const auto verifyInPlace = [&]{ (void)verify.VerifyJwsCompact(token); };
+        (void)Benchmark::Measure(verifyInPlace, iterations / 10);
+        Benchmark::Report(
+            prefix + " in place",
+            Benchmark::Measure(verifyInPlace, iterations)
+        );
+    }
+
+    /**
+     * This function compares the time per signature of verifying a batch
+     * of signatures made with the same key one at a time with that of
+     * verifying them with Verify::VerifyBatch.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] batchSize
+     *     This is the number of signatures in each batch.
+     *
+     * @param[in] iterations
+     *     This is the number of batches to verify in each mode.
+     */
+    void Batch(
+        int bits,
+        size_t batchSize,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        CryptoSigning::Sign sign;
+        (void)sign.Configure(keyPem);
+        std::vector< std::vector< uint8_t > > dataChunks;
+        std::vector< std::vector< uint8_t > > signatures;
+        for (size_t i = 0; i < batchSize; ++i) {
+            dataChunks.emplace_back(256, (uint8_t)i);
+            signatures.push_back(sign(dataChunks.back()));
+        }
+        CryptoSigning::Verify verify;
+        (void)verify.Configure(keyPem);
+        const auto perSignature = [batchSize](std::vector< double > samples){
+            for (auto& sample: samples) {
+                sample /= (double)batchSize;
+            }
+            return samples;
+        };
+        const auto prefix = "RSA-" + std::to_string(bits);
+        const auto verifyOneAtATime = [&]{
+            for (size_t i = 0; i < batchSize; ++i) {
+                (void)verify(dataChunks[i], signatures[i]);
+            }
+        };
+        (void)Benchmark::Measure(verifyOneAtATime, iterations / 10);
+        Benchmark::Report(
+            prefix + " one at a time",
+            perSignature(Benchmark::Measure(verifyOneAtATime, iterations))
+        );
+        const auto verifyBatch = [&]{
+            (void)verify.VerifyBatch(dataChunks, signatures);
+        };
+        (void)Benchmark::Measure(verifyBatch, iterations / 10);
+        Benchmark::Report(
+            prefix + " batch",
+            perSignature(Benchmark::Measure(verifyBatch, iterations))
+        );
+    }
+
+    /**
+     * This function compares the latency of verifying signatures with
+     * and without another thread reconfiguring the key of the same
+     * instance.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] iterations
+     *     This is the number of signatures to verify in each mode.
+     */
+    void Rotation(
+        int bits,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        const std::vector< uint8_t > data(256, 0x5a);
+        CryptoSigning::Sign sign;
+        (void)sign.Configure(keyPem);
+        const auto signature = sign(data);
+        CryptoSigning::Verify verify;
+        (void)verify.Configure(keyPem);
+        const auto verifyOnce = [&]{ (void)verify(data, signature); };
+        const auto prefix = "RSA-" + std::to_string(bits);
+        (void)Benchmark::Measure(verifyOnce, iterations / 10);
+        Benchmark::Report(
+            prefix + " steady",
+            Benchmark::Measure(verifyOnce, iterations)
+        );
+        std::atomic< bool > stop(false);
+        std::thread rotator(
+            [&]{
+                while (!stop) {
+                    (void)verify.Configure(keyPem);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        );
+        (void)Benchmark::Measure(verifyOnce, iterations / 10);
+        Benchmark::Report(
+            prefix + " rotating every 1ms",
+            Benchmark::Measure(verifyOnce, iterations)
+        );
+        stop = true;
+        rotator.join();
+    }
+
+    /**
+     * This function compares the latency of verifying several signatures
+     * of one data chunk, each with its own key, one at a time, and all at
+     * once with the data chunk digested only once.
+     *
+     * @param[in] numKeys
+     *     This is the number of RSA-2048 keys with which to verify.
+     *
+     * @param[in] dataSize
+     *     This is the size, in bytes, of the data chunk to verify.
+     *
+     * @param[in] iterations
+     *     This is the number of times to verify the signatures in each mode.
+     */
+    void FanOut(
+        size_t numKeys,
+        size_t dataSize,
+        size_t iterations
+    ) {
+        const std::vector< uint8_t > data(dataSize, 0x5a);
+        std::vector< std::unique_ptr< CryptoSigning::Verify > > verifies;
+        std::vector< CryptoSigning::Verify* > verifiers;
+        std::vector< std::vector< uint8_t > > signatures;
+        for (size_t i = 0; i < numKeys; ++i) {
+            const auto keyPem = Benchmark::GenerateRsaKey(2048);
+            CryptoSigning::Sign sign;
+            (void)sign.Configure(keyPem);
+            signatures.push_back(sign(data));
+            verifies.emplace_back(new CryptoSigning::Verify());
+            (void)verifies.back()->Configure(keyPem);
+            verifiers.push_back(verifies.back().get());
+        }
+        const auto prefix = (
+            std::to_string(numKeys) + " keys "
+            + std::to_string(dataSize / 1024) + "KiB"
+        );
+        const auto verifyOneAtATime = [&]{
+            for (size_t i = 0; i < numKeys; ++i) {
+                (void)(*verifiers[i])(data, signatures[i]);
+            }
+        };
+        (void)Benchmark::Measure(verifyOneAtATime, iterations / 10);
+        Benchmark::Report(
+            prefix + " one at a time",
+            Benchmark::Measure(verifyOneAtATime, iterations)
+        );
+        const auto verifyWithEach = [&]{
+            (void)CryptoSigning::Verify::VerifyWithEach(
+                verifiers,
+                data,
+                signatures,
+                1
+            );
+        };
+        (void)Benchmark::Measure(verifyWithEach, iterations / 10);
+        Benchmark::Report(
+            prefix + " hash once",
+            Benchmark::Measure(verifyWithEach, iterations)
+        );
+        const auto verifyWithEachInParallel = [&]{
+            (void)CryptoSigning::Verify::VerifyWithEach(
+                verifiers,
+                data,
+                signatures
+            );
+        };
+        (void)Benchmark::Measure(verifyWithEachInParallel, iterations / 10);
+        Benchmark::Report(
+            prefix + " hash once, parallel",
+            Benchmark::Measure(verifyWithEachInParallel, iterations)
+        );
+    }
+
+    /**
+     * This function compares the latency of verifying a signature of a
+     * short data chunk through the generic libcrypto interface, the way
+     * Verify did before it had its own RSA public-key operation, with
+     * that of Verify.
+     *
+     * @param[in] bits
+     *     This is the size of the RSA key to use, in bits.
+     *
+     * @param[in] iterations
+     *     This is the number of signatures to verify in each mode.
+     */
+    void SmallMessage(
+        int bits,
+        size_t iterations
+    ) {
+        const auto keyPem = Benchmark::GenerateRsaKey(bits);
+        const std::vector< uint8_t > data(256, 0x5a);
+        CryptoSigning::Sign sign;
+        (void)sign.Configure(keyPem);
+        const auto signature = sign(data);
+        const auto bio = BIO_new_mem_buf(keyPem.data(), (int)keyPem.size());
+        const auto key = PEM_read_bio_PrivateKey(bio, NULL, NULL, NULL);
+        BIO_free(bio);
+        const auto prefix = "RSA-" + std::to_string(bits);
+        const auto verifyGeneric = [&]{
+            const auto ctx = EVP_MD_CTX_new();
+            (void)EVP_DigestVerifyInit(ctx, NULL, EVP_sha256(), NULL, key);
+            (void)EVP_DigestVerifyUpdate(ctx, data.data(), data.size());
+            (void)EVP_DigestVerifyFinal(ctx, signature.data(), signature.size());
+            EVP_MD_CTX_free(ctx);
+        };
+        (void)Benchmark::Measure(verifyGeneric, iterations / 10);
+        Benchmark::Report(
+            prefix + " generic libcrypto",
+            Benchmark::Measure(verifyGeneric, iterations)
+        );
+        CryptoSigning::Verify verify;
+        (void)verify.Configure(keyPem);
+        const auto verifyOnce = [&]{ (void)verify(data, signature); };
+        (void)Benchmark::Measure(verifyOnce, iterations / 10);
+        Benchmark::Report(
+            prefix + " Verify",
+            Benchmark::Measure(verifyOnce, iterations)
+        );
+        EVP_PKEY_free(key);
+    }
+
+    const Benchmark::Registration batch2048(
+        "Verify/Batch/2048",
+        []{ Batch(2048, 64, 500); }
+    );
+
+    const Benchmark::Registration batch4096(
+        "Verify/Batch/4096",
+        []{ Batch(4096, 64, 200); }
+    );
+
+    const Benchmark::Registration fanOut(
+        "Verify/FanOut/2048",
+        []{ FanOut(5, 1024 * 1024, 500); }
+    );
+
+    const Benchmark::Registration jwsCompact2048(
+        "Verify/JwsCompact/2048",
+        []{ JwsCompact(2048, 20000); }
+    );
+
+    const Benchmark::Registration jwsCompact4096(
+        "Verify/JwsCompact/4096",
+        []{ JwsCompact(4096, 10000); }
+    );
+
+    const Benchmark::Registration rotation2048(
+        "Verify/Rotation/2048",
+        []{ Rotation(2048, 20000); }
+    );
+
+    const Benchmark::Registration smallMessage2048(
+        "Verify/SmallMessage/2048",
+        []{ SmallMessage(2048, 20000); }
+    );
+
+    const Benchmark::Registration smallMessage4096(
+        "Verify/SmallMessage/4096",
+        []{ SmallMessage(4096, 10000); }
+    );
+
+}
@@ -0,0 +1,29 @@
+/**
+ * @file main.cpp
+ *
+ * This module holds the main() function, which is the entrypoint
+ * to the benchmark program for the CryptoSigning library.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Benchmark.hpp"
+
+#include <stdlib.h>
+#include <string>
+
+/**
+ * This function is the entrypoint of the program.
+ *
+ * @param[in] argc
+ *     This is the number of command-line arguments given to the program.
+ *
+ * @param[in] argv
+ *     This is the array of command-line arguments given to the program.
+ *     If given, the first argument selects which benchmarks to run,
+ *     by matching part of their names.
+ */
+int main(int argc, char* argv[]) {
+    Benchmark::RunAll((argc > 1) ? argv[1] : "");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file main.cpp
+ *
+ * This module holds the main() function, which is the entrypoint
+ * to the signing daemon, a program which holds private keys and signs
+ * data for other processes through a UNIX domain socket.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <atomic>
+#include <CryptoSigning/BulkLoad.hpp>
+#include <CryptoSigning/SignServer.hpp>
+#include <errno.h>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+    /**
+     * This contains variables set through the operating system environment
+     * or the command-line arguments.
+     */
+    struct Environment {
+        /**
+         * This is the path of the socket on which to accept clients.
+         */
+        std::string socketPath;
+
+        /**
+         * These are the names of the keys to load.
+         */
+        std::vector< std::string > keyNames;
+
+        /**
+         * These are the paths of the PEM files of the keys to load.
+         */
+        std::vector< std::string > keyPaths;
+
+        /**
+         * This is the number of worker threads to use, or zero to use
+         * the number of hardware threads available.
+         */
+        size_t workers = 0;
+    };
+
+    /**
+     * This function prints to the standard error stream information
+     * about how to use this program.
+     */
+    void PrintUsageInformation() {
+        fprintf(
+            stderr,
+            (
+                "Usage: CryptoSigningDaemon [--workers N] SOCKET NAME=KEYFILE...\n"
+                "\n"
+                "Hold private keys and sign data for other processes.\n"
+                "\n"
+                "  SOCKET     Path of the UNIX domain socket on which\n"
+                "             to accept clients.\n"
+                "  NAME       Name clients use to select a key.\n"
+                "  KEYFILE    Path of a private key file, in PEM format.\n"
+                "  N          Number of worker threads to use to sign data.\n"
+                "\n"
+                "If the keys are encrypted, the passphrase is taken from the\n"
+                "CRYPTO_SIGNING_PASSPHRASE environment variable.\n"
+            )
+        );
+    }
+
+    /**
+     * This function updates the program environment to incorporate
+     * any applicable command-line arguments.
+     *
+     * @param[in] argc
+     *     This is the number of command-line arguments given to the program.
+     *
+     * @param[in] argv
+     *     This is the array of command-line arguments given to the program.
+     *
+     * @param[in,out] environment
+     *     This is the environment to update.
+     *
+     * @return
+     *     An indication of whether or not the command-line arguments were
+     *     parsed successfully is returned.
+     */
+    bool ProcessCommandLineArguments(
+        int argc,
+        char* argv[],
+        Environment& environment
+    ) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg(argv[i]);
+            if (arg == "--workers") {
+                if (++i >= argc) {
+                    return false;
+                }
+                char* end;
+                errno = 0;
+                environment.workers = (size_t)strtoul(argv[i], &end, 10);
+                if (
+                    (argv[i][0] < '0')
+                    || (argv[i][0] > '9')
+                    || (*end != '\0')
+                    || (errno == ERANGE)
+                    || (environment.workers == 0)
+                ) {
+                    return false;
+                }
+            } else if (environment.socketPath.empty()) {
+                environment.socketPath = arg;
+            } else {
+                const auto delimiter = arg.find('=');
+                if (
+                    (delimiter == std::string::npos)
+                    || (delimiter == 0)
+                    || (delimiter > 255)
+                ) {
+                    return false;
+                }
+                environment.keyNames.push_back(arg.substr(0, delimiter));
+                environment.keyPaths.push_back(arg.substr(delimiter + 1));
+            }
+        }
+        return (
+            !environment.socketPath.empty()
+            && !environment.keyNames.empty()
+        );
+    }
+
+}
+
+/**
+ * This function is the entrypoint of the program.
+ *
+ * @param[in] argc
+ *     This is the number of command-line arguments given to the program.
+ *
+ * @param[in] argv
+ *     This is the array of command-line arguments given to the program.
+ */
+int main(int argc, char* argv[]) {
+    Environment environment;
+    if (!ProcessCommandLineArguments(argc, argv, environment)) {
+        PrintUsageInformation();
+        return EXIT_FAILURE;
+    }
+    const auto passphraseVariable = getenv("CRYPTO_SIGNING_PASSPHRASE");
+    const std::string passphrase(
+        (passphraseVariable == NULL) ? "" : passphraseVariable
+    );
+    std::vector< CryptoSigning::SignKeySource > keys;
+    for (const auto& keyPath: environment.keyPaths) {
+        std::ifstream file(keyPath, std::ios::binary);
+        if (!file) {
+            fprintf(stderr, "error: unable to open '%s'\n", keyPath.c_str());
+            return EXIT_FAILURE;
+        }
+        keys.push_back({
+            std::string(
+                std::istreambuf_iterator< char >(file),
+                std::istreambuf_iterator< char >()
+            ),
+            passphrase
+        });
+    }
+    auto loaded = CryptoSigning::LoadSignKeys(keys, environment.workers);
+    CryptoSigning::SignServer server;
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        if (!loaded[i].success) {
+            fprintf(
+                stderr,
+                "error: unable to load '%s': %s\n",
+                environment.keyPaths[i].c_str(),
+                loaded[i].error.c_str()
+            );
+            return EXIT_FAILURE;
+        }
+        (void)server.AddKey(
+            environment.keyNames[i],
+            std::make_shared< CryptoSigning::Sign >(std::move(loaded[i].sign))
+        );
+    }
+    std::atomic< bool > failed(false);
+    (void)server.SetErrorDelegate(
+        [&failed](const std::string& message){
+            fprintf(stderr, "error: %s\n", message.c_str());
+            failed = true;
+            (void)kill(getpid(), SIGTERM);
+        }
+    );
+    sigset_t signals;
+    (void)sigemptyset(&signals);
+    (void)sigaddset(&signals, SIGINT);
+    (void)sigaddset(&signals, SIGTERM);
+    (void)sigaddset(&signals, SIGPIPE);
+    (void)pthread_sigmask(SIG_BLOCK, &signals, NULL);
+    if (!server.Start(environment.socketPath, environment.workers)) {
+        fprintf(
+            stderr,
+            "error: unable to listen on '%s'\n",
+            environment.socketPath.c_str()
+        );
+        return EXIT_FAILURE;
+    }
+    (void)sigdelset(&signals, SIGPIPE);
+    int signal;
+    (void)sigwait(&signals, &signal);
+    server.Stop();
+    return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
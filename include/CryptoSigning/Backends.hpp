@@ -0,0 +1,34 @@
+#ifndef CRYPTO_SIGNING_BACKENDS_HPP
+#define CRYPTO_SIGNING_BACKENDS_HPP
+
+/**
+ * @file Backends.hpp
+ *
+ * This module declares the CryptoSigning::GetBackendNames function.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <string>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This function returns the names of the cryptographic backends built
+     * into the library, in the order in which they are preferred.
+     *
+     * Every kind of key is supported by the libcrypto backend, named
+     * "OpenSSL" or "LibreSSL" after the library it was built with.  If the
+     * library was built with the CRYPTO_SIGNING_WITH_SODIUM option, the
+     * "libsodium" backend is also present, and handles Ed25519 keys.
+     *
+     * @return
+     *     The names of the cryptographic backends built into the library
+     *     are returned.
+     */
+    std::vector< std::string > GetBackendNames();
+
+}
+
+#endif /* CRYPTO_SIGNING_BACKENDS_HPP */
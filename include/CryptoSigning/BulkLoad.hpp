@@ -0,0 +1,120 @@
+#ifndef CRYPTO_SIGNING_BULK_LOAD_HPP
+#define CRYPTO_SIGNING_BULK_LOAD_HPP
+
+/**
+ * @file BulkLoad.hpp
+ *
+ * This module declares the CryptoSigning::LoadSignKeys and
+ * CryptoSigning::LoadVerifyKeys functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+#include "Verify.hpp"
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This holds one private key to be loaded by LoadSignKeys.
+     */
+    struct SignKeySource {
+        /**
+         * This is the private key, in PEM format.
+         */
+        std::string keyPem;
+
+        /**
+         * This is the passphrase to use to decrypt the private key.
+         */
+        std::string passphrase;
+    };
+
+    /**
+     * This holds the outcome of loading one private key with LoadSignKeys.
+     */
+    struct SignLoadResult {
+        /**
+         * This is the instance configured with the key, if it loaded.
+         */
+        Sign sign;
+
+        /**
+         * This indicates whether or not the key was successfully loaded.
+         */
+        bool success = false;
+
+        /**
+         * If the key could not be loaded, this describes why.
+         */
+        std::string error;
+    };
+
+    /**
+     * This holds the outcome of loading one key with LoadVerifyKeys.
+     */
+    struct VerifyLoadResult {
+        /**
+         * This is the instance configured with the key, if it loaded.
+         */
+        Verify verify;
+
+        /**
+         * This indicates whether or not the key was successfully loaded.
+         */
+        bool success = false;
+
+        /**
+         * If the key could not be loaded, this describes why.
+         */
+        std::string error;
+    };
+
+    /**
+     * This function parses the given private keys concurrently, using a pool
+     * of worker threads, and returns a Sign instance configured for each one.
+     *
+     * @param[in] keys
+     *     These are the private keys to load.
+     *
+     * @param[in] workers
+     *     This is the maximum number of worker threads to use.  If zero,
+     *     the number of hardware threads available is used.
+     *
+     * @return
+     *     The results of loading the keys are returned, in the same
+     *     order as the given keys.
+     */
+    std::vector< SignLoadResult > LoadSignKeys(
+        const std::vector< SignKeySource >& keys,
+        size_t workers = 0
+    );
+
+    /**
+     * This function parses the given public or private keys concurrently,
+     * using a pool of worker threads, and returns a Verify instance
+     * configured for each one.
+     *
+     * @param[in] keyPems
+     *     These are the public or private keys, in PEM format, to load.
+     *
+     * @param[in] workers
+     *     This is the maximum number of worker threads to use.  If zero,
+     *     the number of hardware threads available is used.
+     *
+     * @return
+     *     The results of loading the keys are returned, in the same
+     *     order as the given keys.
+     */
+    std::vector< VerifyLoadResult > LoadVerifyKeys(
+        const std::vector< std::string >& keyPems,
+        size_t workers = 0
+    );
+
+}
+
+#endif /* CRYPTO_SIGNING_BULK_LOAD_HPP */
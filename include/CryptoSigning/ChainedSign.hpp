@@ -0,0 +1,166 @@
+#ifndef CRYPTO_SIGNING_CHAINED_SIGN_HPP
+#define CRYPTO_SIGNING_CHAINED_SIGN_HPP
+
+/**
+ * @file ChainedSign.hpp
+ *
+ * This module declares the CryptoSigning::ChainedSign class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+
+#include <chrono>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class is used to sign a stream of data segments, such that
+     * a receiver can verify the stream progressively, before it ends.
+     *
+     * Each segment is folded into a running SHA-256 hash chain, and a
+     * signature over the chain is issued every so many segments, or
+     * every so often, whichever comes first.  A signature covers every
+     * segment that came before it, so only one private-key operation is
+     * needed per group of segments.
+     *
+     * There is no timer: the time since the last signature is only
+     * checked when a segment is appended.  A sender whose segments may
+     * stop arriving for a while should call Flush itself, so that a
+     * receiver isn't left waiting for a signature.
+     */
+    class ChainedSign {
+        // Types
+    public:
+        /**
+         * These are the possible outcomes of appending a segment
+         * or flushing the stream.
+         */
+        enum class Status {
+            /**
+             * No signature is due yet.
+             */
+            NotDue,
+
+            /**
+             * A signature covering all segments so far was issued.
+             */
+            Signed,
+
+            /**
+             * A signature was due, but could not be made.  The segments
+             * remain pending, so another attempt is made with the next
+             * segment or flush.
+             */
+            Failed,
+        };
+
+        // Lifecycle management
+    public:
+        ~ChainedSign() noexcept;
+        ChainedSign(const ChainedSign&) = delete;
+        ChainedSign(ChainedSign&&) noexcept;
+        ChainedSign& operator=(const ChainedSign&) = delete;
+        ChainedSign& operator=(ChainedSign&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        ChainedSign();
+
+        /**
+         * This method sets up the instance to sign a new stream.
+         *
+         * @param[in] sign
+         *     This is the configured instance to use to make signatures.
+         *
+         * @param[in] segmentsPerSignature
+         *     This is the maximum number of segments to accept before
+         *     issuing a signature.  If zero, signatures are not issued
+         *     based on the number of segments.
+         *
+         * @param[in] signatureInterval
+         *     This is the maximum time to let pass, since the last
+         *     signature was issued, before issuing a signature with the
+         *     next segment.  If zero, signatures are not issued based
+         *     on time.  Time is only checked when a segment is appended,
+         *     so Flush must be called if segments may stop arriving.
+         */
+        void Configure(
+            std::shared_ptr< Sign > sign,
+            size_t segmentsPerSignature,
+            std::chrono::milliseconds signatureInterval
+        );
+
+        /**
+         * This method appends the given segment to the stream.
+         *
+         * @param[in] segment
+         *     This is the next segment of the stream.
+         *
+         * @param[out] signature
+         *     This is where to store the raw binary cryptographic signature
+         *     covering all segments so far, if one is issued.  It should be
+         *     sent to the receiver after the segment.  It's left empty
+         *     otherwise.
+         *
+         * @return
+         *     An indication of whether a signature was issued, wasn't
+         *     due, or was due but could not be made is returned.
+         */
+        Status operator()(
+            const std::vector< uint8_t >& segment,
+            std::vector< uint8_t >& signature
+        );
+
+        /**
+         * This method issues a signature covering all segments so far,
+         * if any segments were appended since the last signature.  It
+         * should be called at the end of the stream, and may also be called
+         * at any time to limit how long a receiver has to wait.
+         *
+         * @param[out] signature
+         *     This is where to store the raw binary cryptographic signature
+         *     covering all segments so far, if one is issued.  It's left
+         *     empty otherwise.
+         *
+         * @return
+         *     An indication of whether a signature was issued, wasn't
+         *     due because no segments were appended since the last
+         *     signature, or could not be made is returned.
+         */
+        Status Flush(std::vector< uint8_t >& signature);
+
+        /**
+         * This method returns the number of segments appended to the stream.
+         *
+         * @return
+         *     The number of segments appended to the stream is returned.
+         */
+        uint64_t GetSegments() const;
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_CHAINED_SIGN_HPP */
@@ -0,0 +1,135 @@
+#ifndef CRYPTO_SIGNING_CHAINED_VERIFY_HPP
+#define CRYPTO_SIGNING_CHAINED_VERIFY_HPP
+
+/**
+ * @file ChainedVerify.hpp
+ *
+ * This module declares the CryptoSigning::ChainedVerify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Verify.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class is used to verify, progressively, a stream of data
+     * segments signed by a ChainedSign instance.
+     *
+     * Only the running hash chain is kept, so memory use does not depend
+     * on the length of the stream.
+     */
+    class ChainedVerify {
+        // Types
+    public:
+        /**
+         * These are the possible states of the stream being verified.
+         */
+        enum class Status {
+            /**
+             * Some segments have not yet been covered by a signature.
+             */
+            Pending,
+
+            /**
+             * All segments so far have been covered by a valid signature.
+             */
+            Verified,
+
+            /**
+             * The stream failed verification, either because a signature
+             * did not match, or because too many segments arrived without
+             * a signature.  No further segments will be accepted.
+             */
+            Failed,
+        };
+
+        // Lifecycle management
+    public:
+        ~ChainedVerify() noexcept;
+        ChainedVerify(const ChainedVerify&) = delete;
+        ChainedVerify(ChainedVerify&&) noexcept;
+        ChainedVerify& operator=(const ChainedVerify&) = delete;
+        ChainedVerify& operator=(ChainedVerify&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        ChainedVerify();
+
+        /**
+         * This method sets up the instance to verify a new stream.
+         *
+         * @param[in] verify
+         *     This is the configured instance to use to verify signatures.
+         *
+         * @param[in] maxPendingSegments
+         *     This is the maximum number of segments to accept without
+         *     a signature before failing the stream.  If zero, there
+         *     is no limit.
+         */
+        void Configure(
+            std::shared_ptr< Verify > verify,
+            size_t maxPendingSegments = 0
+        );
+
+        /**
+         * This method appends the given segment to the stream.
+         *
+         * @param[in] segment
+         *     This is the next segment of the stream.
+         *
+         * @return
+         *     The state of the stream is returned.
+         */
+        Status operator()(const std::vector< uint8_t >& segment);
+
+        /**
+         * This method checks the given signature against all segments
+         * appended so far.
+         *
+         * @param[in] signature
+         *     This is the raw binary cryptographic signature issued
+         *     by the sender after the latest segment.
+         *
+         * @return
+         *     The state of the stream is returned.
+         */
+        Status Checkpoint(const std::vector< uint8_t >& signature);
+
+        /**
+         * This method returns the number of segments covered by a valid
+         * signature so far.
+         *
+         * @return
+         *     The number of segments covered by a valid signature so far
+         *     is returned.
+         */
+        uint64_t GetVerifiedSegments() const;
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_CHAINED_VERIFY_HPP */
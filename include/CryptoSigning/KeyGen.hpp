@@ -0,0 +1,110 @@
+#ifndef CRYPTO_SIGNING_KEY_GEN_HPP
+#define CRYPTO_SIGNING_KEY_GEN_HPP
+
+/**
+ * @file KeyGen.hpp
+ *
+ * This module declares the CryptoSigning::GenerateKey function.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+#include "Verify.hpp"
+
+#include <string>
+
+namespace CryptoSigning {
+
+    /**
+     * These are the kinds of keys which can be generated.
+     */
+    enum class KeyType {
+        /**
+         * This is an RSA key.
+         */
+        Rsa,
+
+        /**
+         * This is an elliptic curve key on the NIST P-256 curve.
+         */
+        EcP256,
+
+        /**
+         * This is an Ed25519 key.  It requires OpenSSL 1.1.1 or later,
+         * or LibreSSL 3.7 or later.
+         */
+        Ed25519,
+    };
+
+    /**
+     * This describes a key to be generated.
+     */
+    struct KeySpec {
+        /**
+         * This is the kind of key to generate.
+         */
+        KeyType type = KeyType::Rsa;
+
+        /**
+         * This is the size of the modulus, in bits, of an RSA key.
+         * It is ignored for other kinds of keys.
+         */
+        int bits = 2048;
+
+        /**
+         * This is the number of prime factors of the modulus of an
+         * RSA key.  Keys with more prime factors make signatures faster,
+         * and are used in the same way by verifiers.  libcrypto allows
+         * up to 3 prime factors for moduli under 4096 bits, 4 under 8192
+         * bits, and 5 otherwise.  It is ignored for other kinds of keys.
+         */
+        int primes = 2;
+    };
+
+    /**
+     * This holds a newly generated key, along with instances
+     * ready to use it.
+     */
+    struct GeneratedKey {
+        /**
+         * This is the private key, in PEM format.
+         */
+        std::string privateKeyPem;
+
+        /**
+         * This is the public key, in PEM format.
+         */
+        std::string publicKeyPem;
+
+        /**
+         * This is an instance configured to sign with the private key.
+         */
+        Sign sign;
+
+        /**
+         * This is an instance configured to verify signatures
+         * made with the private key.
+         */
+        Verify verify;
+
+        /**
+         * This indicates whether or not the key was successfully generated.
+         */
+        bool success = false;
+    };
+
+    /**
+     * This function generates a new key pair.
+     *
+     * @param[in] spec
+     *     This describes the key to generate.
+     *
+     * @return
+     *     The generated key is returned.
+     */
+    GeneratedKey GenerateKey(const KeySpec& spec);
+
+}
+
+#endif /* CRYPTO_SIGNING_KEY_GEN_HPP */
@@ -0,0 +1,109 @@
+#ifndef CRYPTO_SIGNING_KEY_POOL_HPP
+#define CRYPTO_SIGNING_KEY_POOL_HPP
+
+/**
+ * @file KeyPool.hpp
+ *
+ * This module declares the CryptoSigning::KeyPool class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "KeyGen.hpp"
+
+#include <memory>
+#include <stddef.h>
+
+namespace CryptoSigning {
+
+    /**
+     * This class hands out freshly generated keys, keeping a pool of them
+     * generated ahead of time by background threads so that taking a key
+     * doesn't have to wait for one to be generated.
+     */
+    class KeyPool {
+        // Lifecycle management
+    public:
+        ~KeyPool() noexcept;
+        KeyPool(const KeyPool&) = delete;
+        KeyPool(KeyPool&&) noexcept;
+        KeyPool& operator=(const KeyPool&) = delete;
+        KeyPool& operator=(KeyPool&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        KeyPool();
+
+        /**
+         * This method sets up the pool to hold keys of the given kind,
+         * discarding any keys already in the pool, and starts the
+         * background threads which keep the pool filled.  One key is
+         * generated right away, to check that keys of the given kind
+         * can be generated at all, and is put in the pool, even if the
+         * pool size is zero, so that the next key taken doesn't wait.
+         *
+         * @param[in] spec
+         *     This describes the keys to generate.
+         *
+         * @param[in] poolSize
+         *     This is the number of keys to keep generated ahead of time.
+         *     If zero, no keys are generated in the background, and
+         *     once the key generated by this method is taken, every
+         *     key is generated when it is taken.
+         *
+         * @param[in] workers
+         *     This is the number of background threads to use to
+         *     generate keys.  It must not be zero unless the pool
+         *     size is also zero.
+         *
+         * @return
+         *     An indication of whether or not keys of the given kind
+         *     could be generated, and the number of workers is valid,
+         *     is returned.  If not, the pool is left empty, and no
+         *     background threads are started.
+         */
+        bool Configure(
+            const KeySpec& spec,
+            size_t poolSize,
+            size_t workers = 1
+        );
+
+        /**
+         * This method takes a key from the pool.  If the pool is empty,
+         * a key is generated on the calling thread instead.
+         *
+         * @return
+         *     The key is returned.
+         */
+        GeneratedKey Take();
+
+        /**
+         * This method returns the number of keys currently generated
+         * and waiting in the pool.
+         *
+         * @return
+         *     The number of keys waiting in the pool is returned.
+         */
+        size_t GetPoolLevel();
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_KEY_POOL_HPP */
@@ -0,0 +1,158 @@
+#ifndef CRYPTO_SIGNING_LOG_SIGN_HPP
+#define CRYPTO_SIGNING_LOG_SIGN_HPP
+
+/**
+ * @file LogSign.hpp
+ *
+ * This module declares the CryptoSigning::LogSign class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This holds a signed checkpoint of an append-only log, committing
+     * to every entry of the log up to a point.
+     */
+    struct LogCheckpoint {
+        /**
+         * This is the number of log entries covered by the checkpoint.
+         */
+        uint64_t entries = 0;
+
+        /**
+         * This is the link of the SHA-256 hash chain over the log entries
+         * after the last entry covered by the checkpoint.
+         */
+        std::vector< uint8_t > digest;
+
+        /**
+         * This is the raw binary cryptographic signature of a context
+         * label, which sets log checkpoints apart from other signed
+         * messages, followed by the number of entries and the digest.
+         */
+        std::vector< uint8_t > signature;
+
+        /**
+         * This method encodes the checkpoint for storage or transmission.
+         * The encoding is the message which was signed, made up of the
+         * context label "CryptoSigning log checkpoint v1" with its
+         * terminating zero byte, the number of entries, as a 64-bit
+         * big-endian integer, and the digest, followed by the signature.
+         *
+         * @return
+         *     The encoded checkpoint is returned.
+         */
+        std::vector< uint8_t > Serialize() const;
+
+        /**
+         * This method decodes a checkpoint encoded by Serialize.
+         *
+         * @param[in] encoding
+         *     This is the encoded checkpoint.
+         *
+         * @return
+         *     An indication of whether or not the encoding was well formed
+         *     is returned.  If not, the checkpoint is left unchanged.
+         */
+        bool Parse(const std::vector< uint8_t >& encoding);
+    };
+
+    /**
+     * This class is used to sign an append-only log, such as an audit log,
+     * so that it can be verified incrementally.  Each entry is folded into
+     * a running SHA-256 hash chain, and a checkpoint signs the state of the
+     * chain.  A verifier which has checked one checkpoint only needs the
+     * entries appended after it, and the signature of a newer checkpoint,
+     * to extend its trust to the whole log; see the LogVerify class.
+     */
+    class LogSign {
+        // Lifecycle management
+    public:
+        ~LogSign() noexcept;
+        LogSign(const LogSign&) = delete;
+        LogSign(LogSign&&) noexcept;
+        LogSign& operator=(const LogSign&) = delete;
+        LogSign& operator=(LogSign&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        LogSign();
+
+        /**
+         * This method sets up the instance to sign a new, empty log.
+         *
+         * @param[in] sign
+         *     This is the configured instance to use to sign checkpoints.
+         */
+        void Configure(std::shared_ptr< Sign > sign);
+
+        /**
+         * This method continues the log from the given checkpoint, such
+         * as one made before the program was restarted, without appending
+         * the entries it covers again.
+         *
+         * @param[in] checkpoint
+         *     This is the checkpoint from which to continue the log.
+         *
+         * @return
+         *     An indication of whether or not the checkpoint holds a digest
+         *     of the right size is returned.  If not, the log is left
+         *     unchanged.
+         */
+        bool Resume(const LogCheckpoint& checkpoint);
+
+        /**
+         * This method appends the given entry to the log.
+         *
+         * @param[in] entry
+         *     This is the entry to append.
+         */
+        void Append(const std::vector< uint8_t >& entry);
+
+        /**
+         * This method makes a checkpoint covering every entry appended
+         * to the log so far.
+         *
+         * @return
+         *     The checkpoint is returned.  Its signature is empty if
+         *     signing failed.
+         */
+        LogCheckpoint Checkpoint() const;
+
+        /**
+         * This method returns the number of entries in the log.
+         *
+         * @return
+         *     The number of entries in the log is returned.
+         */
+        uint64_t GetEntries() const;
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_LOG_SIGN_HPP */
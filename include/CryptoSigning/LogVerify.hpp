@@ -0,0 +1,130 @@
+#ifndef CRYPTO_SIGNING_LOG_VERIFY_HPP
+#define CRYPTO_SIGNING_LOG_VERIFY_HPP
+
+/**
+ * @file LogVerify.hpp
+ *
+ * This module declares the CryptoSigning::LogVerify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "LogSign.hpp"
+#include "Verify.hpp"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class is used to verify, incrementally, an append-only log
+     * signed by a LogSign instance.
+     *
+     * The last checkpoint verified is recorded, and each later
+     * verification starts from it, so the cost of verifying depends only
+     * on how many entries were appended since, plus one signature.  Since
+     * the new entries are chained onto the recorded digest, a log whose
+     * earlier entries were changed or removed fails verification.
+     */
+    class LogVerify {
+        // Lifecycle management
+    public:
+        ~LogVerify() noexcept;
+        LogVerify(const LogVerify&) = delete;
+        LogVerify(LogVerify&&) noexcept;
+        LogVerify& operator=(const LogVerify&) = delete;
+        LogVerify& operator=(LogVerify&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        LogVerify();
+
+        /**
+         * This method sets up the instance to verify a log from
+         * its beginning.
+         *
+         * @param[in] verify
+         *     This is the configured instance to use to verify
+         *     checkpoint signatures.
+         */
+        void Configure(std::shared_ptr< Verify > verify);
+
+        /**
+         * This method continues verification from the given checkpoint,
+         * such as one recorded with GetLastVerifiedCheckpoint before the
+         * program was restarted.  Only the checkpoint's signature is
+         * checked, not the entries it covers.
+         *
+         * @param[in] checkpoint
+         *     This is the checkpoint from which to continue.
+         *
+         * @return
+         *     An indication of whether or not the checkpoint's signature
+         *     is valid is returned.  If not, the recorded checkpoint is
+         *     left unchanged.
+         */
+        bool Resume(const LogCheckpoint& checkpoint);
+
+        /**
+         * This method verifies the given entries, appended to the log after
+         * the last verified checkpoint, against the given newer checkpoint.
+         *
+         * @param[in] newEntries
+         *     These are the entries appended to the log after the last
+         *     verified checkpoint, up to the given checkpoint, in order.
+         *
+         * @param[in] checkpoint
+         *     This is the checkpoint covering the new entries.
+         *
+         * @return
+         *     An indication of whether or not the new entries and the
+         *     checkpoint are valid is returned.  If so, the checkpoint
+         *     becomes the last verified checkpoint.  If not, the last
+         *     verified checkpoint is left unchanged.
+         */
+        bool operator()(
+            const std::vector< std::vector< uint8_t > >& newEntries,
+            const LogCheckpoint& checkpoint
+        );
+
+        /**
+         * This method returns the last checkpoint verified.
+         *
+         * @return
+         *     The last checkpoint verified is returned.  If none has been
+         *     verified, it covers no entries and has no signature.
+         */
+        LogCheckpoint GetLastVerifiedCheckpoint() const;
+
+        /**
+         * This method returns the number of log entries covered by the
+         * last checkpoint verified.
+         *
+         * @return
+         *     The number of log entries verified is returned.
+         */
+        uint64_t GetVerifiedEntries() const;
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_LOG_VERIFY_HPP */
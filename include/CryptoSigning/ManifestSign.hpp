@@ -0,0 +1,165 @@
+#ifndef CRYPTO_SIGNING_MANIFEST_SIGN_HPP
+#define CRYPTO_SIGNING_MANIFEST_SIGN_HPP
+
+/**
+ * @file ManifestSign.hpp
+ *
+ * This module declares the CryptoSigning::ManifestSign class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This holds the proof that one item is included in a signed manifest.
+     */
+    struct ManifestProof {
+        /**
+         * This is the position of the item in the manifest.
+         */
+        uint64_t index = 0;
+
+        /**
+         * This is the number of items in the manifest.
+         */
+        uint64_t size = 0;
+
+        /**
+         * These are the hashes of the sibling subtrees needed to
+         * recompute the root of the manifest from the item.
+         */
+        std::vector< std::vector< uint8_t > > path;
+
+        /**
+         * This is the raw binary cryptographic signature of the
+         * root of the manifest.  It is empty if the manifest
+         * could not be signed.
+         */
+        std::vector< uint8_t > signature;
+    };
+
+    /**
+     * This class is used to sign many items with a single private-key
+     * operation.  Items are collected into a manifest, a Merkle tree is
+     * built over their hashes, and only the root of the tree is signed.
+     * Each item is given a proof of its inclusion in the signed manifest,
+     * which is checked using the ManifestVerify class.
+     *
+     * Items may be added from multiple threads at once.  Each thread
+     * receives the proofs of its own items through the futures returned
+     * by the Add method, whichever thread signs the manifest.
+     */
+    class ManifestSign {
+        // Lifecycle management
+    public:
+        ~ManifestSign() noexcept;
+        ManifestSign(const ManifestSign&) = delete;
+        ManifestSign(ManifestSign&&) noexcept;
+        ManifestSign& operator=(const ManifestSign&) = delete;
+        ManifestSign& operator=(ManifestSign&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        ManifestSign();
+
+        /**
+         * This method sets up the instance to sign manifests.  Any items
+         * added before are signed first, as if Flush were called.
+         *
+         * @param[in] sign
+         *     This is the configured instance to use to sign the root
+         *     of each manifest.
+         *
+         * @param[in] maxItems
+         *     This is the maximum number of items to collect before
+         *     signing the manifest.  If zero, manifests are not signed
+         *     based on the number of items.
+         *
+         * @param[in] maxDelay
+         *     This is the maximum time to let pass, after the first item
+         *     of a manifest is added, before a background thread signs
+         *     the manifest.  If zero, manifests are not signed based on
+         *     time.
+         */
+        void Configure(
+            std::shared_ptr< Sign > sign,
+            size_t maxItems = 0,
+            std::chrono::milliseconds maxDelay = std::chrono::milliseconds(0)
+        );
+
+        /**
+         * This method adds the given item to the manifest being collected.
+         * If this brings the manifest to the maximum number of items, the
+         * manifest is signed before the method returns.
+         *
+         * @param[in] item
+         *     This is the item to add to the manifest.
+         *
+         * @return
+         *     A future which will hold the inclusion proof of the item,
+         *     once the manifest holding it is signed, is returned.  The
+         *     signature in the proof is empty if the manifest could not
+         *     be signed.
+         */
+        std::future< ManifestProof > Add(const std::vector< uint8_t >& item);
+
+        /**
+         * This method signs the manifest of all items added since the last
+         * call, and starts a new manifest.  The futures returned for the
+         * items by the Add method are given their proofs.
+         *
+         * @return
+         *     The inclusion proofs of the items in the manifest are
+         *     returned, in the order the items were added.  If there were
+         *     no items, or the manifest could not be signed, an empty
+         *     vector is returned.
+         */
+        std::vector< ManifestProof > Flush();
+
+        /**
+         * This method signs a manifest of the given items.  It doesn't
+         * affect the manifest being collected through the Add method.
+         *
+         * @param[in] items
+         *     These are the items to sign.
+         *
+         * @return
+         *     The inclusion proofs of the items are returned, in the
+         *     same order as the items.  If there were no items, or the
+         *     manifest could not be signed, an empty vector is returned.
+         */
+        std::vector< ManifestProof > operator()(
+            const std::vector< std::vector< uint8_t > >& items
+        );
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_MANIFEST_SIGN_HPP */
@@ -0,0 +1,91 @@
+#ifndef CRYPTO_SIGNING_MANIFEST_VERIFY_HPP
+#define CRYPTO_SIGNING_MANIFEST_VERIFY_HPP
+
+/**
+ * @file ManifestVerify.hpp
+ *
+ * This module declares the CryptoSigning::ManifestVerify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "ManifestSign.hpp"
+#include "Verify.hpp"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class is used to verify that an item is included in a manifest
+     * signed by a ManifestSign instance.
+     *
+     * The signature of the most recently verified manifest is remembered,
+     * so that checking further items from the same manifest costs only
+     * a few hashes.
+     */
+    class ManifestVerify {
+        // Lifecycle management
+    public:
+        ~ManifestVerify() noexcept;
+        ManifestVerify(const ManifestVerify&) = delete;
+        ManifestVerify(ManifestVerify&&) noexcept;
+        ManifestVerify& operator=(const ManifestVerify&) = delete;
+        ManifestVerify& operator=(ManifestVerify&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        ManifestVerify();
+
+        /**
+         * This method sets up the instance to verify manifests.
+         *
+         * @param[in] verify
+         *     This is the configured instance to use to verify the
+         *     signature of each manifest.
+         */
+        void Configure(std::shared_ptr< Verify > verify);
+
+        /**
+         * This method verifies that the given item is included in a
+         * signed manifest.
+         *
+         * @param[in] item
+         *     This is the item to verify.
+         *
+         * @param[in] proof
+         *     This is the proof of the item's inclusion in the manifest.
+         *
+         * @return
+         *     An indication of whether or not the proof shows the item
+         *     to be included in a manifest whose signature matches the
+         *     configured key is returned.
+         */
+        bool operator()(
+            const std::vector< uint8_t >& item,
+            const ManifestProof& proof
+        );
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_MANIFEST_VERIFY_HPP */
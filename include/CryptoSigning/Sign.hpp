@@ -10,6 +10,7 @@
  */
 
 #include <memory>
+#include <stddef.h>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -19,6 +20,11 @@ namespace CryptoSigning {
     /**
      * This class is used to generate a cryptographic signature for a chunk of
      * data, using a private key in PEM format.
+     *
+     * The instance may be configured with a new key while other threads
+     * are using it to make signatures.  Signatures already under way
+     * are finished with the key they started with.  Its settings may also
+     * be changed while other threads are using or configuring it.
      */
     class Sign {
         // Lifecycle management
@@ -56,6 +62,46 @@ namespace CryptoSigning {
             const std::string& passphrase = ""
         );
 
+        /**
+         * This method selects the cryptographic backend to use with keys
+         * configured from now on.  By default, the most preferred backend
+         * which supports the key is used.
+         *
+         * @param[in] backendName
+         *     This is the name of the backend to use, as returned by
+         *     CryptoSigning::GetBackendNames, or an empty string to use
+         *     the most preferred backend which supports the key.
+         *
+         * @return
+         *     An indication of whether or not the backend is built into
+         *     the library is returned.
+         */
+        bool SetBackend(const std::string& backendName);
+
+        /**
+         * This method turns on or off the RSA blinding factor pool.
+         *
+         * RSA signatures are blinded, to protect the private key from
+         * timing attacks, and computing fresh blinding factors from time
+         * to time makes some signatures take noticeably longer than others.
+         * When the pool is turned on, a background thread keeps a number
+         * of blinding factors precomputed for the configured key, so that
+         * signing takes them ready-made.
+         *
+         * The setting carries over when the instance is configured
+         * with a different key.
+         *
+         * @param[in] poolSize
+         *     This is the number of blinding factors to keep ready.
+         *     If zero, the pool is turned off.
+         *
+         * @return
+         *     An indication of whether or not the pool is in use is returned.
+         *     This is false if the pool was requested but the configured key
+         *     isn't an RSA private key (or no key is configured yet).
+         */
+        bool SetBlindingPoolSize(size_t poolSize);
+
         /**
          * This method cryptographically signs the given data chunk using the
          * configured key.
@@ -68,6 +114,53 @@ namespace CryptoSigning {
          */
         std::vector< uint8_t > operator()(const std::vector< uint8_t >& data);
 
+        /**
+         * This method cryptographically signs the data chunk with the
+         * given SHA-256 digest using the configured key, making the same
+         * signature the function call operator would make for the data
+         * chunk itself.
+         *
+         * Keys such as Ed25519 keys, whose signature schemes digest data
+         * chunks themselves, can't sign digests.
+         *
+         * @param[in] digest
+         *     This is the SHA-256 digest of the data chunk to sign.
+         *
+         * @return
+         *     The raw binary cryptographic signature is returned, or an
+         *     empty vector if the digest could not be signed.
+         */
+        std::vector< uint8_t > SignDigest(const std::vector< uint8_t >& digest);
+
+        /**
+         * This function cryptographically signs the given data chunk with
+         * each of the given instances, such as when signing with both the
+         * old and the new key during a key rotation.  The data chunk is
+         * digested only once, and the signatures are made concurrently,
+         * using a pool of worker threads.  Instances configured with keys
+         * which can't sign digests sign the data chunk itself.
+         *
+         * @param[in] signers
+         *     These are the instances with which to sign the data chunk.
+         *
+         * @param[in] data
+         *     This is the data chunk to cryptographically sign.
+         *
+         * @param[in] workers
+         *     This is the maximum number of worker threads to use.  If zero,
+         *     the number of hardware threads available is used.
+         *
+         * @return
+         *     The raw binary cryptographic signatures are returned, in the
+         *     same order as the instances.  Each is empty if the data chunk
+         *     could not be signed with its instance.
+         */
+        static std::vector< std::vector< uint8_t > > SignWithEach(
+            const std::vector< Sign* >& signers,
+            const std::vector< uint8_t >& data,
+            size_t workers = 0
+        );
+
         // Private Properties
     private:
         /**
@@ -0,0 +1,122 @@
+#ifndef CRYPTO_SIGNING_SIGN_CLIENT_HPP
+#define CRYPTO_SIGNING_SIGN_CLIENT_HPP
+
+/**
+ * @file SignClient.hpp
+ *
+ * This module declares the CryptoSigning::SignClient class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <future>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class is used to have data signed by a SignServer, which holds
+     * the private keys, over a UNIX domain socket.
+     *
+     * Requests are sent without waiting for earlier requests to be
+     * answered, so many may be in flight at once.  The instance may be
+     * used from multiple threads at once.
+     */
+    class SignClient {
+        // Lifecycle management
+    public:
+        ~SignClient() noexcept;
+        SignClient(const SignClient&) = delete;
+        SignClient(SignClient&&) noexcept;
+        SignClient& operator=(const SignClient&) = delete;
+        SignClient& operator=(SignClient&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        SignClient();
+
+        /**
+         * This method connects the client to a server.
+         *
+         * @param[in] socketPath
+         *     This is the path of the UNIX domain socket of the server.
+         *
+         * @return
+         *     An indication of whether or not the client successfully
+         *     connected to the server is returned.
+         */
+        bool Connect(const std::string& socketPath);
+
+        /**
+         * This method disconnects the client from the server.  Requests
+         * not yet answered are completed with empty signatures.
+         */
+        void Disconnect();
+
+        /**
+         * This method asks the server to cryptographically sign the given
+         * data chunk using the key with the given name.
+         *
+         * @param[in] keyName
+         *     This is the name of the key to use.  Requests naming a key
+         *     longer than 255 characters fail.
+         *
+         * @param[in] data
+         *     This is the data chunk to cryptographically sign.
+         *
+         * @return
+         *     A future which will hold the raw binary cryptographic signature
+         *     is returned.  The signature will be empty if the data could not
+         *     be signed.
+         */
+        std::future< std::vector< uint8_t > > operator()(
+            const std::string& keyName,
+            const std::vector< uint8_t >& data
+        );
+
+        /**
+         * This method asks the server to cryptographically sign each of
+         * the given data chunks using the key with the given name.  All
+         * of the requests are sent to the server together.
+         *
+         * @param[in] keyName
+         *     This is the name of the key to use.  Requests naming a key
+         *     longer than 255 characters fail.
+         *
+         * @param[in] dataChunks
+         *     These are the data chunks to cryptographically sign.
+         *
+         * @return
+         *     Futures which will hold the raw binary cryptographic signatures
+         *     are returned, in the same order as the data chunks.  Each
+         *     signature will be empty if its data chunk could not be signed.
+         */
+        std::vector< std::future< std::vector< uint8_t > > > SignBatch(
+            const std::string& keyName,
+            const std::vector< std::vector< uint8_t > >& dataChunks
+        );
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_SIGN_CLIENT_HPP */
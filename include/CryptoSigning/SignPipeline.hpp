@@ -0,0 +1,128 @@
+#ifndef CRYPTO_SIGNING_SIGN_PIPELINE_HPP
+#define CRYPTO_SIGNING_SIGN_PIPELINE_HPP
+
+/**
+ * @file SignPipeline.hpp
+ *
+ * This module declares the CryptoSigning::SignPipeline class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class signs a continuous stream of data chunks, digesting each
+     * data chunk on one thread while the private key operation for the
+     * data chunk before it is done on another.  The stages are connected
+     * by bounded queues which don't need locking, and signatures come out
+     * in the same order as the data chunks went in.
+     *
+     * One thread may put data chunks into the pipeline while another
+     * takes signatures out of it.  When the pipeline is full, putting a
+     * data chunk into it waits for a signature to be taken out.
+     *
+     * Keys such as Ed25519 keys, which can't sign digests, sign each
+     * whole data chunk in the private key stage, so for them the stages
+     * don't overlap.
+     */
+    class SignPipeline {
+        // Lifecycle management
+    public:
+        ~SignPipeline() noexcept;
+        SignPipeline(const SignPipeline&) = delete;
+        SignPipeline(SignPipeline&&) noexcept;
+        SignPipeline& operator=(const SignPipeline&) = delete;
+        SignPipeline& operator=(SignPipeline&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        SignPipeline();
+
+        /**
+         * This method starts the threads which carry out the stages of
+         * the pipeline.  If the pipeline was already started, it's
+         * stopped first.
+         *
+         * @param[in] sign
+         *     This is the configured instance to use to sign data.
+         *
+         * @param[in] queueCapacity
+         *     This is the most items to hold in each queue between the
+         *     stages of the pipeline.
+         */
+        void Start(
+            std::shared_ptr< Sign > sign,
+            size_t queueCapacity = 64
+        );
+
+        /**
+         * This method stops the threads which carry out the stages of
+         * the pipeline.  Data chunks not yet signed, and signatures not
+         * yet taken out of the pipeline, are discarded.  Any thread
+         * waiting to put a data chunk into the pipeline or to take a
+         * signature out of it gives up.
+         */
+        void Stop();
+
+        /**
+         * This method puts the given data chunk into the pipeline, waiting
+         * for room if the pipeline is full.  Only one thread at a time
+         * may put data chunks into the pipeline.
+         *
+         * @param[in] data
+         *     This is the data chunk to cryptographically sign.
+         *
+         * @return
+         *     An indication of whether or not the data chunk was put
+         *     into the pipeline is returned.  This is false if the
+         *     pipeline isn't started or is stopped while waiting.
+         */
+        bool Push(std::vector< uint8_t > data);
+
+        /**
+         * This method takes the next signature out of the pipeline, waiting
+         * for it to be made if necessary.  Only one thread at a time may
+         * take signatures out of the pipeline.
+         *
+         * @param[out] signature
+         *     This is where to store the raw binary cryptographic signature
+         *     of the oldest data chunk put into the pipeline whose signature
+         *     hasn't yet been taken out.  It's empty if the data chunk could
+         *     not be signed.
+         *
+         * @return
+         *     An indication of whether or not a signature was taken out
+         *     of the pipeline is returned.  This is false if the pipeline
+         *     isn't started or is stopped while waiting.
+         */
+        bool Pop(std::vector< uint8_t >& signature);
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_SIGN_PIPELINE_HPP */
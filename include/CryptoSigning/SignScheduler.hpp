@@ -0,0 +1,241 @@
+#ifndef CRYPTO_SIGNING_SIGN_SCHEDULER_HPP
+#define CRYPTO_SIGNING_SIGN_SCHEDULER_HPP
+
+/**
+ * @file SignScheduler.hpp
+ *
+ * This module declares the CryptoSigning::SignScheduler class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * These are the classes of signing requests handled by a
+     * SignScheduler, from most to least urgent.
+     */
+    enum class SignPriority {
+        /**
+         * This is for requests someone is waiting on, such as those
+         * made on behalf of interactive users.
+         */
+        Urgent,
+
+        /**
+         * This is for ordinary requests.
+         */
+        Normal,
+
+        /**
+         * This is for background work, such as re-signing large numbers
+         * of documents, which can wait for more urgent requests.
+         */
+        Bulk,
+    };
+
+    /**
+     * These are the possible outcomes of a request to a SignScheduler.
+     */
+    enum class SignStatus {
+        /**
+         * The data was signed.
+         */
+        Signed,
+
+        /**
+         * The request was dropped without being signed, because its
+         * deadline passed while it was waiting in the queue.
+         */
+        DeadlineMissed,
+
+        /**
+         * The data could not be signed.
+         */
+        Failed,
+
+        /**
+         * The request was dropped without being signed, because the
+         * scheduler was stopped.
+         */
+        Cancelled,
+    };
+
+    /**
+     * This holds the result of a request to a SignScheduler.
+     */
+    struct SignResult {
+        /**
+         * This indicates what became of the request.
+         */
+        SignStatus status = SignStatus::Failed;
+
+        /**
+         * This is the raw binary cryptographic signature, if the data
+         * was signed.
+         */
+        std::vector< uint8_t > signature;
+
+        /**
+         * This is how long the request waited in the queue before a
+         * worker thread took it.
+         */
+        std::chrono::microseconds waitTime{0};
+    };
+
+    /**
+     * This holds statistics about one class of requests to a SignScheduler.
+     */
+    struct SignQueueMetrics {
+        /**
+         * This is the number of requests currently waiting in the queue.
+         */
+        size_t queueDepth = 0;
+
+        /**
+         * This is the number of requests whose data was signed.
+         */
+        size_t signedCount = 0;
+
+        /**
+         * This is the number of requests dropped because their deadlines
+         * passed while they were waiting in the queue.
+         */
+        size_t deadlineMissedCount = 0;
+
+        /**
+         * This is the number of requests whose data could not be signed.
+         */
+        size_t failedCount = 0;
+
+        /**
+         * This is the mean time requests waited in the queue before
+         * a worker thread took them.
+         */
+        std::chrono::microseconds meanWaitTime{0};
+
+        /**
+         * This is the longest time any request waited in the queue before
+         * a worker thread took it.
+         */
+        std::chrono::microseconds maxWaitTime{0};
+    };
+
+    /**
+     * This class shares the capacity of a Sign instance between requests of
+     * differing urgency.  Requests are signed by a pool of worker threads,
+     * which always take the most urgent request waiting, and the oldest
+     * one of those.  A request whose deadline passes before a worker
+     * thread takes it is dropped without being signed.
+     *
+     * Less urgent requests wait for as long as more urgent ones keep
+     * arriving, so Urgent should be reserved for work which is small
+     * compared to the capacity of the worker threads.
+     *
+     * The instance may be used from multiple threads at once.
+     */
+    class SignScheduler {
+        // Lifecycle management
+    public:
+        ~SignScheduler() noexcept;
+        SignScheduler(const SignScheduler&) = delete;
+        SignScheduler(SignScheduler&&) noexcept;
+        SignScheduler& operator=(const SignScheduler&) = delete;
+        SignScheduler& operator=(SignScheduler&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        SignScheduler();
+
+        /**
+         * This method starts the worker threads which sign data.
+         * Requests submitted before the scheduler is started wait
+         * in the queue until then.
+         *
+         * @param[in] sign
+         *     This is the configured instance to use to sign data.
+         *
+         * @param[in] workers
+         *     This is the number of worker threads to use to sign data.
+         *     If zero, the number of hardware threads available is used.
+         */
+        void Start(
+            std::shared_ptr< Sign > sign,
+            size_t workers = 0
+        );
+
+        /**
+         * This method stops the worker threads, after they finish the
+         * requests they have already taken.  Requests still waiting
+         * in the queue are completed with the Cancelled status.
+         */
+        void Stop();
+
+        /**
+         * This method queues a request to cryptographically sign the
+         * given data chunk.
+         *
+         * @param[in] data
+         *     This is the data chunk to cryptographically sign.
+         *
+         * @param[in] priority
+         *     This is the class of the request.
+         *
+         * @param[in] deadline
+         *     This is the time by which a worker thread must take the
+         *     request, after which it is dropped without being signed.
+         *
+         * @return
+         *     A future which will hold the result of the request
+         *     is returned.
+         */
+        std::future< SignResult > Submit(
+            const std::vector< uint8_t >& data,
+            SignPriority priority = SignPriority::Normal,
+            std::chrono::steady_clock::time_point deadline = (
+                std::chrono::steady_clock::time_point::max()
+            )
+        );
+
+        /**
+         * This method returns statistics about the given class of requests,
+         * covering every request since the instance was constructed.
+         *
+         * @param[in] priority
+         *     This is the class of requests of interest.
+         *
+         * @return
+         *     Statistics about the given class of requests are returned.
+         */
+        SignQueueMetrics GetMetrics(SignPriority priority);
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_SIGN_SCHEDULER_HPP */
@@ -0,0 +1,146 @@
+#ifndef CRYPTO_SIGNING_SIGN_SERVER_HPP
+#define CRYPTO_SIGNING_SIGN_SERVER_HPP
+
+/**
+ * @file SignServer.hpp
+ *
+ * This module declares the CryptoSigning::SignServer class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sign.hpp"
+
+#include <functional>
+#include <memory>
+#include <stddef.h>
+#include <string>
+
+namespace CryptoSigning {
+
+    /**
+     * This class holds private keys on behalf of other processes, and
+     * signs data for them, taking requests from SignClient instances
+     * over a UNIX domain socket.
+     *
+     * Requests are read as they arrive, without waiting for earlier
+     * requests to be answered, and are signed by a pool of worker
+     * threads.  Responses may therefore come back in a different order
+     * than the requests were made.
+     *
+     * The number of requests waiting to be signed is limited, both for
+     * each client and overall, as is the amount of response data waiting
+     * for a client to read it.  While over a limit, the server stops
+     * reading requests from the client, so a client which sends requests
+     * faster than they can be signed, or which doesn't read its responses,
+     * is held back without holding up other clients.
+     */
+    class SignServer {
+        // Types
+    public:
+        /**
+         * This is the type of function called to report an error which
+         * makes the server stop serving clients.
+         *
+         * @param[in] message
+         *     This describes the error.
+         */
+        typedef std::function< void(const std::string& message) > ErrorDelegate;
+
+        // Lifecycle management
+    public:
+        ~SignServer() noexcept;
+        SignServer(const SignServer&) = delete;
+        SignServer(SignServer&&) noexcept;
+        SignServer& operator=(const SignServer&) = delete;
+        SignServer& operator=(SignServer&&) noexcept;
+
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.
+         */
+        SignServer();
+
+        /**
+         * This method adds a key with which clients may request data
+         * to be signed.  Keys must be added before the server is started.
+         *
+         * @param[in] name
+         *     This is the name clients use to select the key.  It may
+         *     not be longer than 255 characters.
+         *
+         * @param[in] sign
+         *     This is the configured instance to use to sign data
+         *     with the key.
+         *
+         * @return
+         *     An indication of whether or not the key was added is
+         *     returned.  Keys can't be added while the server is started.
+         */
+        bool AddKey(
+            const std::string& name,
+            std::shared_ptr< Sign > sign
+        );
+
+        /**
+         * This method sets the function to call, from the server's own
+         * thread, if an error makes the server stop serving clients.
+         * Stop should still be called afterwards.
+         *
+         * @param[in] errorDelegate
+         *     This is the function to call to report the error.
+         *
+         * @return
+         *     An indication of whether or not the function was set is
+         *     returned.  It can't be set while the server is started.
+         */
+        bool SetErrorDelegate(ErrorDelegate errorDelegate);
+
+        /**
+         * This method starts accepting clients and signing data for them.
+         *
+         * @param[in] socketPath
+         *     This is the path at which to create the UNIX domain socket
+         *     on which to accept clients.  Only the owner of the server
+         *     process is given permission to connect to it.  If a socket
+         *     is already there, it's replaced, but any other kind of file
+         *     is left alone, and the server fails to start.
+         *
+         * @param[in] workers
+         *     This is the number of worker threads to use to sign data.
+         *     If zero, the number of hardware threads available is used.
+         *
+         * @return
+         *     An indication of whether or not the server was
+         *     successfully started is returned.
+         */
+        bool Start(
+            const std::string& socketPath,
+            size_t workers = 0
+        );
+
+        /**
+         * This method stops the server, disconnecting any clients and
+         * removing its socket.  Requests not yet answered are dropped.
+         */
+        void Stop();
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_SIGN_SERVER_HPP */
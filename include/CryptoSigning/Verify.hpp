@@ -9,6 +9,7 @@
  * © 2018 by Richard Walters
  */
 
+#include <chrono>
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
@@ -20,6 +21,11 @@ namespace CryptoSigning {
     /**
      * This class is used to verify a cryptographic signature for a chunk of
      * data, using a public or private key in PEM format.
+     *
+     * The instance may be configured with a new key while other threads
+     * are using it to verify signatures.  Verifications already under way
+     * finish with the key they started with.  Its settings may also be
+     * changed while other threads are using or configuring it.
      */
     class Verify {
         // Lifecycle management
@@ -37,6 +43,36 @@ namespace CryptoSigning {
          */
         Verify();
 
+        /**
+         * This method selects the cryptographic backend to use with keys
+         * configured from now on.  By default, the most preferred backend
+         * which supports the key is used.
+         *
+         * @param[in] backendName
+         *     This is the name of the backend to use, as returned by
+         *     CryptoSigning::GetBackendNames, or an empty string to use
+         *     the most preferred backend which supports the key.
+         *
+         * @return
+         *     An indication of whether or not the backend is built into
+         *     the library is returned.
+         */
+        bool SetBackend(const std::string& backendName);
+
+        /**
+         * This method sets how long signatures made with a key continue
+         * to be accepted after the instance is configured with a new key,
+         * so that signatures made before the new key was rolled out
+         * everywhere still verify.  By default, there is no grace period.
+         *
+         * The setting applies to keys replaced from now on.
+         *
+         * @param[in] gracePeriod
+         *     This is how long to keep accepting signatures made with
+         *     a key after it's replaced.
+         */
+        void SetRotationGracePeriod(std::chrono::milliseconds gracePeriod);
+
         /**
          * This method sets up the instance to verify cryptographic signatures
          * made with the private key that corresponds to the given public key,
@@ -57,6 +93,10 @@ namespace CryptoSigning {
          * made with the private key that corresponds to the given public key,
          * or by using the same private key directly.
          *
+         * If the key can't be used, the instance is left with no key, so
+         * that every signature fails to verify, rather than keep using
+         * the key it had before.
+         *
          * @param[in] keyModulus
          *     This points to the memory containing the modulus
          *     of the public key to use in verifying cryptographic signatures.
@@ -100,6 +140,163 @@ namespace CryptoSigning {
             const std::vector< uint8_t >& signature
         );
 
+        /**
+         * This method verifies that the given cryptographic signature matches
+         * the configured key and the given data chunk.
+         *
+         * @param[in] data
+         *     This points to the data chunk whose signature is to be verified.
+         *
+         * @param[in] dataLength
+         *     This is the length, in bytes, of the data chunk.
+         *
+         * @param[in] signature
+         *     This points to the raw binary cryptographic signature
+         *     to verify.
+         *
+         * @param[in] signatureLength
+         *     This is the length, in bytes, of the signature.
+         *
+         * @return
+         *     An indication of whether or not the given cryptographic
+         *     signature matches the configured key and the given data chunk
+         *     is returned.
+         */
+        bool operator()(
+            const uint8_t* data,
+            size_t dataLength,
+            const uint8_t* signature,
+            size_t signatureLength
+        );
+
+        /**
+         * This method verifies that the given cryptographic signature
+         * matches the configured key and the data chunk with the given
+         * SHA-256 digest, without needing the data chunk itself.
+         *
+         * Keys such as Ed25519 keys, whose signature schemes digest data
+         * chunks themselves, can't verify digests.
+         *
+         * @param[in] digest
+         *     This is the SHA-256 digest of the data chunk whose signature
+         *     is to be verified.
+         *
+         * @param[in] signature
+         *     This is the raw binary cryptographic signature.
+         *
+         * @return
+         *     An indication of whether or not the signature matches the
+         *     key and the data chunk is returned.
+         */
+        bool VerifyDigest(
+            const std::vector< uint8_t >& digest,
+            const std::vector< uint8_t >& signature
+        );
+
+        /**
+         * This function verifies the given cryptographic signatures of the
+         * given data chunk, each with its own instance, such as when a
+         * document needs approval from several parties.  The data chunk is
+         * digested only once, and the signatures are verified concurrently,
+         * using a pool of worker threads.  Instances configured with keys
+         * which can't verify digests verify the data chunk itself.
+         *
+         * @param[in] verifiers
+         *     These are the instances with which to verify the signatures.
+         *
+         * @param[in] data
+         *     This is the data chunk whose signatures are to be verified.
+         *
+         * @param[in] signatures
+         *     These are the raw binary cryptographic signatures, in the
+         *     same order as the instances with which to verify them.
+         *
+         * @param[in] workers
+         *     This is the maximum number of worker threads to use.  If zero,
+         *     the number of hardware threads available is used.
+         *
+         * @return
+         *     For each instance, an indication of whether or not its
+         *     signature matches its key and the data chunk is returned.
+         */
+        static std::vector< bool > VerifyWithEach(
+            const std::vector< Verify* >& verifiers,
+            const std::vector< uint8_t >& data,
+            const std::vector< std::vector< uint8_t > >& signatures,
+            size_t workers = 0
+        );
+
+        /**
+         * This method verifies a JSON Web Signature (RFC 7515) in compact
+         * serialization, signed with RS256 (RSASSA-PKCS1-v1_5 using SHA-256)
+         * by the configured key.
+         *
+         * The signing input is hashed directly from the given token, and
+         * the signature is decoded into a buffer on the stack, so the
+         * token is never copied.  Tokens which are not three unpadded
+         * base64url segments separated by periods, or whose signature is
+         * not the size of the key, are rejected before any public key
+         * operation is done.
+         *
+         * The protected header is not parsed; the caller is responsible
+         * for checking that its "alg" member is "RS256" if that matters.
+         *
+         * @param[in] token
+         *     This points to the token to verify.
+         *
+         * @param[in] tokenLength
+         *     This is the length, in characters, of the token.
+         *
+         * @return
+         *     An indication of whether or not the token is well-formed and
+         *     its signature matches the configured key is returned.
+         */
+        bool VerifyJwsCompact(
+            const char* token,
+            size_t tokenLength
+        );
+
+        /**
+         * This method verifies a JSON Web Signature (RFC 7515) in compact
+         * serialization, signed with RS256 by the configured key.
+         *
+         * @param[in] token
+         *     This is the token to verify.
+         *
+         * @return
+         *     An indication of whether or not the token is well-formed and
+         *     its signature matches the configured key is returned.
+         */
+        bool VerifyJwsCompact(const std::string& token);
+
+        /**
+         * This method verifies a batch of cryptographic signatures made
+         * with the configured key.
+         *
+         * For RSA keys with a public exponent of 65537, on processors
+         * supporting AVX-512 IFMA, the libcrypto backend verifies eight
+         * signatures at a time, which takes much less time per signature
+         * than verifying them one at a time.  Otherwise, the signatures
+         * are verified one at a time.
+         *
+         * @param[in] dataChunks
+         *     These are the data chunks whose signatures are to be verified.
+         *
+         * @param[in] signatures
+         *     These are the raw binary cryptographic signatures to verify,
+         *     in the same order as the data chunks.
+         *
+         * @return
+         *     For each data chunk, an indication of whether or not its
+         *     signature matches the configured key is returned, in the
+         *     same order as the data chunks.  Data chunks without
+         *     a corresponding signature are reported as not matching.
+         */
+        std::vector< bool > VerifyBatch(
+            const std::vector< std::vector< uint8_t > >& dataChunks,
+            const std::vector< std::vector< uint8_t > >& signatures
+        );
+
         // Private Properties
     private:
         /**
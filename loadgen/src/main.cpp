@@ -0,0 +1,716 @@
+/**
+ * @file main.cpp
+ *
+ * This module holds the main() function, which is the entrypoint
+ * to the load generator, a program which drives the CryptoSigning
+ * library from many threads at once for a fixed duration, and reports
+ * the throughput, processor utilization and latency distribution.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <CryptoSigning/Backends.hpp>
+#include <CryptoSigning/KeyGen.hpp>
+#include <math.h>
+#include <memory>
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is the largest size, in bytes, of data chunk allowed.  Each
+     * thread keeps a data chunk of every size given, so this keeps a
+     * mistyped size from exhausting memory.
+     */
+    constexpr size_t MAX_PAYLOAD_SIZE = 16 * 1024 * 1024;
+
+    /**
+     * These are the operations the load generator can perform.
+     */
+    enum class Operation {
+        Sign,
+        Verify,
+    };
+
+    /**
+     * This describes one size of data chunk to sign or verify.
+     */
+    struct PayloadSpec {
+        /**
+         * This is the size, in bytes, of the data chunk.
+         */
+        size_t size;
+
+        /**
+         * This is how often data chunks of this size are used,
+         * relative to the other sizes.
+         */
+        double weight;
+
+        /**
+         * This is the constructor.
+         *
+         * @param[in] size
+         *     This is the size, in bytes, of the data chunk.
+         *
+         * @param[in] weight
+         *     This is how often data chunks of this size are used,
+         *     relative to the other sizes.
+         */
+        explicit PayloadSpec(
+            size_t size = 0,
+            double weight = 1.0
+        )
+            : size(size)
+            , weight(weight)
+        {
+        }
+    };
+
+    /**
+     * This contains variables set through the operating system environment
+     * or the command-line arguments.
+     */
+    struct Environment {
+        /**
+         * This is the number of threads to use to generate load, or zero
+         * to use the number of hardware threads available.
+         */
+        size_t threads = 0;
+
+        /**
+         * This is how long to generate load, in seconds.
+         */
+        double duration = 10.0;
+
+        /**
+         * These are the names of the kinds of keys to use.
+         */
+        std::vector< std::string > keyTypes;
+
+        /**
+         * These are the operations to perform.
+         */
+        std::vector< Operation > operations;
+
+        /**
+         * These are the sizes of data chunks to use.
+         */
+        std::vector< PayloadSpec > payloads;
+
+        /**
+         * This indicates whether or not to report results in JSON format.
+         */
+        bool json = false;
+    };
+
+    /**
+     * This holds one key with which load is generated.
+     */
+    struct KeyUnderTest {
+        /**
+         * This is the name of the kind of key.
+         */
+        std::string name;
+
+        /**
+         * This is the key, along with instances configured to use it.
+         */
+        CryptoSigning::GeneratedKey key;
+
+        /**
+         * These are signatures made with the key, one for each data chunk.
+         */
+        std::vector< std::vector< uint8_t > > signatures;
+    };
+
+    /**
+     * This holds the measurements of one operation with one key.
+     */
+    struct Measurements {
+        /**
+         * These are the latencies, in microseconds, of the operations.
+         */
+        std::vector< double > latencies;
+
+        /**
+         * This is the number of operations which failed.
+         */
+        size_t failures = 0;
+    };
+
+    /**
+     * This function prints to the standard error stream information
+     * about how to use this program.
+     */
+    void PrintUsageInformation() {
+        fprintf(
+            stderr,
+            (
+                "Usage: CryptoSigningLoadGenerator [OPTIONS]\n"
+                "\n"
+                "Sign and verify data from many threads at once for a fixed\n"
+                "duration, and report throughput, processor utilization and\n"
+                "latency percentiles.\n"
+                "\n"
+                "  --threads N          Number of threads generating load\n"
+                "                       (default: hardware threads).\n"
+                "  --duration SECONDS   How long to generate load (default: 10).\n"
+                "  --key TYPE           Kind of key to use: rsaBITS (e.g. rsa2048),\n"
+                "                       ec-p256 or ed25519 (default: rsa2048).\n"
+                "  --operation OP       Operation to perform: sign or verify\n"
+                "                       (default: sign).\n"
+                "  --payload SIZE[:W]   Size of data chunks to use, in bytes, with\n"
+                "                       optional k or m suffix, and relative\n"
+                "                       weight W (default: 256, at most 16m).\n"
+                "  --json               Report results in JSON format.\n"
+                "\n"
+                "Options other than --threads, --duration and --json may be\n"
+                "given more than once.  Each operation picks an operation, key\n"
+                "and data chunk size at random.\n"
+            )
+        );
+    }
+
+    /**
+     * This function parses a size of data chunk, with optional weight,
+     * from the given command-line argument.
+     *
+     * @param[in] arg
+     *     This is the command-line argument to parse.
+     *
+     * @param[out] payload
+     *     This is where to store the parsed size and weight.
+     *
+     * @return
+     *     An indication of whether or not the argument was parsed
+     *     successfully is returned.
+     */
+    bool ParsePayload(
+        const std::string& arg,
+        PayloadSpec& payload
+    ) {
+        if (
+            (arg.empty())
+            || (arg[0] < '0')
+            || (arg[0] > '9')
+        ) {
+            return false;
+        }
+        char* end;
+        const auto size = strtoull(arg.c_str(), &end, 10);
+        size_t multiplier = 1;
+        if ((*end == 'k') || (*end == 'K')) {
+            multiplier = 1024;
+            ++end;
+        } else if ((*end == 'm') || (*end == 'M')) {
+            multiplier = 1024 * 1024;
+            ++end;
+        }
+        if (
+            (size == 0)
+            || (size > MAX_PAYLOAD_SIZE / multiplier)
+        ) {
+            return false;
+        }
+        payload.size = (size_t)size * multiplier;
+        payload.weight = 1.0;
+        if (*end == ':') {
+            const auto weight = end + 1;
+            payload.weight = strtod(weight, &end);
+            if (
+                (end == weight)
+                || !isfinite(payload.weight)
+                || (payload.weight <= 0.0)
+            ) {
+                return false;
+            }
+        }
+        return (*end == '\0');
+    }
+
+    /**
+     * This function parses the name of a kind of key.
+     *
+     * @param[in] name
+     *     This is the name of the kind of key.
+     *
+     * @param[out] spec
+     *     This is where to store the description of the kind of key.
+     *
+     * @return
+     *     An indication of whether or not the name was recognized
+     *     is returned.
+     */
+    bool ParseKeyType(
+        const std::string& name,
+        CryptoSigning::KeySpec& spec
+    ) {
+        if (name == "ec-p256") {
+            spec.type = CryptoSigning::KeyType::EcP256;
+            return true;
+        }
+        if (name == "ed25519") {
+            spec.type = CryptoSigning::KeyType::Ed25519;
+            return true;
+        }
+        if (name.substr(0, 3) == "rsa") {
+            char* end;
+            spec.type = CryptoSigning::KeyType::Rsa;
+            spec.bits = (int)strtol(name.c_str() + 3, &end, 10);
+            return (
+                (*end == '\0')
+                && (spec.bits >= 1024)
+            );
+        }
+        return false;
+    }
+
+    /**
+     * This function updates the program environment to incorporate
+     * any applicable command-line arguments.
+     *
+     * @param[in] argc
+     *     This is the number of command-line arguments given to the program.
+     *
+     * @param[in] argv
+     *     This is the array of command-line arguments given to the program.
+     *
+     * @param[in,out] environment
+     *     This is the environment to update.
+     *
+     * @return
+     *     An indication of whether or not the command-line arguments were
+     *     parsed successfully is returned.
+     */
+    bool ProcessCommandLineArguments(
+        int argc,
+        char* argv[],
+        Environment& environment
+    ) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg(argv[i]);
+            if (arg == "--json") {
+                environment.json = true;
+                continue;
+            }
+            if (++i >= argc) {
+                return false;
+            }
+            const std::string value(argv[i]);
+            if (arg == "--threads") {
+                char* end;
+                environment.threads = (size_t)strtoul(value.c_str(), &end, 10);
+                if (
+                    (value.empty())
+                    || (value[0] < '0')
+                    || (value[0] > '9')
+                    || (*end != '\0')
+                    || (environment.threads == 0)
+                ) {
+                    return false;
+                }
+            } else if (arg == "--duration") {
+                char* end;
+                environment.duration = strtod(value.c_str(), &end);
+                if (
+                    (end == value.c_str())
+                    || (*end != '\0')
+                    || !isfinite(environment.duration)
+                    || (environment.duration <= 0.0)
+                ) {
+                    return false;
+                }
+            } else if (arg == "--key") {
+                CryptoSigning::KeySpec spec;
+                if (!ParseKeyType(value, spec)) {
+                    return false;
+                }
+                environment.keyTypes.push_back(value);
+            } else if (arg == "--operation") {
+                if (value == "sign") {
+                    environment.operations.push_back(Operation::Sign);
+                } else if (value == "verify") {
+                    environment.operations.push_back(Operation::Verify);
+                } else {
+                    return false;
+                }
+            } else if (arg == "--payload") {
+                PayloadSpec payload;
+                if (!ParsePayload(value, payload)) {
+                    return false;
+                }
+                environment.payloads.push_back(payload);
+            } else {
+                return false;
+            }
+        }
+        if (environment.threads == 0) {
+            environment.threads = std::max(
+                (size_t)std::thread::hardware_concurrency(),
+                (size_t)1
+            );
+        }
+        if (environment.keyTypes.empty()) {
+            environment.keyTypes.push_back("rsa2048");
+        }
+        if (environment.operations.empty()) {
+            environment.operations.push_back(Operation::Sign);
+        }
+        if (environment.payloads.empty()) {
+            environment.payloads.push_back(PayloadSpec(256, 1.0));
+        }
+        return true;
+    }
+
+    /**
+     * This function returns the name of the given operation.
+     *
+     * @param[in] operation
+     *     This is the operation whose name to return.
+     *
+     * @return
+     *     The name of the operation is returned.
+     */
+    const char* OperationName(Operation operation) {
+        return (operation == Operation::Sign) ? "sign" : "verify";
+    }
+
+    /**
+     * This function returns the given percentile of the given sorted
+     * measurements, using the nearest-rank method.
+     *
+     * @param[in] samples
+     *     These are the sorted measurements.
+     *
+     * @param[in] percentile
+     *     This is the percentile to return.
+     *
+     * @return
+     *     The given percentile of the measurements is returned.
+     */
+    double Percentile(
+        const std::vector< double >& samples,
+        double percentile
+    ) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        const auto rank = ceil(percentile / 100.0 * (double)samples.size());
+        if (rank < 1.0) {
+            return samples.front();
+        }
+        if (rank >= (double)samples.size()) {
+            return samples.back();
+        }
+        return samples[(size_t)rank - 1];
+    }
+
+    /**
+     * This function returns the amount of processor time, in seconds,
+     * used by the program so far, across all its threads.
+     *
+     * @return
+     *     The processor time used by the program is returned.
+     */
+    double GetProcessorTime() {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0.0;
+        }
+        return (
+            (double)usage.ru_utime.tv_sec
+            + (double)usage.ru_utime.tv_usec / 1e6
+            + (double)usage.ru_stime.tv_sec
+            + (double)usage.ru_stime.tv_usec / 1e6
+        );
+    }
+
+    /**
+     * This function prints a summary of the given measurements.
+     *
+     * @param[in] json
+     *     This indicates whether or not to print in JSON format.
+     *
+     * @param[in] operation
+     *     This is the name of the operation measured.
+     *
+     * @param[in] key
+     *     This is the name of the kind of key used.
+     *
+     * @param[in] measurements
+     *     These are the measurements to summarize.  The latencies
+     *     must be sorted.
+     *
+     * @param[in] elapsed
+     *     This is how long load was generated, in seconds.
+     *
+     * @param[in] last
+     *     This indicates whether or not this is the last summary printed.
+     */
+    void PrintSummary(
+        bool json,
+        const std::string& operation,
+        const std::string& key,
+        const Measurements& measurements,
+        double elapsed,
+        bool last
+    ) {
+        const auto& latencies = measurements.latencies;
+        double total = 0.0;
+        for (const auto latency: latencies) {
+            total += latency;
+        }
+        const auto mean = latencies.empty() ? 0.0 : total / latencies.size();
+        const auto opsPerSecond = (double)latencies.size() / elapsed;
+        if (json) {
+            printf(
+                (
+                    "    {\"operation\": \"%s\", \"key\": \"%s\", "
+                    "\"operations\": %zu, \"failures\": %zu, "
+                    "\"ops_per_second\": %.1f, "
+                    "\"latency_us\": {\"mean\": %.1f, \"p50\": %.1f, "
+                    "\"p99\": %.1f, \"p999\": %.1f}}%s\n"
+                ),
+                operation.c_str(),
+                key.c_str(),
+                latencies.size(),
+                measurements.failures,
+                opsPerSecond,
+                mean,
+                Percentile(latencies, 50.0),
+                Percentile(latencies, 99.0),
+                Percentile(latencies, 99.9),
+                last ? "" : ","
+            );
+        } else {
+            printf(
+                "%-8s %-10s n=%-9zu fail=%-5zu %10.1f ops/s mean=%9.1fus p50=%9.1fus p99=%9.1fus p999=%9.1fus\n",
+                operation.c_str(),
+                key.c_str(),
+                latencies.size(),
+                measurements.failures,
+                opsPerSecond,
+                mean,
+                Percentile(latencies, 50.0),
+                Percentile(latencies, 99.0),
+                Percentile(latencies, 99.9)
+            );
+        }
+    }
+
+}
+
+/**
+ * This function is the entrypoint of the program.
+ *
+ * @param[in] argc
+ *     This is the number of command-line arguments given to the program.
+ *
+ * @param[in] argv
+ *     This is the array of command-line arguments given to the program.
+ */
+int main(int argc, char* argv[]) {
+    Environment environment;
+    if (!ProcessCommandLineArguments(argc, argv, environment)) {
+        PrintUsageInformation();
+        return EXIT_FAILURE;
+    }
+
+    // Prepare data chunks, keys, and signatures for verification.
+    std::mt19937 generator(0x5eed);
+    std::vector< std::vector< uint8_t > > payloads;
+    std::vector< double > weights;
+    for (const auto& payloadSpec: environment.payloads) {
+        std::vector< uint8_t > payload(payloadSpec.size);
+        for (auto& byte: payload) {
+            byte = (uint8_t)generator();
+        }
+        payloads.push_back(std::move(payload));
+        weights.push_back(payloadSpec.weight);
+    }
+    std::vector< std::unique_ptr< KeyUnderTest > > keys;
+    for (const auto& keyType: environment.keyTypes) {
+        CryptoSigning::KeySpec spec;
+        (void)ParseKeyType(keyType, spec);
+        std::unique_ptr< KeyUnderTest > key(new KeyUnderTest());
+        key->name = keyType;
+        key->key = CryptoSigning::GenerateKey(spec);
+        if (!key->key.success) {
+            fprintf(
+                stderr,
+                "error: unable to generate '%s' key\n",
+                keyType.c_str()
+            );
+            return EXIT_FAILURE;
+        }
+        for (const auto& payload: payloads) {
+            key->signatures.push_back(key->key.sign(payload));
+        }
+        keys.push_back(std::move(key));
+    }
+
+    // Generate load.
+    const auto numOperations = environment.operations.size();
+    const auto numKeys = keys.size();
+    std::vector< std::vector< Measurements > > measurements(
+        environment.threads,
+        std::vector< Measurements >(numOperations * numKeys)
+    );
+    std::atomic< bool > stop(false);
+    const auto generateLoad = [&](size_t threadIndex){
+        std::mt19937 random((unsigned int)threadIndex);
+        std::uniform_int_distribution< size_t > pickOperation(
+            0,
+            numOperations - 1
+        );
+        std::uniform_int_distribution< size_t > pickKey(0, numKeys - 1);
+        std::discrete_distribution< size_t > pickPayload(
+            weights.begin(),
+            weights.end()
+        );
+        auto& threadMeasurements = measurements[threadIndex];
+        while (!stop) {
+            const auto operationIndex = pickOperation(random);
+            const auto keyIndex = pickKey(random);
+            const auto payloadIndex = pickPayload(random);
+            auto& key = *keys[keyIndex];
+            const auto& payload = payloads[payloadIndex];
+            bool success;
+            const auto start = std::chrono::steady_clock::now();
+            if (environment.operations[operationIndex] == Operation::Sign) {
+                success = !key.key.sign(payload).empty();
+            } else {
+                success = key.key.verify(
+                    payload,
+                    key.signatures[payloadIndex]
+                );
+            }
+            const auto end = std::chrono::steady_clock::now();
+            auto& scenario = threadMeasurements[
+                operationIndex * numKeys + keyIndex
+            ];
+            scenario.latencies.push_back(
+                std::chrono::duration< double, std::micro >(end - start).count()
+            );
+            if (!success) {
+                ++scenario.failures;
+            }
+        }
+    };
+    const auto processorTimeBefore = GetProcessorTime();
+    const auto start = std::chrono::steady_clock::now();
+    std::vector< std::thread > threads;
+    for (size_t i = 0; i < environment.threads; ++i) {
+        threads.emplace_back(generateLoad, i);
+    }
+    std::this_thread::sleep_for(
+        std::chrono::duration< double >(environment.duration)
+    );
+    stop = true;
+    for (auto& thread: threads) {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration< double >(
+        std::chrono::steady_clock::now() - start
+    ).count();
+    const auto processorTime = GetProcessorTime() - processorTimeBefore;
+    const auto hardwareThreads = std::max(
+        (size_t)std::thread::hardware_concurrency(),
+        (size_t)1
+    );
+    const auto utilization = processorTime / (elapsed * hardwareThreads);
+
+    // Combine the measurements of all threads and report them.
+    std::vector< Measurements > combined(numOperations * numKeys);
+    Measurements overall;
+    for (const auto& threadMeasurements: measurements) {
+        for (size_t i = 0; i < combined.size(); ++i) {
+            const auto& scenario = threadMeasurements[i];
+            combined[i].latencies.insert(
+                combined[i].latencies.end(),
+                scenario.latencies.begin(),
+                scenario.latencies.end()
+            );
+            combined[i].failures += scenario.failures;
+            overall.latencies.insert(
+                overall.latencies.end(),
+                scenario.latencies.begin(),
+                scenario.latencies.end()
+            );
+            overall.failures += scenario.failures;
+        }
+    }
+    for (auto& scenario: combined) {
+        std::sort(scenario.latencies.begin(), scenario.latencies.end());
+    }
+    std::sort(overall.latencies.begin(), overall.latencies.end());
+    const auto backends = CryptoSigning::GetBackendNames();
+    if (environment.json) {
+        printf("{\n");
+        printf("  \"backends\": [");
+        for (size_t i = 0; i < backends.size(); ++i) {
+            printf("%s\"%s\"", (i == 0) ? "" : ", ", backends[i].c_str());
+        }
+        printf("],\n");
+        printf("  \"threads\": %zu,\n", environment.threads);
+        printf("  \"hardware_threads\": %zu,\n", hardwareThreads);
+        printf("  \"duration_seconds\": %.3f,\n", elapsed);
+        printf("  \"payloads\": [");
+        for (size_t i = 0; i < environment.payloads.size(); ++i) {
+            printf(
+                "%s{\"size\": %zu, \"weight\": %g}",
+                (i == 0) ? "" : ", ",
+                environment.payloads[i].size,
+                environment.payloads[i].weight
+            );
+        }
+        printf("],\n");
+        printf("  \"cpu_seconds\": %.3f,\n", processorTime);
+        printf("  \"cpu_utilization\": %.4f,\n", utilization);
+        printf("  \"results\": [\n");
+    } else {
+        printf(
+            "%zu threads, %.1f s, CPU utilization %.1f%% of %zu hardware threads\n",
+            environment.threads,
+            elapsed,
+            utilization * 100.0,
+            hardwareThreads
+        );
+    }
+    for (size_t operationIndex = 0; operationIndex < numOperations; ++operationIndex) {
+        for (size_t keyIndex = 0; keyIndex < numKeys; ++keyIndex) {
+            PrintSummary(
+                environment.json,
+                OperationName(environment.operations[operationIndex]),
+                keys[keyIndex]->name,
+                combined[operationIndex * numKeys + keyIndex],
+                elapsed,
+                false
+            );
+        }
+    }
+    PrintSummary(
+        environment.json,
+        "all",
+        "all",
+        overall,
+        elapsed,
+        true
+    );
+    if (environment.json) {
+        printf("  ]\n");
+        printf("}\n");
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Backend.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::Backend functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Backend.hpp"
+#include "OpenSslBackend.hpp"
+#ifdef CRYPTO_SIGNING_WITH_SODIUM
+#include "SodiumBackend.hpp"
+#endif /* CRYPTO_SIGNING_WITH_SODIUM */
+
+#include <CryptoSigning/Backends.hpp>
+
+namespace {
+
+    /**
+     * This function makes a signer or verifier for the given key, using
+     * the given backend, or the most preferred backend which
+     * supports the key.
+     *
+     * @param[in] backendName
+     *     This is the name of the backend to use, or an empty string
+     *     to use the most preferred backend which supports the key.
+     *
+     * @param[in] key
+     *     This is the key to use.
+     *
+     * @param[in] factory
+     *     This selects which of the backend's functions to use.
+     *
+     * @return
+     *     The signer or verifier is returned, or nullptr if the backend
+     *     isn't known or doesn't support the key.
+     */
+    template< typename T > std::unique_ptr< T > Make(
+        const std::string& backendName,
+        EVP_PKEY* key,
+        std::unique_ptr< T > (* CryptoSigning::Backend::Provider::* factory)(EVP_PKEY*)
+    ) {
+        if (key == NULL) {
+            return nullptr;
+        }
+        for (const auto& provider: CryptoSigning::Backend::GetProviders()) {
+            if (
+                !backendName.empty()
+                && (backendName != provider.name)
+            ) {
+                continue;
+            }
+            auto made = (provider.*factory)(key);
+            if (made != nullptr) {
+                return made;
+            }
+        }
+        return nullptr;
+    }
+
+}
+
+namespace CryptoSigning {
+
+    namespace Backend {
+
+        const std::vector< Provider >& GetProviders() {
+            static const std::vector< Provider > providers{
+#ifdef CRYPTO_SIGNING_WITH_SODIUM
+                {
+                    "libsodium",
+                    SodiumBackend::MakeSigner,
+                    SodiumBackend::MakeVerifier,
+                },
+#endif /* CRYPTO_SIGNING_WITH_SODIUM */
+                {
+                    OpenSslBackend::NAME,
+                    OpenSslBackend::MakeSigner,
+                    OpenSslBackend::MakeVerifier,
+                },
+            };
+            return providers;
+        }
+
+        bool IsKnown(const std::string& backendName) {
+            if (backendName.empty()) {
+                return true;
+            }
+            for (const auto& provider: GetProviders()) {
+                if (backendName == provider.name) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::unique_ptr< Signer > MakeSigner(
+            const std::string& backendName,
+            EVP_PKEY* key
+        ) {
+            return Make(backendName, key, &Provider::makeSigner);
+        }
+
+        std::unique_ptr< Verifier > MakeVerifier(
+            const std::string& backendName,
+            EVP_PKEY* key
+        ) {
+            return Make(backendName, key, &Provider::makeVerifier);
+        }
+
+    }
+
+    std::vector< std::string > GetBackendNames() {
+        std::vector< std::string > names;
+        for (const auto& provider: Backend::GetProviders()) {
+            names.push_back(provider.name);
+        }
+        return names;
+    }
+
+}
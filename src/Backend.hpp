@@ -0,0 +1,326 @@
+#ifndef CRYPTO_SIGNING_BACKEND_HPP
+#define CRYPTO_SIGNING_BACKEND_HPP
+
+/**
+ * @file Backend.hpp
+ *
+ * This module declares the interface between the CryptoSigning::Sign
+ * and CryptoSigning::Verify classes and the cryptographic libraries
+ * which carry out their operations.
+ *
+ * Keys are always parsed by libcrypto.  Each backend is then offered the
+ * parsed key, and makes a signer or verifier for it if it supports
+ * that kind of key.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <memory>
+#include <openssl/evp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace CryptoSigning {
+
+    namespace Backend {
+
+        /**
+         * This is the interface to an object which makes cryptographic
+         * signatures with one private key.
+         */
+        class Signer {
+        public:
+            virtual ~Signer() = default;
+
+            /**
+             * This method makes a cryptographic signature for the
+             * given data chunk.
+             *
+             * @param[in] data
+             *     This points to the data chunk to sign.
+             *
+             * @param[in] length
+             *     This is the length, in bytes, of the data chunk.
+             *
+             * @return
+             *     The raw binary cryptographic signature is returned, or
+             *     an empty vector if the signature could not be made.
+             */
+            virtual std::vector< uint8_t > Sign(
+                const uint8_t* data,
+                size_t length
+            ) = 0;
+
+            /**
+             * This method returns an indication of whether or not the
+             * signer can sign a data chunk given only its SHA-256 digest.
+             * Signature schemes such as Ed25519, which digest messages
+             * themselves, can't.
+             *
+             * @return
+             *     An indication of whether or not the signer can sign
+             *     digests is returned.
+             */
+            virtual bool SupportsDigests() const {
+                return false;
+            }
+
+            /**
+             * This method makes a cryptographic signature for the data
+             * chunk with the given SHA-256 digest, if the signer
+             * supports it.
+             *
+             * @param[in] digest
+             *     This points to the SHA-256 digest of the data chunk.
+             *
+             * @return
+             *     The raw binary cryptographic signature is returned, or
+             *     an empty vector if the signature could not be made.
+             */
+            virtual std::vector< uint8_t > SignDigest(
+                const uint8_t* digest
+            ) {
+                (void)digest;
+                return {};
+            }
+
+            /**
+             * This method turns on or off the RSA blinding factor pool,
+             * if the signer supports it.
+             *
+             * @param[in] poolSize
+             *     This is the number of blinding factors to keep ready.
+             *     If zero, the pool is turned off.
+             *
+             * @return
+             *     An indication of whether or not the pool is in use
+             *     as requested is returned.
+             */
+            virtual bool SetBlindingPoolSize(size_t poolSize) {
+                return (poolSize == 0);
+            }
+        };
+
+        /**
+         * This is the interface to an object which verifies cryptographic
+         * signatures with one public key.
+         */
+        class Verifier {
+        public:
+            virtual ~Verifier() = default;
+
+            /**
+             * This method verifies that the given cryptographic signature
+             * matches the key and the given data chunk.
+             *
+             * @param[in] data
+             *     This points to the data chunk whose signature
+             *     is to be verified.
+             *
+             * @param[in] dataLength
+             *     This is the length, in bytes, of the data chunk.
+             *
+             * @param[in] signature
+             *     This points to the raw binary cryptographic signature.
+             *
+             * @param[in] signatureLength
+             *     This is the length, in bytes, of the signature.
+             *
+             * @return
+             *     An indication of whether or not the signature matches
+             *     the key and the data chunk is returned.
+             */
+            virtual bool Verify(
+                const uint8_t* data,
+                size_t dataLength,
+                const uint8_t* signature,
+                size_t signatureLength
+            ) = 0;
+
+            /**
+             * This method returns an indication of whether or not the
+             * verifier can verify the signature of a data chunk given only
+             * its SHA-256 digest.  Signature schemes such as Ed25519, which
+             * digest messages themselves, can't.
+             *
+             * @return
+             *     An indication of whether or not the verifier can verify
+             *     digests is returned.
+             */
+            virtual bool SupportsDigests() const {
+                return false;
+            }
+
+            /**
+             * This method verifies that the given cryptographic signature
+             * matches the key and the data chunk with the given SHA-256
+             * digest, if the verifier supports it.
+             *
+             * @param[in] digest
+             *     This points to the SHA-256 digest of the data chunk.
+             *
+             * @param[in] signature
+             *     This points to the raw binary cryptographic signature.
+             *
+             * @param[in] signatureLength
+             *     This is the length, in bytes, of the signature.
+             *
+             * @return
+             *     An indication of whether or not the signature matches
+             *     the key and the data chunk is returned.
+             */
+            virtual bool VerifyDigest(
+                const uint8_t* digest,
+                const uint8_t* signature,
+                size_t signatureLength
+            ) {
+                (void)digest;
+                (void)signature;
+                (void)signatureLength;
+                return false;
+            }
+
+            /**
+             * This method verifies a batch of cryptographic signatures.
+             * By default, the signatures are verified one at a time.
+             *
+             * @param[in] dataChunks
+             *     These are the data chunks whose signatures
+             *     are to be verified.
+             *
+             * @param[in] signatures
+             *     These are the raw binary cryptographic signatures,
+             *     in the same order as the data chunks.
+             *
+             * @return
+             *     For each data chunk, an indication of whether or not
+             *     its signature matches the key is returned.
+             */
+            virtual std::vector< bool > VerifyBatch(
+                const std::vector< std::vector< uint8_t > >& dataChunks,
+                const std::vector< std::vector< uint8_t > >& signatures
+            ) {
+                std::vector< bool > results(dataChunks.size(), false);
+                for (size_t i = 0; i < dataChunks.size(); ++i) {
+                    if (i < signatures.size()) {
+                        results[i] = Verify(
+                            dataChunks[i].data(),
+                            dataChunks[i].size(),
+                            signatures[i].data(),
+                            signatures[i].size()
+                        );
+                    }
+                }
+                return results;
+            }
+        };
+
+        /**
+         * This describes one backend.
+         */
+        struct Provider {
+            /**
+             * This is the name of the backend.
+             */
+            const char* name;
+
+            /**
+             * This function makes a signer for the given private key.
+             *
+             * @param[in] key
+             *     This is the private key to use.  The signer takes
+             *     its own reference to it.
+             *
+             * @return
+             *     The signer is returned, or nullptr if the backend
+             *     doesn't support the key.
+             */
+            std::unique_ptr< Signer > (*makeSigner)(EVP_PKEY* key);
+
+            /**
+             * This function makes a verifier for the given key.
+             *
+             * @param[in] key
+             *     This is the public or private key to use.  The verifier
+             *     takes its own reference to it.
+             *
+             * @return
+             *     The verifier is returned, or nullptr if the backend
+             *     doesn't support the key.
+             */
+            std::unique_ptr< Verifier > (*makeVerifier)(EVP_PKEY* key);
+        };
+
+        /**
+         * This function returns the backends built into the library,
+         * in order of preference.
+         *
+         * @return
+         *     The backends built into the library are returned.
+         */
+        const std::vector< Provider >& GetProviders();
+
+        /**
+         * This function checks whether or not the given backend
+         * is built into the library.
+         *
+         * @param[in] backendName
+         *     This is the name of the backend to check, or an empty string
+         *     to refer to the most preferred backend which supports a key.
+         *
+         * @return
+         *     An indication of whether or not the given backend is built
+         *     into the library is returned.  This is always true for
+         *     an empty string.
+         */
+        bool IsKnown(const std::string& backendName);
+
+        /**
+         * This function makes a signer for the given private key, using
+         * the given backend, or the most preferred backend which
+         * supports the key.
+         *
+         * @param[in] backendName
+         *     This is the name of the backend to use, or an empty string
+         *     to use the most preferred backend which supports the key.
+         *
+         * @param[in] key
+         *     This is the private key to use.
+         *
+         * @return
+         *     The signer is returned, or nullptr if the backend isn't
+         *     known or doesn't support the key.
+         */
+        std::unique_ptr< Signer > MakeSigner(
+            const std::string& backendName,
+            EVP_PKEY* key
+        );
+
+        /**
+         * This function makes a verifier for the given key, using
+         * the given backend, or the most preferred backend which
+         * supports the key.
+         *
+         * @param[in] backendName
+         *     This is the name of the backend to use, or an empty string
+         *     to use the most preferred backend which supports the key.
+         *
+         * @param[in] key
+         *     This is the public or private key to use.
+         *
+         * @return
+         *     The verifier is returned, or nullptr if the backend isn't
+         *     known or doesn't support the key.
+         */
+        std::unique_ptr< Verifier > MakeVerifier(
+            const std::string& backendName,
+            EVP_PKEY* key
+        );
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_BACKEND_HPP */
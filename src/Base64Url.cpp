@@ -0,0 +1,152 @@
+/**
+ * @file Base64Url.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::Base64Url functions.
+ *
+ * The decoder works on groups of four characters at a time, looking up
+ * each character in a table which maps it either to its 6-bit value or
+ * to a marker with the high bit set.  Markers are accumulated with a
+ * bitwise OR rather than checked one character at a time, so the inner
+ * loop has no data-dependent branches and is checked once at the end.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Base64Url.hpp"
+
+namespace {
+
+    /**
+     * This is the value in the decoding table for characters which
+     * are not part of the base64url alphabet.
+     */
+    constexpr uint8_t INVALID = 0x80;
+
+    /**
+     * This is the table used to decode base64url characters.
+     */
+    struct DecodingTable {
+        /**
+         * This holds the 6-bit value of each character in the base64url
+         * alphabet, and INVALID for every other character.
+         */
+        uint8_t values[256];
+
+        /**
+         * This constructor builds the table.
+         */
+        DecodingTable() {
+            for (auto& value: values) {
+                value = INVALID;
+            }
+            const char alphabet[] = (
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz"
+                "0123456789-_"
+            );
+            for (uint8_t i = 0; i < 64; ++i) {
+                values[(uint8_t)alphabet[i]] = i;
+            }
+        }
+    };
+
+    /**
+     * This is the table used to decode base64url characters.
+     */
+    const DecodingTable DECODING_TABLE;
+
+    /**
+     * This function looks up the given character in the decoding table.
+     *
+     * @param[in] c
+     *     This is the character to look up.
+     *
+     * @return
+     *     The 6-bit value of the character is returned, or INVALID
+     *     if it isn't part of the base64url alphabet.
+     */
+    inline uint32_t Lookup(char c) {
+        return DECODING_TABLE.values[(uint8_t)c];
+    }
+
+}
+
+namespace CryptoSigning {
+
+    namespace Base64Url {
+
+        size_t DecodedLength(size_t length) {
+            return (length / 4) * 3 + ((length % 4) * 3) / 4;
+        }
+
+        bool IsValid(
+            const char* encoding,
+            size_t length
+        ) {
+            if (length % 4 == 1) {
+                return false;
+            }
+            uint32_t markers = 0;
+            for (size_t i = 0; i < length; ++i) {
+                markers |= Lookup(encoding[i]);
+            }
+            if ((markers & INVALID) != 0) {
+                return false;
+            }
+            switch (length % 4) {
+                case 2: return (Lookup(encoding[length - 1]) & 0x0f) == 0;
+                case 3: return (Lookup(encoding[length - 1]) & 0x03) == 0;
+                default: return true;
+            }
+        }
+
+        bool Decode(
+            const char* encoding,
+            size_t length,
+            uint8_t* output
+        ) {
+            if (length % 4 == 1) {
+                return false;
+            }
+            uint32_t markers = 0;
+            const auto fullGroups = length / 4;
+            for (size_t group = 0; group < fullGroups; ++group) {
+                const auto a = Lookup(encoding[0]);
+                const auto b = Lookup(encoding[1]);
+                const auto c = Lookup(encoding[2]);
+                const auto d = Lookup(encoding[3]);
+                markers |= a | b | c | d;
+                const auto bits = (a << 18) | (b << 12) | (c << 6) | d;
+                output[0] = (uint8_t)(bits >> 16);
+                output[1] = (uint8_t)(bits >> 8);
+                output[2] = (uint8_t)bits;
+                encoding += 4;
+                output += 3;
+            }
+            switch (length % 4) {
+                case 2: {
+                    const auto a = Lookup(encoding[0]);
+                    const auto b = Lookup(encoding[1]);
+                    markers |= a | b | ((b & 0x0f) == 0 ? 0 : INVALID);
+                    output[0] = (uint8_t)((a << 2) | (b >> 4));
+                } break;
+
+                case 3: {
+                    const auto a = Lookup(encoding[0]);
+                    const auto b = Lookup(encoding[1]);
+                    const auto c = Lookup(encoding[2]);
+                    markers |= a | b | c | ((c & 0x03) == 0 ? 0 : INVALID);
+                    const auto bits = (a << 12) | (b << 6) | c;
+                    output[0] = (uint8_t)(bits >> 10);
+                    output[1] = (uint8_t)(bits >> 2);
+                } break;
+
+                default: break;
+            }
+            return (markers & INVALID) == 0;
+        }
+
+    }
+
+}
@@ -0,0 +1,79 @@
+#ifndef CRYPTO_SIGNING_BASE64_URL_HPP
+#define CRYPTO_SIGNING_BASE64_URL_HPP
+
+/**
+ * @file Base64Url.hpp
+ *
+ * This module declares the CryptoSigning::Base64Url functions, which
+ * check and decode the unpadded base64url encoding (RFC 4648 section 5)
+ * used in JSON Web Signatures.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CryptoSigning {
+
+    namespace Base64Url {
+
+        /**
+         * This function returns the number of bytes encoded by the
+         * given number of base64url characters.
+         *
+         * @param[in] length
+         *     This is the number of base64url characters.
+         *
+         * @return
+         *     The number of bytes encoded is returned.
+         */
+        size_t DecodedLength(size_t length);
+
+        /**
+         * This function checks that the given text is a well-formed,
+         * unpadded base64url encoding.
+         *
+         * @param[in] encoding
+         *     This points to the text to check.
+         *
+         * @param[in] length
+         *     This is the number of characters to check.
+         *
+         * @return
+         *     An indication of whether or not the text is a well-formed,
+         *     unpadded base64url encoding is returned.
+         */
+        bool IsValid(
+            const char* encoding,
+            size_t length
+        );
+
+        /**
+         * This function decodes the given unpadded base64url encoding.
+         *
+         * @param[in] encoding
+         *     This points to the text to decode.
+         *
+         * @param[in] length
+         *     This is the number of characters to decode.
+         *
+         * @param[out] output
+         *     This points to where to store the decoded bytes.  There must
+         *     be room for DecodedLength(length) bytes.
+         *
+         * @return
+         *     An indication of whether or not the text was a well-formed,
+         *     unpadded base64url encoding is returned.
+         */
+        bool Decode(
+            const char* encoding,
+            size_t length,
+            uint8_t* output
+        );
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_BASE64_URL_HPP */
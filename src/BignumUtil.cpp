@@ -0,0 +1,89 @@
+/**
+ * @file BignumUtil.cpp
+ *
+ * This module contains the implementation of the big number
+ * helper functions used by the RSA classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "BignumUtil.hpp"
+
+#include <openssl/rsa.h>
+
+#ifdef CRYPTO_SIGNING_OPENSSL_3
+#include <openssl/core_names.h>
+#endif /* CRYPTO_SIGNING_OPENSSL_3 */
+
+namespace CryptoSigning {
+
+    Bignum MakeBignum(BIGNUM* value) {
+        return Bignum(
+            value,
+            [](BIGNUM* p){
+                BN_clear_free(p);
+            }
+        );
+    }
+
+    BignumContext MakeBignumContext() {
+        return BignumContext(
+            BN_CTX_new(),
+            [](BN_CTX* p){
+                BN_CTX_free(p);
+            }
+        );
+    }
+
+    MontContext MakeMontContext(
+        const BIGNUM* modulus,
+        BN_CTX* ctx
+    ) {
+        MontContext mont(
+            BN_MONT_CTX_new(),
+            [](BN_MONT_CTX* p){
+                BN_MONT_CTX_free(p);
+            }
+        );
+        if (
+            (mont == nullptr)
+            || (BN_MONT_CTX_set(mont.get(), modulus, ctx) != 1)
+        ) {
+            return nullptr;
+        }
+        return mont;
+    }
+
+    bool GetRsaPublicParameters(
+        EVP_PKEY* key,
+        Bignum& n,
+        Bignum& e
+    ) {
+        if (EVP_PKEY_base_id(key) != EVP_PKEY_RSA) {
+            return false;
+        }
+#ifdef CRYPTO_SIGNING_OPENSSL_3
+        BIGNUM* rawN = NULL;
+        BIGNUM* rawE = NULL;
+        const auto gotN = EVP_PKEY_get_bn_param(key, OSSL_PKEY_PARAM_RSA_N, &rawN);
+        const auto gotE = EVP_PKEY_get_bn_param(key, OSSL_PKEY_PARAM_RSA_E, &rawE);
+        n = MakeBignum(rawN);
+        e = MakeBignum(rawE);
+        return ((gotN == 1) && (gotE == 1));
+#else /* CRYPTO_SIGNING_OPENSSL_3 */
+        const BIGNUM* rawN = NULL;
+        const BIGNUM* rawE = NULL;
+        RSA_get0_key(EVP_PKEY_get0_RSA(key), &rawN, &rawE, NULL);
+        if (
+            (rawN == NULL)
+            || (rawE == NULL)
+        ) {
+            return false;
+        }
+        n = MakeBignum(BN_dup(rawN));
+        e = MakeBignum(BN_dup(rawE));
+        return true;
+#endif /* CRYPTO_SIGNING_OPENSSL_3 */
+    }
+
+}
@@ -0,0 +1,123 @@
+#ifndef CRYPTO_SIGNING_BIGNUM_UTIL_HPP
+#define CRYPTO_SIGNING_BIGNUM_UTIL_HPP
+
+/**
+ * @file BignumUtil.hpp
+ *
+ * This module declares the smart pointer types and helper functions
+ * used by the RSA classes to work with libcrypto big numbers, and
+ * detects which libcrypto interfaces are available to them.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <functional>
+#include <memory>
+#include <openssl/bn.h>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+
+#if !defined(LIBRESSL_VERSION_NUMBER) \
+    && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#define CRYPTO_SIGNING_OPENSSL_3
+#endif
+
+#if !defined(LIBRESSL_VERSION_NUMBER) \
+    && (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+#define CRYPTO_SIGNING_MULTI_PRIME
+#endif
+
+namespace CryptoSigning {
+
+    /**
+     * This is the type of smart pointer used to hold big numbers.
+     */
+    typedef std::unique_ptr<
+        BIGNUM,
+        std::function< void(BIGNUM*) >
+    > Bignum;
+
+    /**
+     * This is the type of smart pointer used to hold the scratch space
+     * used in big number arithmetic.
+     */
+    typedef std::unique_ptr<
+        BN_CTX,
+        std::function< void(BN_CTX*) >
+    > BignumContext;
+
+    /**
+     * This is the type of smart pointer used to hold the precomputed
+     * values used in Montgomery multiplication.
+     */
+    typedef std::unique_ptr<
+        BN_MONT_CTX,
+        std::function< void(BN_MONT_CTX*) >
+    > MontContext;
+
+    /**
+     * This function takes ownership of the given big number.
+     *
+     * @param[in] value
+     *     This is the big number to take.
+     *
+     * @return
+     *     A smart pointer holding the big number is returned.  The big
+     *     number is cleared from memory when it's freed, since it may
+     *     be part of a private key.
+     */
+    Bignum MakeBignum(BIGNUM* value = BN_new());
+
+    /**
+     * This function makes a new scratch space for big number arithmetic.
+     *
+     * @return
+     *     The new scratch space is returned.
+     */
+    BignumContext MakeBignumContext();
+
+    /**
+     * This function precomputes the values used in Montgomery
+     * multiplication for the given modulus.
+     *
+     * @param[in] modulus
+     *     This is the modulus to use.
+     *
+     * @param[in] ctx
+     *     This is the scratch space to use.
+     *
+     * @return
+     *     The precomputed values are returned, or nullptr if they
+     *     could not be computed.
+     */
+    MontContext MakeMontContext(
+        const BIGNUM* modulus,
+        BN_CTX* ctx
+    );
+
+    /**
+     * This function extracts the modulus and public exponent
+     * of the given RSA key.
+     *
+     * @param[in] key
+     *     This is the key whose parameters are to be extracted.
+     *
+     * @param[out] n
+     *     This is where to store the modulus.
+     *
+     * @param[out] e
+     *     This is where to store the public exponent.
+     *
+     * @return
+     *     An indication of whether or not the key is an RSA key
+     *     whose parameters could be extracted is returned.
+     */
+    bool GetRsaPublicParameters(
+        EVP_PKEY* key,
+        Bignum& n,
+        Bignum& e
+    );
+
+}
+
+#endif /* CRYPTO_SIGNING_BIGNUM_UTIL_HPP */
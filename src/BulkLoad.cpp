@@ -0,0 +1,85 @@
+/**
+ * @file BulkLoad.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::LoadSignKeys and CryptoSigning::LoadVerifyKeys functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Parallel.hpp"
+
+#include <CryptoSigning/BulkLoad.hpp>
+#include <openssl/err.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function returns a description of the most recent error
+     * reported by libcrypto on the calling thread, and clears the
+     * calling thread's error queue.
+     *
+     * @return
+     *     A description of the most recent libcrypto error is returned.
+     */
+    std::string TakeLastError() {
+        const auto code = ERR_peek_last_error();
+        ERR_clear_error();
+        if (code == 0) {
+            return "unable to parse key";
+        }
+        char buffer[256];
+        ERR_error_string_n(code, buffer, sizeof(buffer));
+        return buffer;
+    }
+
+}
+
+namespace CryptoSigning {
+
+    std::vector< SignLoadResult > LoadSignKeys(
+        const std::vector< SignKeySource >& keys,
+        size_t workers
+    ) {
+        std::vector< SignLoadResult > results(keys.size());
+        RunInParallel(
+            keys.size(),
+            workers,
+            [&](size_t index){
+                auto& result = results[index];
+                ERR_clear_error();
+                result.success = result.sign.Configure(
+                    keys[index].keyPem,
+                    keys[index].passphrase
+                );
+                if (!result.success) {
+                    result.error = TakeLastError();
+                }
+            }
+        );
+        return results;
+    }
+
+    std::vector< VerifyLoadResult > LoadVerifyKeys(
+        const std::vector< std::string >& keyPems,
+        size_t workers
+    ) {
+        std::vector< VerifyLoadResult > results(keyPems.size());
+        RunInParallel(
+            keyPems.size(),
+            workers,
+            [&](size_t index){
+                auto& result = results[index];
+                ERR_clear_error();
+                result.success = result.verify.Configure(keyPems[index]);
+                if (!result.success) {
+                    result.error = TakeLastError();
+                }
+            }
+        );
+        return results;
+    }
+
+}
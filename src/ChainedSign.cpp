@@ -0,0 +1,143 @@
+/**
+ * @file ChainedSign.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::ChainedSign class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "HashChain.hpp"
+
+#include <CryptoSigning/ChainedSign.hpp>
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a ChainedSign instance.
+     */
+    struct ChainedSign::Impl {
+        /**
+         * This is the instance used to make signatures.
+         */
+        std::shared_ptr< Sign > sign;
+
+        /**
+         * This is the maximum number of segments to accept before
+         * issuing a signature, or zero if there is no limit.
+         */
+        size_t segmentsPerSignature = 0;
+
+        /**
+         * This is the maximum time to let pass between signatures,
+         * or zero if there is no limit.
+         */
+        std::chrono::milliseconds signatureInterval;
+
+        /**
+         * This is the running hash chain over the segments of the stream.
+         */
+        HashChain chain;
+
+        /**
+         * This is the number of segments appended since the last signature.
+         */
+        size_t pendingSegments = 0;
+
+        /**
+         * This is the time at which the last signature was issued,
+         * or the time at which the instance was configured if no
+         * signature has been issued yet.
+         */
+        std::chrono::steady_clock::time_point lastSignatureTime;
+
+        // Methods
+
+        /**
+         * This method signs the current state of the hash chain.
+         *
+         * @param[out] signature
+         *     This is where to store the raw binary cryptographic signature
+         *     covering all segments so far.
+         *
+         * @return
+         *     An indication of whether or not the signature was made
+         *     is returned.
+         */
+        Status SignChain(std::vector< uint8_t >& signature) {
+            signature.clear();
+            if (sign != nullptr) {
+                signature = (*sign)(
+                    chain.GetCheckpointMessage(STREAM_CHECKPOINT_CONTEXT)
+                );
+            }
+            if (signature.empty()) {
+                // Leave the segments pending, so that the next segment
+                // or flush tries again to cover them.
+                return Status::Failed;
+            }
+            pendingSegments = 0;
+            lastSignatureTime = std::chrono::steady_clock::now();
+            return Status::Signed;
+        }
+    };
+
+    ChainedSign::~ChainedSign() noexcept = default;
+    ChainedSign::ChainedSign(ChainedSign&&) noexcept = default;
+    ChainedSign& ChainedSign::operator=(ChainedSign&&) noexcept = default;
+
+    ChainedSign::ChainedSign()
+        : impl_(new Impl())
+    {
+    }
+
+    void ChainedSign::Configure(
+        std::shared_ptr< Sign > sign,
+        size_t segmentsPerSignature,
+        std::chrono::milliseconds signatureInterval
+    ) {
+        impl_.reset(new Impl());
+        impl_->sign = sign;
+        impl_->segmentsPerSignature = segmentsPerSignature;
+        impl_->signatureInterval = signatureInterval;
+        impl_->lastSignatureTime = std::chrono::steady_clock::now();
+    }
+
+    auto ChainedSign::operator()(
+        const std::vector< uint8_t >& segment,
+        std::vector< uint8_t >& signature
+    ) -> Status {
+        signature.clear();
+        impl_->chain.Append(segment.data(), segment.size());
+        ++impl_->pendingSegments;
+        if (
+            (
+                (impl_->segmentsPerSignature > 0)
+                && (impl_->pendingSegments >= impl_->segmentsPerSignature)
+            )
+            || (
+                (impl_->signatureInterval.count() > 0)
+                && (
+                    std::chrono::steady_clock::now() - impl_->lastSignatureTime
+                    >= impl_->signatureInterval
+                )
+            )
+        ) {
+            return impl_->SignChain(signature);
+        }
+        return Status::NotDue;
+    }
+
+    auto ChainedSign::Flush(std::vector< uint8_t >& signature) -> Status {
+        signature.clear();
+        if (impl_->pendingSegments == 0) {
+            return Status::NotDue;
+        }
+        return impl_->SignChain(signature);
+    }
+
+    uint64_t ChainedSign::GetSegments() const {
+        return impl_->chain.GetLength();
+    }
+
+}
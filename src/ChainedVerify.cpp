@@ -0,0 +1,111 @@
+/**
+ * @file ChainedVerify.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::ChainedVerify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "HashChain.hpp"
+
+#include <CryptoSigning/ChainedVerify.hpp>
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a ChainedVerify instance.
+     */
+    struct ChainedVerify::Impl {
+        /**
+         * This is the instance used to verify signatures.
+         */
+        std::shared_ptr< Verify > verify;
+
+        /**
+         * This is the maximum number of segments to accept without
+         * a signature, or zero if there is no limit.
+         */
+        size_t maxPendingSegments = 0;
+
+        /**
+         * This is the running hash chain over the segments of the stream.
+         */
+        HashChain chain;
+
+        /**
+         * This is the number of segments covered by a valid signature.
+         */
+        uint64_t verifiedSegments = 0;
+
+        /**
+         * This is the current state of the stream.
+         */
+        Status status = Status::Verified;
+    };
+
+    ChainedVerify::~ChainedVerify() noexcept = default;
+    ChainedVerify::ChainedVerify(ChainedVerify&&) noexcept = default;
+    ChainedVerify& ChainedVerify::operator=(ChainedVerify&&) noexcept = default;
+
+    ChainedVerify::ChainedVerify()
+        : impl_(new Impl())
+    {
+    }
+
+    void ChainedVerify::Configure(
+        std::shared_ptr< Verify > verify,
+        size_t maxPendingSegments
+    ) {
+        impl_.reset(new Impl());
+        impl_->verify = verify;
+        impl_->maxPendingSegments = maxPendingSegments;
+    }
+
+    auto ChainedVerify::operator()(
+        const std::vector< uint8_t >& segment
+    ) -> Status {
+        if (impl_->status == Status::Failed) {
+            return Status::Failed;
+        }
+        impl_->chain.Append(segment.data(), segment.size());
+        if (
+            (impl_->maxPendingSegments > 0)
+            && (
+                impl_->chain.GetLength() - impl_->verifiedSegments
+                > impl_->maxPendingSegments
+            )
+        ) {
+            impl_->status = Status::Failed;
+        } else {
+            impl_->status = Status::Pending;
+        }
+        return impl_->status;
+    }
+
+    auto ChainedVerify::Checkpoint(
+        const std::vector< uint8_t >& signature
+    ) -> Status {
+        if (impl_->status == Status::Failed) {
+            return Status::Failed;
+        }
+        if (
+            (impl_->verify != nullptr)
+            && (*impl_->verify)(
+                impl_->chain.GetCheckpointMessage(STREAM_CHECKPOINT_CONTEXT),
+                signature
+            )
+        ) {
+            impl_->verifiedSegments = impl_->chain.GetLength();
+            impl_->status = Status::Verified;
+        } else {
+            impl_->status = Status::Failed;
+        }
+        return impl_->status;
+    }
+
+    uint64_t ChainedVerify::GetVerifiedSegments() const {
+        return impl_->verifiedSegments;
+    }
+
+}
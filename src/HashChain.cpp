@@ -0,0 +1,58 @@
+/**
+ * @file HashChain.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::HashChain class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "HashChain.hpp"
+#include "Sha256.hpp"
+
+#include <string.h>
+
+namespace CryptoSigning {
+
+    HashChain::HashChain()
+        : digest_(SHA256_DIGEST_SIZE)
+    {
+    }
+
+    void HashChain::Reset(
+        uint64_t length,
+        const std::vector< uint8_t >& digest
+    ) {
+        length_ = length;
+        digest_ = digest;
+    }
+
+    void HashChain::Append(const uint8_t* data, size_t size) {
+        const auto chunkDigest = Sha256(data, size);
+        digest_.insert(digest_.end(), chunkDigest.begin(), chunkDigest.end());
+        digest_ = Sha256(digest_);
+        ++length_;
+    }
+
+    uint64_t HashChain::GetLength() const {
+        return length_;
+    }
+
+    const std::vector< uint8_t >& HashChain::GetDigest() const {
+        return digest_;
+    }
+
+    std::vector< uint8_t > HashChain::GetCheckpointMessage(
+        const char* context
+    ) const {
+        const auto contextSize = strlen(context) + 1;
+        std::vector< uint8_t > message(context, context + contextSize);
+        message.reserve(contextSize + 8 + digest_.size());
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            message.push_back((uint8_t)(length_ >> shift));
+        }
+        message.insert(message.end(), digest_.begin(), digest_.end());
+        return message;
+    }
+
+}
@@ -0,0 +1,119 @@
+#ifndef CRYPTO_SIGNING_HASH_CHAIN_HPP
+#define CRYPTO_SIGNING_HASH_CHAIN_HPP
+
+/**
+ * @file HashChain.hpp
+ *
+ * This module declares the CryptoSigning::HashChain class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This is the context label at the start of the messages signed to
+     * commit to streams, by the ChainedSign class.  Giving each use of
+     * checkpoint signatures its own label keeps a signature made for one
+     * from being accepted by another.
+     */
+    constexpr char STREAM_CHECKPOINT_CONTEXT[] = "CryptoSigning stream checkpoint v1";
+
+    /**
+     * This is the context label at the start of the messages signed to
+     * commit to append-only logs, by the LogSign class.
+     */
+    constexpr char LOG_CHECKPOINT_CONTEXT[] = "CryptoSigning log checkpoint v1";
+
+    /**
+     * This class maintains a running SHA-256 hash chain over a sequence
+     * of data chunks.  Each link is the digest of the previous link
+     * followed by the digest of the next chunk, so the latest link
+     * commits to every chunk appended so far, in order.
+     */
+    class HashChain {
+        // Public Methods
+    public:
+        /**
+         * This is the default constructor.  It starts an empty chain.
+         */
+        HashChain();
+
+        /**
+         * This method resumes the chain from a previously recorded state.
+         *
+         * @param[in] length
+         *     This is the number of chunks covered by the recorded state.
+         *
+         * @param[in] digest
+         *     This is the recorded link for the chain.
+         */
+        void Reset(
+            uint64_t length,
+            const std::vector< uint8_t >& digest
+        );
+
+        /**
+         * This method extends the chain with the given data chunk.
+         *
+         * @param[in] data
+         *     This points to the data chunk to append.
+         *
+         * @param[in] size
+         *     This is the number of bytes in the data chunk.
+         */
+        void Append(const uint8_t* data, size_t size);
+
+        /**
+         * This method returns the number of chunks appended to the chain.
+         *
+         * @return
+         *     The number of chunks appended to the chain is returned.
+         */
+        uint64_t GetLength() const;
+
+        /**
+         * This method returns the latest link of the chain.
+         *
+         * @return
+         *     The latest link of the chain is returned.
+         */
+        const std::vector< uint8_t >& GetDigest() const;
+
+        /**
+         * This method returns the message to sign in order to commit to
+         * the current state of the chain.  It is made up of the given
+         * context label, including its terminating zero byte, followed by
+         * the chain length, as a 64-bit big-endian integer, and then the
+         * latest link.
+         *
+         * @param[in] context
+         *     This is the context label, such as STREAM_CHECKPOINT_CONTEXT,
+         *     identifying what the signature is used for.
+         *
+         * @return
+         *     The message to sign for the current state of the chain
+         *     is returned.
+         */
+        std::vector< uint8_t > GetCheckpointMessage(const char* context) const;
+
+        // Private Properties
+    private:
+        /**
+         * This is the number of chunks appended to the chain.
+         */
+        uint64_t length_ = 0;
+
+        /**
+         * This is the latest link of the chain.
+         */
+        std::vector< uint8_t > digest_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_HASH_CHAIN_HPP */
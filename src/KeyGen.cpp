@@ -0,0 +1,194 @@
+/**
+ * @file KeyGen.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::GenerateKey function.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <CryptoSigning/KeyGen.hpp>
+#include <functional>
+#include <memory>
+#include <openssl/bio.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/opensslv.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <string>
+
+#if !defined(LIBRESSL_VERSION_NUMBER) \
+    && (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+#define CRYPTO_SIGNING_MULTI_PRIME
+#endif
+
+namespace {
+
+    /**
+     * This is the type of a key held by a smart pointer.
+     */
+    typedef std::unique_ptr< EVP_PKEY, std::function< void(EVP_PKEY*) > > Key;
+
+    /**
+     * This function generates a new key pair using libcrypto.
+     *
+     * @param[in] spec
+     *     This describes the key to generate.
+     *
+     * @return
+     *     The generated key is returned, or null if it could not
+     *     be generated.
+     */
+    Key MakeKey(const CryptoSigning::KeySpec& spec) {
+        Key key(
+            nullptr,
+            [](EVP_PKEY* p){
+                EVP_PKEY_free(p);
+            }
+        );
+        int keyId;
+        switch (spec.type) {
+            case CryptoSigning::KeyType::Rsa: keyId = EVP_PKEY_RSA; break;
+            case CryptoSigning::KeyType::EcP256: keyId = EVP_PKEY_EC; break;
+#ifdef EVP_PKEY_ED25519
+            case CryptoSigning::KeyType::Ed25519: keyId = EVP_PKEY_ED25519; break;
+#endif /* EVP_PKEY_ED25519 */
+            default: return key;
+        }
+        std::unique_ptr< EVP_PKEY_CTX, std::function< void(EVP_PKEY_CTX*) > > ctx(
+            EVP_PKEY_CTX_new_id(keyId, NULL),
+            [](EVP_PKEY_CTX* p){
+                EVP_PKEY_CTX_free(p);
+            }
+        );
+        if (
+            (ctx == nullptr)
+            || (EVP_PKEY_keygen_init(ctx.get()) <= 0)
+        ) {
+            return key;
+        }
+        switch (spec.type) {
+            case CryptoSigning::KeyType::Rsa: {
+                if (EVP_PKEY_CTX_set_rsa_keygen_bits(ctx.get(), spec.bits) <= 0) {
+                    return key;
+                }
+                if (spec.primes != 2) {
+#ifdef CRYPTO_SIGNING_MULTI_PRIME
+                    if (
+                        EVP_PKEY_CTX_set_rsa_keygen_primes(
+                            ctx.get(),
+                            spec.primes
+                        ) <= 0
+                    ) {
+                        return key;
+                    }
+#else
+                    return key;
+#endif
+                }
+            } break;
+
+            case CryptoSigning::KeyType::EcP256: {
+                if (
+                    (
+                        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(
+                            ctx.get(),
+                            NID_X9_62_prime256v1
+                        ) <= 0
+                    )
+                    || (
+                        EVP_PKEY_CTX_set_ec_param_enc(
+                            ctx.get(),
+                            OPENSSL_EC_NAMED_CURVE
+                        ) <= 0
+                    )
+                ) {
+                    return key;
+                }
+            } break;
+
+            default: break;
+        }
+        EVP_PKEY* rawKey = NULL;
+        if (EVP_PKEY_keygen(ctx.get(), &rawKey) > 0) {
+            key.reset(rawKey);
+        }
+        return key;
+    }
+
+    /**
+     * This function writes the private or public part of the given key
+     * in PEM format.
+     *
+     * @param[in] key
+     *     This is the key to write.
+     *
+     * @param[in] isPrivate
+     *     This indicates whether to write the private key (true)
+     *     or the public key (false).
+     *
+     * @return
+     *     The key in PEM format is returned, or an empty string if
+     *     it could not be written.
+     */
+    std::string WritePem(
+        EVP_PKEY* key,
+        bool isPrivate
+    ) {
+        std::unique_ptr< BIO, std::function< void(BIO*) > > output(
+            BIO_new(BIO_s_mem()),
+            [](BIO* p){
+                BIO_free_all(p);
+            }
+        );
+        if (output == nullptr) {
+            return "";
+        }
+        const auto written = (
+            isPrivate
+            ? PEM_write_bio_PrivateKey(
+                output.get(),
+                key,
+                NULL,
+                NULL,
+                0,
+                NULL,
+                NULL
+            )
+            : PEM_write_bio_PUBKEY(
+                output.get(),
+                key
+            )
+        );
+        if (written != 1) {
+            return "";
+        }
+        char* pem;
+        const auto length = BIO_get_mem_data(output.get(), &pem);
+        return std::string(pem, (size_t)length);
+    }
+
+}
+
+namespace CryptoSigning {
+
+    GeneratedKey GenerateKey(const KeySpec& spec) {
+        GeneratedKey generatedKey;
+        const auto key = MakeKey(spec);
+        if (key == nullptr) {
+            return generatedKey;
+        }
+        generatedKey.privateKeyPem = WritePem(key.get(), true);
+        generatedKey.publicKeyPem = WritePem(key.get(), false);
+        generatedKey.success = (
+            !generatedKey.privateKeyPem.empty()
+            && !generatedKey.publicKeyPem.empty()
+            && generatedKey.sign.Configure(generatedKey.privateKeyPem)
+            && generatedKey.verify.Configure(generatedKey.publicKeyPem)
+        );
+        return generatedKey;
+    }
+
+}
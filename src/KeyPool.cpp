@@ -0,0 +1,196 @@
+/**
+ * @file KeyPool.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::KeyPool class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <CryptoSigning/KeyPool.hpp>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is how long a refill thread waits before trying again
+     * after failing to generate a key for the first time in a row.
+     */
+    constexpr std::chrono::milliseconds MIN_RETRY_DELAY(10);
+
+    /**
+     * This is the longest a refill thread waits before trying again
+     * after failing to generate keys.  The delay doubles with each
+     * failure in a row, up to this limit.
+     */
+    constexpr std::chrono::milliseconds MAX_RETRY_DELAY(10000);
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a KeyPool instance.
+     */
+    struct KeyPool::Impl {
+        /**
+         * This describes the keys to generate.
+         */
+        KeySpec spec;
+
+        /**
+         * This is the number of keys to keep generated ahead of time.
+         */
+        size_t poolSize = 0;
+
+        /**
+         * These are the threads which keep the pool filled.
+         */
+        std::vector< std::thread > refillers;
+
+        /**
+         * This is used to synchronize access to the pool.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake up the refill threads when keys are
+         * taken from the pool or the pool is being reconfigured.
+         */
+        std::condition_variable wakeRefillers;
+
+        /**
+         * These are the keys generated ahead of time.
+         */
+        std::deque< GeneratedKey > pool;
+
+        /**
+         * This indicates whether or not the refill threads should stop.
+         */
+        bool stopping = false;
+
+        // Methods
+
+        ~Impl() noexcept {
+            StopRefilling();
+        }
+
+        /**
+         * This method stops the refill threads and empties the pool.
+         */
+        void StopRefilling() {
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                stopping = true;
+                wakeRefillers.notify_all();
+            }
+            for (auto& refiller: refillers) {
+                refiller.join();
+            }
+            refillers.clear();
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            pool.clear();
+        }
+
+        /**
+         * This method is the body of each refill thread.
+         */
+        void RefillThread() {
+            auto retryDelay = MIN_RETRY_DELAY;
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            for (;;) {
+                wakeRefillers.wait(
+                    lock,
+                    [this]{ return stopping || (pool.size() < poolSize); }
+                );
+                if (stopping) {
+                    break;
+                }
+                const auto keySpec = spec;
+                lock.unlock();
+                auto key = GenerateKey(keySpec);
+                lock.lock();
+                if (key.success) {
+                    retryDelay = MIN_RETRY_DELAY;
+                    if (pool.size() < poolSize) {
+                        pool.push_back(std::move(key));
+                    }
+                } else {
+                    // Back off rather than spinning, in case the failure
+                    // persists, such as when the system runs out of
+                    // entropy or memory.
+                    (void)wakeRefillers.wait_for(
+                        lock,
+                        retryDelay,
+                        [this]{ return stopping; }
+                    );
+                    retryDelay = std::min(retryDelay * 2, MAX_RETRY_DELAY);
+                }
+            }
+        }
+    };
+
+    KeyPool::~KeyPool() noexcept = default;
+    KeyPool::KeyPool(KeyPool&&) noexcept = default;
+    KeyPool& KeyPool::operator=(KeyPool&&) noexcept = default;
+
+    KeyPool::KeyPool()
+        : impl_(new Impl())
+    {
+    }
+
+    bool KeyPool::Configure(
+        const KeySpec& spec,
+        size_t poolSize,
+        size_t workers
+    ) {
+        impl_->StopRefilling();
+        GeneratedKey key;
+        if (
+            (poolSize == 0)
+            || (workers > 0)
+        ) {
+            key = GenerateKey(spec);
+        }
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->spec = spec;
+        impl_->poolSize = 0;
+        impl_->stopping = false;
+        if (!key.success) {
+            return false;
+        }
+        impl_->poolSize = poolSize;
+        impl_->pool.push_back(std::move(key));
+        for (size_t i = 0; i < workers; ++i) {
+            impl_->refillers.emplace_back(&Impl::RefillThread, impl_.get());
+        }
+        return true;
+    }
+
+    GeneratedKey KeyPool::Take() {
+        KeySpec spec;
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            if (!impl_->pool.empty()) {
+                auto key = std::move(impl_->pool.front());
+                impl_->pool.pop_front();
+                impl_->wakeRefillers.notify_one();
+                return key;
+            }
+            spec = impl_->spec;
+        }
+        return GenerateKey(spec);
+    }
+
+    size_t KeyPool::GetPoolLevel() {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->pool.size();
+    }
+
+}
@@ -0,0 +1,121 @@
+/**
+ * @file LogSign.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::LogSign class and CryptoSigning::LogCheckpoint structure.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "HashChain.hpp"
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <CryptoSigning/LogSign.hpp>
+
+namespace {
+
+    /**
+     * This is the number of bytes used to encode the number of entries
+     * covered by a checkpoint.
+     */
+    constexpr size_t ENTRIES_SIZE = 8;
+
+    /**
+     * This is the number of bytes of the context label, including its
+     * terminating zero byte, at the start of an encoded checkpoint.
+     */
+    constexpr size_t CONTEXT_SIZE = sizeof(CryptoSigning::LOG_CHECKPOINT_CONTEXT);
+
+}
+
+namespace CryptoSigning {
+
+    std::vector< uint8_t > LogCheckpoint::Serialize() const {
+        HashChain chain;
+        chain.Reset(entries, digest);
+        auto encoding = chain.GetCheckpointMessage(LOG_CHECKPOINT_CONTEXT);
+        encoding.insert(encoding.end(), signature.begin(), signature.end());
+        return encoding;
+    }
+
+    bool LogCheckpoint::Parse(const std::vector< uint8_t >& encoding) {
+        if (
+            (encoding.size() <= CONTEXT_SIZE + ENTRIES_SIZE + SHA256_DIGEST_SIZE)
+            || !std::equal(
+                encoding.begin(),
+                encoding.begin() + CONTEXT_SIZE,
+                (const uint8_t*)LOG_CHECKPOINT_CONTEXT
+            )
+        ) {
+            return false;
+        }
+        entries = 0;
+        for (size_t i = 0; i < ENTRIES_SIZE; ++i) {
+            entries = (entries << 8) | encoding[CONTEXT_SIZE + i];
+        }
+        const auto digestBegin = encoding.begin() + CONTEXT_SIZE + ENTRIES_SIZE;
+        const auto digestEnd = digestBegin + SHA256_DIGEST_SIZE;
+        digest.assign(digestBegin, digestEnd);
+        signature.assign(digestEnd, encoding.end());
+        return true;
+    }
+
+    /**
+     * This contains the private properties of a LogSign instance.
+     */
+    struct LogSign::Impl {
+        /**
+         * This is the instance used to sign checkpoints.
+         */
+        std::shared_ptr< Sign > sign;
+
+        /**
+         * This is the running hash chain over the entries of the log.
+         */
+        HashChain chain;
+    };
+
+    LogSign::~LogSign() noexcept = default;
+    LogSign::LogSign(LogSign&&) noexcept = default;
+    LogSign& LogSign::operator=(LogSign&&) noexcept = default;
+
+    LogSign::LogSign()
+        : impl_(new Impl())
+    {
+    }
+
+    void LogSign::Configure(std::shared_ptr< Sign > sign) {
+        impl_.reset(new Impl());
+        impl_->sign = sign;
+    }
+
+    bool LogSign::Resume(const LogCheckpoint& checkpoint) {
+        if (checkpoint.digest.size() != SHA256_DIGEST_SIZE) {
+            return false;
+        }
+        impl_->chain.Reset(checkpoint.entries, checkpoint.digest);
+        return true;
+    }
+
+    void LogSign::Append(const std::vector< uint8_t >& entry) {
+        impl_->chain.Append(entry.data(), entry.size());
+    }
+
+    LogCheckpoint LogSign::Checkpoint() const {
+        LogCheckpoint checkpoint;
+        checkpoint.entries = impl_->chain.GetLength();
+        checkpoint.digest = impl_->chain.GetDigest();
+        if (impl_->sign != nullptr) {
+            checkpoint.signature = (*impl_->sign)(
+                impl_->chain.GetCheckpointMessage(LOG_CHECKPOINT_CONTEXT)
+            );
+        }
+        return checkpoint;
+    }
+
+    uint64_t LogSign::GetEntries() const {
+        return impl_->chain.GetLength();
+    }
+
+}
@@ -0,0 +1,130 @@
+/**
+ * @file LogVerify.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::LogVerify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "HashChain.hpp"
+#include "Sha256.hpp"
+
+#include <CryptoSigning/LogVerify.hpp>
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a LogVerify instance.
+     */
+    struct LogVerify::Impl {
+        /**
+         * This is the instance used to verify checkpoint signatures.
+         */
+        std::shared_ptr< Verify > verify;
+
+        /**
+         * This is the last checkpoint verified.
+         */
+        LogCheckpoint lastVerified;
+
+        // Methods
+
+        /**
+         * This is the constructor.
+         */
+        Impl() {
+            lastVerified.digest = HashChain().GetDigest();
+        }
+
+        /**
+         * This method checks the signature of the given checkpoint
+         * against the given state of the hash chain.
+         *
+         * @param[in] chain
+         *     This is the state of the hash chain the checkpoint
+         *     should cover.
+         *
+         * @param[in] checkpoint
+         *     This is the checkpoint whose signature is to be checked.
+         *
+         * @return
+         *     An indication of whether or not the checkpoint covers the
+         *     given state of the hash chain and its signature is valid
+         *     is returned.
+         */
+        bool CheckSignature(
+            const HashChain& chain,
+            const LogCheckpoint& checkpoint
+        ) const {
+            return (
+                (verify != nullptr)
+                && (chain.GetLength() == checkpoint.entries)
+                && (chain.GetDigest() == checkpoint.digest)
+                && (*verify)(
+                    chain.GetCheckpointMessage(LOG_CHECKPOINT_CONTEXT),
+                    checkpoint.signature
+                )
+            );
+        }
+    };
+
+    LogVerify::~LogVerify() noexcept = default;
+    LogVerify::LogVerify(LogVerify&&) noexcept = default;
+    LogVerify& LogVerify::operator=(LogVerify&&) noexcept = default;
+
+    LogVerify::LogVerify()
+        : impl_(new Impl())
+    {
+    }
+
+    void LogVerify::Configure(std::shared_ptr< Verify > verify) {
+        impl_.reset(new Impl());
+        impl_->verify = verify;
+    }
+
+    bool LogVerify::Resume(const LogCheckpoint& checkpoint) {
+        if (checkpoint.digest.size() != SHA256_DIGEST_SIZE) {
+            return false;
+        }
+        HashChain chain;
+        chain.Reset(checkpoint.entries, checkpoint.digest);
+        if (!impl_->CheckSignature(chain, checkpoint)) {
+            return false;
+        }
+        impl_->lastVerified = checkpoint;
+        return true;
+    }
+
+    bool LogVerify::operator()(
+        const std::vector< std::vector< uint8_t > >& newEntries,
+        const LogCheckpoint& checkpoint
+    ) {
+        const auto& lastVerified = impl_->lastVerified;
+        if (
+            (checkpoint.entries < lastVerified.entries)
+            || (checkpoint.entries - lastVerified.entries != newEntries.size())
+        ) {
+            return false;
+        }
+        HashChain chain;
+        chain.Reset(lastVerified.entries, lastVerified.digest);
+        for (const auto& entry: newEntries) {
+            chain.Append(entry.data(), entry.size());
+        }
+        if (!impl_->CheckSignature(chain, checkpoint)) {
+            return false;
+        }
+        impl_->lastVerified = checkpoint;
+        return true;
+    }
+
+    LogCheckpoint LogVerify::GetLastVerifiedCheckpoint() const {
+        return impl_->lastVerified;
+    }
+
+    uint64_t LogVerify::GetVerifiedEntries() const {
+        return impl_->lastVerified.entries;
+    }
+
+}
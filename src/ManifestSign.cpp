@@ -0,0 +1,330 @@
+/**
+ * @file ManifestSign.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::ManifestSign class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "MerkleTree.hpp"
+
+#include <condition_variable>
+#include <CryptoSigning/ManifestSign.hpp>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+    /**
+     * This function builds a Merkle tree over the given leaf hashes,
+     * signs its root, and returns the inclusion proof of every leaf.
+     *
+     * @param[in] sign
+     *     This is the instance to use to sign the root of the tree.
+     *
+     * @param[in] leaves
+     *     These are the leaf hashes of the tree.
+     *
+     * @return
+     *     The inclusion proofs of the leaves are returned.  If there were
+     *     no leaves, or the root could not be signed, an empty vector
+     *     is returned.
+     */
+    std::vector< CryptoSigning::ManifestProof > SignLeaves(
+        const std::shared_ptr< CryptoSigning::Sign >& sign,
+        const std::vector< std::vector< uint8_t > >& leaves
+    ) {
+        if (
+            (sign == nullptr)
+            || leaves.empty()
+        ) {
+            return {};
+        }
+        std::vector< std::vector< std::vector< uint8_t > > > paths;
+        const auto root = CryptoSigning::MerkleTree::Build(leaves, paths);
+        const auto signature = (*sign)(
+            CryptoSigning::MerkleTree::RootMessage(leaves.size(), root)
+        );
+        if (signature.empty()) {
+            return {};
+        }
+        std::vector< CryptoSigning::ManifestProof > proofs(leaves.size());
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            auto& proof = proofs[i];
+            proof.index = i;
+            proof.size = leaves.size();
+            proof.path = std::move(paths[i]);
+            proof.signature = signature;
+        }
+        return proofs;
+    }
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a ManifestSign instance.
+     */
+    struct ManifestSign::Impl {
+        /**
+         * This holds a manifest taken from the instance to be signed.
+         */
+        struct Manifest {
+            /**
+             * This is the instance to use to sign the root of the manifest.
+             */
+            std::shared_ptr< Sign > sign;
+
+            /**
+             * These are the leaf hashes of the items in the manifest.
+             */
+            std::vector< std::vector< uint8_t > > leaves;
+
+            /**
+             * These are the promises of the proofs of the items
+             * in the manifest.
+             */
+            std::vector< std::promise< ManifestProof > > promises;
+        };
+
+        /**
+         * This is the instance used to sign the root of each manifest.
+         */
+        std::shared_ptr< Sign > sign;
+
+        /**
+         * This is the maximum number of items to collect before signing
+         * the manifest, or zero if there is no limit.
+         */
+        size_t maxItems = 0;
+
+        /**
+         * This is the maximum time to let pass, after the first item of
+         * a manifest is added, before signing the manifest, or zero if
+         * there is no limit.
+         */
+        std::chrono::milliseconds maxDelay{0};
+
+        /**
+         * This is used to synchronize access to the manifest
+         * being collected.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake up the timer thread when the first item
+         * of a manifest is added, or the thread should stop.
+         */
+        std::condition_variable wakeTimer;
+
+        /**
+         * These are the leaf hashes of the items in the manifest
+         * being collected.
+         */
+        std::vector< std::vector< uint8_t > > leaves;
+
+        /**
+         * These are the promises of the proofs of the items in the
+         * manifest being collected.
+         */
+        std::vector< std::promise< ManifestProof > > promises;
+
+        /**
+         * This is the time by which the manifest being collected
+         * should be signed, if maxDelay is set.
+         */
+        std::chrono::steady_clock::time_point deadline;
+
+        /**
+         * This is incremented each time a manifest is taken to be signed,
+         * so that the timer thread can tell whether the manifest it was
+         * waiting on was signed in the meantime.
+         */
+        uint64_t generation = 0;
+
+        /**
+         * This is the thread which signs manifests once they've been
+         * collecting items for the maximum time.
+         */
+        std::thread timer;
+
+        /**
+         * This indicates whether or not the timer thread should stop.
+         */
+        bool stopping = false;
+
+        // Methods
+
+        ~Impl() noexcept {
+            StopTimer();
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            auto manifest = TakeManifest();
+            lock.unlock();
+            (void)SignManifest(manifest);
+        }
+
+        /**
+         * This method stops the timer thread, if it's running.
+         */
+        void StopTimer() {
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                stopping = true;
+                wakeTimer.notify_all();
+            }
+            if (timer.joinable()) {
+                timer.join();
+            }
+        }
+
+        /**
+         * This method takes the manifest being collected, to be signed,
+         * and starts a new one.  The mutex must be held.
+         *
+         * @return
+         *     The manifest taken is returned.
+         */
+        Manifest TakeManifest() {
+            Manifest manifest;
+            manifest.sign = sign;
+            manifest.leaves.swap(leaves);
+            manifest.promises.swap(promises);
+            ++generation;
+            return manifest;
+        }
+
+        /**
+         * This method signs the given manifest and gives the proofs
+         * of its items to the callers which added them.
+         *
+         * @param[in,out] manifest
+         *     This is the manifest to sign.
+         *
+         * @return
+         *     The inclusion proofs of the items in the manifest are
+         *     returned.  If there were no items, or the manifest could
+         *     not be signed, an empty vector is returned.
+         */
+        static std::vector< ManifestProof > SignManifest(Manifest& manifest) {
+            auto proofs = SignLeaves(manifest.sign, manifest.leaves);
+            for (size_t i = 0; i < manifest.promises.size(); ++i) {
+                if (proofs.empty()) {
+                    ManifestProof failed;
+                    failed.index = i;
+                    failed.size = manifest.leaves.size();
+                    manifest.promises[i].set_value(std::move(failed));
+                } else {
+                    manifest.promises[i].set_value(proofs[i]);
+                }
+            }
+            return proofs;
+        }
+
+        /**
+         * This method is the body of the thread which signs manifests
+         * once they've been collecting items for the maximum time.
+         */
+        void TimerThread() {
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            while (!stopping) {
+                if (leaves.empty()) {
+                    wakeTimer.wait(lock);
+                    continue;
+                }
+                const auto waitingOn = generation;
+                if (
+                    wakeTimer.wait_until(
+                        lock,
+                        deadline,
+                        [this, waitingOn]{
+                            return stopping || (generation != waitingOn);
+                        }
+                    )
+                ) {
+                    continue;
+                }
+                auto manifest = TakeManifest();
+                lock.unlock();
+                (void)SignManifest(manifest);
+                lock.lock();
+            }
+        }
+    };
+
+    ManifestSign::~ManifestSign() noexcept = default;
+    ManifestSign::ManifestSign(ManifestSign&&) noexcept = default;
+    ManifestSign& ManifestSign::operator=(ManifestSign&&) noexcept = default;
+
+    ManifestSign::ManifestSign()
+        : impl_(new Impl())
+    {
+    }
+
+    void ManifestSign::Configure(
+        std::shared_ptr< Sign > sign,
+        size_t maxItems,
+        std::chrono::milliseconds maxDelay
+    ) {
+        (void)Flush();
+        impl_->StopTimer();
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->sign = sign;
+        impl_->maxItems = maxItems;
+        impl_->maxDelay = maxDelay;
+        impl_->stopping = false;
+        if (maxDelay > std::chrono::milliseconds::zero()) {
+            impl_->timer = std::thread(&Impl::TimerThread, impl_.get());
+        }
+    }
+
+    std::future< ManifestProof > ManifestSign::Add(
+        const std::vector< uint8_t >& item
+    ) {
+        auto leaf = MerkleTree::LeafHash(item);
+        std::unique_lock< decltype(impl_->mutex) > lock(impl_->mutex);
+        if (impl_->leaves.empty()) {
+            impl_->deadline = (
+                std::chrono::steady_clock::now() + impl_->maxDelay
+            );
+            impl_->wakeTimer.notify_all();
+        }
+        impl_->leaves.push_back(std::move(leaf));
+        impl_->promises.emplace_back();
+        auto proof = impl_->promises.back().get_future();
+        if (
+            (impl_->maxItems > 0)
+            && (impl_->leaves.size() >= impl_->maxItems)
+        ) {
+            auto manifest = impl_->TakeManifest();
+            lock.unlock();
+            (void)Impl::SignManifest(manifest);
+        }
+        return proof;
+    }
+
+    std::vector< ManifestProof > ManifestSign::Flush() {
+        std::unique_lock< decltype(impl_->mutex) > lock(impl_->mutex);
+        auto manifest = impl_->TakeManifest();
+        lock.unlock();
+        return Impl::SignManifest(manifest);
+    }
+
+    std::vector< ManifestProof > ManifestSign::operator()(
+        const std::vector< std::vector< uint8_t > >& items
+    ) {
+        std::vector< std::vector< uint8_t > > leaves;
+        leaves.reserve(items.size());
+        for (const auto& item: items) {
+            leaves.push_back(MerkleTree::LeafHash(item));
+        }
+        std::shared_ptr< Sign > sign;
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            sign = impl_->sign;
+        }
+        return SignLeaves(sign, leaves);
+    }
+
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ManifestVerify.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::ManifestVerify class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "MerkleTree.hpp"
+
+#include <CryptoSigning/ManifestVerify.hpp>
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a ManifestVerify instance.
+     */
+    struct ManifestVerify::Impl {
+        /**
+         * This is the instance used to verify the signature
+         * of each manifest.
+         */
+        std::shared_ptr< Verify > verify;
+
+        /**
+         * This is the signed message of the most recently
+         * verified manifest.
+         */
+        std::vector< uint8_t > lastRootMessage;
+
+        /**
+         * This is the signature of the most recently verified manifest.
+         */
+        std::vector< uint8_t > lastSignature;
+    };
+
+    ManifestVerify::~ManifestVerify() noexcept = default;
+    ManifestVerify::ManifestVerify(ManifestVerify&&) noexcept = default;
+    ManifestVerify& ManifestVerify::operator=(ManifestVerify&&) noexcept = default;
+
+    ManifestVerify::ManifestVerify()
+        : impl_(new Impl())
+    {
+    }
+
+    void ManifestVerify::Configure(std::shared_ptr< Verify > verify) {
+        impl_.reset(new Impl());
+        impl_->verify = verify;
+    }
+
+    bool ManifestVerify::operator()(
+        const std::vector< uint8_t >& item,
+        const ManifestProof& proof
+    ) {
+        if (impl_->verify == nullptr) {
+            return false;
+        }
+        std::vector< uint8_t > root;
+        if (
+            !MerkleTree::RootFromPath(
+                MerkleTree::LeafHash(item),
+                proof.index,
+                proof.size,
+                proof.path,
+                root
+            )
+        ) {
+            return false;
+        }
+        auto rootMessage = MerkleTree::RootMessage(proof.size, root);
+        if (
+            (rootMessage == impl_->lastRootMessage)
+            && (proof.signature == impl_->lastSignature)
+        ) {
+            return true;
+        }
+        if (!(*impl_->verify)(rootMessage, proof.signature)) {
+            return false;
+        }
+        impl_->lastRootMessage = std::move(rootMessage);
+        impl_->lastSignature = proof.signature;
+        return true;
+    }
+
+}
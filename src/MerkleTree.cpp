@@ -0,0 +1,184 @@
+/**
+ * @file MerkleTree.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::MerkleTree functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "MerkleTree.hpp"
+#include "Sha256.hpp"
+
+namespace {
+
+    /**
+     * This is the prefix hashed before an item to form a leaf hash.
+     */
+    constexpr uint8_t LEAF_PREFIX = 0x00;
+
+    /**
+     * This is the context label at the start of the message signed to
+     * commit to a manifest, setting it apart from other signed messages,
+     * such as log and stream checkpoints.
+     */
+    constexpr char ROOT_CONTEXT[] = "CryptoSigning manifest root v1";
+
+    /**
+     * This is the prefix hashed before two child hashes to form
+     * the hash of their parent node.
+     */
+    constexpr uint8_t NODE_PREFIX = 0x01;
+
+    /**
+     * This function computes the hash of the parent node of the
+     * two given child hashes.
+     *
+     * @param[in] left
+     *     This is the hash of the left child.
+     *
+     * @param[in] right
+     *     This is the hash of the right child.
+     *
+     * @return
+     *     The hash of the parent node is returned.
+     */
+    std::vector< uint8_t > NodeHash(
+        const std::vector< uint8_t >& left,
+        const std::vector< uint8_t >& right
+    ) {
+        std::vector< uint8_t > input;
+        input.reserve(1 + left.size() + right.size());
+        input.push_back(NODE_PREFIX);
+        input.insert(input.end(), left.begin(), left.end());
+        input.insert(input.end(), right.begin(), right.end());
+        return CryptoSigning::Sha256(input);
+    }
+
+    /**
+     * This function computes the hash of the subtree over the given
+     * range of leaves, adding to the inclusion proof of each leaf in the
+     * range the hashes of the sibling subtrees it needs.
+     *
+     * @param[in] leaves
+     *     These are the leaf hashes of the whole tree.
+     *
+     * @param[in] begin
+     *     This is the index of the first leaf in the subtree.
+     *
+     * @param[in] end
+     *     This is the index one past the last leaf in the subtree.
+     *
+     * @param[in,out] paths
+     *     These are the inclusion proofs of the leaves.
+     *
+     * @return
+     *     The hash of the subtree is returned.
+     */
+    std::vector< uint8_t > BuildSubtree(
+        const std::vector< std::vector< uint8_t > >& leaves,
+        size_t begin,
+        size_t end,
+        std::vector< std::vector< std::vector< uint8_t > > >& paths
+    ) {
+        if (end - begin == 1) {
+            return leaves[begin];
+        }
+        size_t split = 1;
+        while (split * 2 < end - begin) {
+            split *= 2;
+        }
+        const auto middle = begin + split;
+        const auto left = BuildSubtree(leaves, begin, middle, paths);
+        const auto right = BuildSubtree(leaves, middle, end, paths);
+        for (auto i = begin; i < middle; ++i) {
+            paths[i].push_back(right);
+        }
+        for (auto i = middle; i < end; ++i) {
+            paths[i].push_back(left);
+        }
+        return NodeHash(left, right);
+    }
+
+}
+
+namespace CryptoSigning {
+
+    namespace MerkleTree {
+
+        std::vector< uint8_t > LeafHash(const std::vector< uint8_t >& item) {
+            std::vector< uint8_t > input;
+            input.reserve(1 + item.size());
+            input.push_back(LEAF_PREFIX);
+            input.insert(input.end(), item.begin(), item.end());
+            return Sha256(input);
+        }
+
+        std::vector< uint8_t > Build(
+            const std::vector< std::vector< uint8_t > >& leaves,
+            std::vector< std::vector< std::vector< uint8_t > > >& paths
+        ) {
+            paths.assign(leaves.size(), {});
+            if (leaves.empty()) {
+                return {};
+            }
+            return BuildSubtree(leaves, 0, leaves.size(), paths);
+        }
+
+        bool RootFromPath(
+            const std::vector< uint8_t >& leaf,
+            uint64_t index,
+            uint64_t size,
+            const std::vector< std::vector< uint8_t > >& path,
+            std::vector< uint8_t >& root
+        ) {
+            if (index >= size) {
+                return false;
+            }
+            auto node = index;
+            auto lastNode = size - 1;
+            root = leaf;
+            for (const auto& sibling: path) {
+                if (lastNode == 0) {
+                    return false;
+                }
+                if (
+                    ((node & 1) != 0)
+                    || (node == lastNode)
+                ) {
+                    root = NodeHash(sibling, root);
+                    while (
+                        ((node & 1) == 0)
+                        && (node != 0)
+                    ) {
+                        node >>= 1;
+                        lastNode >>= 1;
+                    }
+                } else {
+                    root = NodeHash(root, sibling);
+                }
+                node >>= 1;
+                lastNode >>= 1;
+            }
+            return (lastNode == 0);
+        }
+
+        std::vector< uint8_t > RootMessage(
+            uint64_t size,
+            const std::vector< uint8_t >& root
+        ) {
+            std::vector< uint8_t > message(
+                ROOT_CONTEXT,
+                ROOT_CONTEXT + sizeof(ROOT_CONTEXT)
+            );
+            message.reserve(sizeof(ROOT_CONTEXT) + 8 + root.size());
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                message.push_back((uint8_t)(size >> shift));
+            }
+            message.insert(message.end(), root.begin(), root.end());
+            return message;
+        }
+
+    }
+
+}
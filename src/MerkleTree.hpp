@@ -0,0 +1,110 @@
+#ifndef CRYPTO_SIGNING_MERKLE_TREE_HPP
+#define CRYPTO_SIGNING_MERKLE_TREE_HPP
+
+/**
+ * @file MerkleTree.hpp
+ *
+ * This module declares the CryptoSigning::MerkleTree functions, which
+ * build and check Merkle trees over SHA-256 digests, using the leaf
+ * and node hashing and inclusion proof rules of RFC 6962.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    namespace MerkleTree {
+
+        /**
+         * This function computes the leaf hash of the given item.
+         *
+         * @param[in] item
+         *     This is the item for which to compute the leaf hash.
+         *
+         * @return
+         *     The leaf hash of the item is returned.
+         */
+        std::vector< uint8_t > LeafHash(const std::vector< uint8_t >& item);
+
+        /**
+         * This function computes the root of the tree over the given
+         * leaf hashes, along with the inclusion proof of every leaf.
+         *
+         * @param[in] leaves
+         *     These are the leaf hashes of the tree.  There must be
+         *     at least one.
+         *
+         * @param[out] paths
+         *     This is where to store the inclusion proof of each leaf,
+         *     ordered from the bottom of the tree to the top.
+         *
+         * @return
+         *     The root of the tree is returned.
+         */
+        std::vector< uint8_t > Build(
+            const std::vector< std::vector< uint8_t > >& leaves,
+            std::vector< std::vector< std::vector< uint8_t > > >& paths
+        );
+
+        /**
+         * This function computes the root of a tree from one of its leaf
+         * hashes and the inclusion proof of that leaf.
+         *
+         * @param[in] leaf
+         *     This is the leaf hash.
+         *
+         * @param[in] index
+         *     This is the position of the leaf in the tree.
+         *
+         * @param[in] size
+         *     This is the number of leaves in the tree.
+         *
+         * @param[in] path
+         *     This is the inclusion proof of the leaf.
+         *
+         * @param[out] root
+         *     This is where to store the root of the tree.
+         *
+         * @return
+         *     An indication of whether or not the inclusion proof is
+         *     well-formed for the given leaf position and tree size
+         *     is returned.
+         */
+        bool RootFromPath(
+            const std::vector< uint8_t >& leaf,
+            uint64_t index,
+            uint64_t size,
+            const std::vector< std::vector< uint8_t > >& path,
+            std::vector< uint8_t >& root
+        );
+
+        /**
+         * This function returns the message to sign in order to commit to
+         * a tree.  It is made up of the context label "CryptoSigning
+         * manifest root v1", including its terminating zero byte, the
+         * number of leaves in the tree, as a 64-bit big-endian integer,
+         * and the root of the tree.
+         *
+         * @param[in] size
+         *     This is the number of leaves in the tree.
+         *
+         * @param[in] root
+         *     This is the root of the tree.
+         *
+         * @return
+         *     The message to sign for the tree is returned.
+         */
+        std::vector< uint8_t > RootMessage(
+            uint64_t size,
+            const std::vector< uint8_t >& root
+        );
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_MERKLE_TREE_HPP */
@@ -0,0 +1,623 @@
+/**
+ * @file OpenSslBackend.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::OpenSslBackend functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "OpenSslBackend.hpp"
+#include "RsaBatchVerifier.hpp"
+#include "RsaBlindedSigner.hpp"
+#include "RsaVerifier.hpp"
+#include "Sha256.hpp"
+
+#include <openssl/bn.h>
+#include <openssl/opensslv.h>
+#include <openssl/rsa.h>
+#include <vector>
+
+#if !defined(LIBRESSL_VERSION_NUMBER) \
+    && (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+#define CRYPTO_SIGNING_OPENSSL_3
+#include <openssl/core_names.h>
+#include <openssl/param_build.h>
+#endif
+
+namespace {
+
+    /**
+     * This is the type of smart pointer used to hold message
+     * digest contexts.
+     */
+    typedef std::unique_ptr<
+        EVP_MD_CTX,
+        std::function< void(EVP_MD_CTX*) >
+    > DigestContext;
+
+    /**
+     * This function makes a new message digest context.
+     *
+     * @return
+     *     The new message digest context is returned.
+     */
+    DigestContext MakeDigestContext() {
+        return DigestContext(
+            EVP_MD_CTX_create(),
+            [](EVP_MD_CTX* p) {
+                EVP_MD_CTX_free(p);
+            }
+        );
+    }
+
+    /**
+     * This is the type of smart pointer used to hold public key
+     * algorithm contexts.
+     */
+    typedef std::unique_ptr<
+        EVP_PKEY_CTX,
+        std::function< void(EVP_PKEY_CTX*) >
+    > KeyContext;
+
+    /**
+     * This function makes a new public key algorithm context
+     * for the given key.
+     *
+     * @param[in] key
+     *     This is the key to be used.
+     *
+     * @return
+     *     The new public key algorithm context is returned.
+     */
+    KeyContext MakeKeyContext(EVP_PKEY* key) {
+        return KeyContext(
+            EVP_PKEY_CTX_new(key, NULL),
+            [](EVP_PKEY_CTX* p) {
+                EVP_PKEY_CTX_free(p);
+            }
+        );
+    }
+
+    /**
+     * This function takes a new reference to the given key.
+     *
+     * @param[in] key
+     *     This is the key to reference.
+     *
+     * @return
+     *     A smart pointer holding the new reference is returned.
+     */
+    CryptoSigning::OpenSslBackend::Key ReferenceKey(EVP_PKEY* key) {
+        (void)EVP_PKEY_up_ref(key);
+        return CryptoSigning::OpenSslBackend::Key(
+            key,
+            [](EVP_PKEY* p){
+                EVP_PKEY_free(p);
+            }
+        );
+    }
+
+    /**
+     * This function returns the message digest to use with the given key,
+     * or NULL for keys, such as Ed25519, which digest messages themselves
+     * and so must be used in one shot.
+     *
+     * @param[in] key
+     *     This is the key to be used.
+     *
+     * @return
+     *     The message digest to use with the key is returned.
+     */
+    const EVP_MD* DigestForKey(EVP_PKEY* key) {
+#ifdef EVP_PKEY_ED25519
+        if (EVP_PKEY_base_id(key) == EVP_PKEY_ED25519) {
+            return NULL;
+        }
+#endif /* EVP_PKEY_ED25519 */
+        return EVP_sha256();
+    }
+
+    /**
+     * This makes cryptographic signatures using libcrypto.
+     */
+    struct OpenSslSigner
+        : public CryptoSigning::Backend::Signer
+    {
+        // Properties
+
+        /**
+         * This is the private key to use.
+         */
+        CryptoSigning::OpenSslBackend::Key key;
+
+        /**
+         * If the blinding factor pool is turned on, and the key is
+         * an RSA key, this is used to make signatures.
+         */
+        std::unique_ptr< CryptoSigning::RsaBlindedSigner > blindedSigner;
+
+        // Methods
+
+        /**
+         * This is the constructor.
+         *
+         * @param[in] key
+         *     This is the private key to use.
+         */
+        explicit OpenSslSigner(EVP_PKEY* key)
+            : key(ReferenceKey(key))
+        {
+        }
+
+        // CryptoSigning::Backend::Signer
+
+        virtual std::vector< uint8_t > Sign(
+            const uint8_t* data,
+            size_t length
+        ) override {
+            if (blindedSigner != nullptr) {
+                auto signature = blindedSigner->SignDigest(
+                    CryptoSigning::Sha256(data, length).data()
+                );
+                if (!signature.empty()) {
+                    return signature;
+                }
+            }
+            const auto ctx = MakeDigestContext();
+            const auto md = DigestForKey(key.get());
+            if (
+                (ctx == nullptr)
+                || (
+                    EVP_DigestSignInit(
+                        ctx.get(),
+                        NULL,
+                        md,
+                        NULL,
+                        key.get()
+                    ) <= 0
+                )
+            ) {
+                return {};
+            }
+            size_t signatureLength;
+            std::vector< uint8_t > signature;
+            if (md == NULL) {
+#ifdef EVP_PKEY_ED25519
+                if (
+                    EVP_DigestSign(
+                        ctx.get(),
+                        NULL,
+                        &signatureLength,
+                        data,
+                        length
+                    ) <= 0
+                ) {
+                    return {};
+                }
+                signature.resize(signatureLength);
+                if (
+                    EVP_DigestSign(
+                        ctx.get(),
+                        signature.data(),
+                        &signatureLength,
+                        data,
+                        length
+                    ) <= 0
+                ) {
+                    return {};
+                }
+#endif /* EVP_PKEY_ED25519 */
+            } else {
+                if (
+                    (
+                        EVP_DigestSignUpdate(
+                            ctx.get(),
+                            data,
+                            length
+                        ) <= 0
+                    )
+                    || (
+                        EVP_DigestSignFinal(
+                            ctx.get(),
+                            NULL,
+                            &signatureLength
+                        ) <= 0
+                    )
+                ) {
+                    return {};
+                }
+                signature.resize(signatureLength);
+                if (
+                    EVP_DigestSignFinal(
+                        ctx.get(),
+                        signature.data(),
+                        &signatureLength
+                    ) <= 0
+                ) {
+                    return {};
+                }
+            }
+            signature.resize(signatureLength);
+            return signature;
+        }
+
+        virtual bool SupportsDigests() const override {
+            return (DigestForKey(key.get()) != NULL);
+        }
+
+        virtual std::vector< uint8_t > SignDigest(
+            const uint8_t* digest
+        ) override {
+            if (!SupportsDigests()) {
+                return {};
+            }
+            if (blindedSigner != nullptr) {
+                auto signature = blindedSigner->SignDigest(digest);
+                if (!signature.empty()) {
+                    return signature;
+                }
+            }
+            const auto ctx = MakeKeyContext(key.get());
+            size_t signatureLength;
+            if (
+                (ctx == nullptr)
+                || (EVP_PKEY_sign_init(ctx.get()) <= 0)
+                || (
+                    EVP_PKEY_CTX_set_signature_md(
+                        ctx.get(),
+                        EVP_sha256()
+                    ) <= 0
+                )
+                || (
+                    EVP_PKEY_sign(
+                        ctx.get(),
+                        NULL,
+                        &signatureLength,
+                        digest,
+                        CryptoSigning::SHA256_DIGEST_SIZE
+                    ) <= 0
+                )
+            ) {
+                return {};
+            }
+            std::vector< uint8_t > signature(signatureLength);
+            if (
+                EVP_PKEY_sign(
+                    ctx.get(),
+                    signature.data(),
+                    &signatureLength,
+                    digest,
+                    CryptoSigning::SHA256_DIGEST_SIZE
+                ) <= 0
+            ) {
+                return {};
+            }
+            signature.resize(signatureLength);
+            return signature;
+        }
+
+        virtual bool SetBlindingPoolSize(size_t poolSize) override {
+            blindedSigner.reset();
+            if (poolSize == 0) {
+                return true;
+            }
+            blindedSigner = CryptoSigning::RsaBlindedSigner::Create(
+                key.get(),
+                poolSize
+            );
+            return (blindedSigner != nullptr);
+        }
+    };
+
+    /**
+     * This verifies cryptographic signatures using libcrypto.
+     */
+    struct OpenSslVerifier
+        : public CryptoSigning::Backend::Verifier
+    {
+        // Properties
+
+        /**
+         * This is the public or private key to use.
+         */
+        CryptoSigning::OpenSslBackend::Key key;
+
+        /**
+         * If the key is an RSA key with a public exponent of 65537, and
+         * the processor supports AVX-512 IFMA, this is used to verify
+         * batches of signatures eight at a time.
+         */
+        std::unique_ptr< CryptoSigning::RsaBatchVerifier > batchVerifier;
+
+        /**
+         * If the key is an RSA key with a public exponent of 65537,
+         * this is used to verify signatures one at a time, instead of
+         * going through the generic libcrypto interface.
+         */
+        std::unique_ptr< CryptoSigning::RsaVerifier > rsaVerifier;
+
+        // Methods
+
+        /**
+         * This is the constructor.
+         *
+         * @param[in] key
+         *     This is the public or private key to use.
+         */
+        explicit OpenSslVerifier(EVP_PKEY* key)
+            : key(ReferenceKey(key))
+            , batchVerifier(CryptoSigning::RsaBatchVerifier::Create(key))
+            , rsaVerifier(CryptoSigning::RsaVerifier::Create(key))
+        {
+        }
+
+        // CryptoSigning::Backend::Verifier
+
+        virtual bool Verify(
+            const uint8_t* data,
+            size_t dataLength,
+            const uint8_t* signature,
+            size_t signatureLength
+        ) override {
+            if (rsaVerifier != nullptr) {
+                return rsaVerifier->VerifyDigest(
+                    CryptoSigning::Sha256(data, dataLength).data(),
+                    signature,
+                    signatureLength
+                );
+            }
+            const auto ctx = MakeDigestContext();
+            const auto md = DigestForKey(key.get());
+            if (
+                (ctx == nullptr)
+                || (
+                    EVP_DigestVerifyInit(
+                        ctx.get(),
+                        NULL,
+                        md,
+                        NULL,
+                        key.get()
+                    ) <= 0
+                )
+            ) {
+                return false;
+            }
+            if (md == NULL) {
+#ifdef EVP_PKEY_ED25519
+                return (
+                    EVP_DigestVerify(
+                        ctx.get(),
+                        signature,
+                        signatureLength,
+                        data,
+                        dataLength
+                    ) == 1
+                );
+#else /* EVP_PKEY_ED25519 */
+                return false;
+#endif /* EVP_PKEY_ED25519 */
+            }
+            return (
+                (
+                    EVP_DigestVerifyUpdate(
+                        ctx.get(),
+                        data,
+                        dataLength
+                    ) > 0
+                )
+                && (
+                    EVP_DigestVerifyFinal(
+                        ctx.get(),
+                        signature,
+                        signatureLength
+                    ) == 1
+                )
+            );
+        }
+
+        virtual bool SupportsDigests() const override {
+            return (DigestForKey(key.get()) != NULL);
+        }
+
+        virtual bool VerifyDigest(
+            const uint8_t* digest,
+            const uint8_t* signature,
+            size_t signatureLength
+        ) override {
+            if (!SupportsDigests()) {
+                return false;
+            }
+            if (rsaVerifier != nullptr) {
+                return rsaVerifier->VerifyDigest(
+                    digest,
+                    signature,
+                    signatureLength
+                );
+            }
+            const auto ctx = MakeKeyContext(key.get());
+            return (
+                (ctx != nullptr)
+                && (EVP_PKEY_verify_init(ctx.get()) > 0)
+                && (
+                    EVP_PKEY_CTX_set_signature_md(
+                        ctx.get(),
+                        EVP_sha256()
+                    ) > 0
+                )
+                && (
+                    EVP_PKEY_verify(
+                        ctx.get(),
+                        signature,
+                        signatureLength,
+                        digest,
+                        CryptoSigning::SHA256_DIGEST_SIZE
+                    ) == 1
+                )
+            );
+        }
+
+        virtual std::vector< bool > VerifyBatch(
+            const std::vector< std::vector< uint8_t > >& dataChunks,
+            const std::vector< std::vector< uint8_t > >& signatures
+        ) override {
+            if (batchVerifier == nullptr) {
+                return Verifier::VerifyBatch(dataChunks, signatures);
+            }
+            std::vector< std::vector< uint8_t > > digests;
+            std::vector< CryptoSigning::RsaBatchVerifier::Item > items(
+                dataChunks.size()
+            );
+            digests.reserve(dataChunks.size());
+            for (size_t i = 0; i < dataChunks.size(); ++i) {
+                digests.push_back(CryptoSigning::Sha256(dataChunks[i]));
+                items[i].digest = digests.back().data();
+                if (i < signatures.size()) {
+                    items[i].signature = signatures[i].data();
+                    items[i].signatureLength = signatures[i].size();
+                }
+            }
+            return batchVerifier->VerifyDigests(items);
+        }
+    };
+
+}
+
+namespace CryptoSigning {
+
+    namespace OpenSslBackend {
+
+#ifdef LIBRESSL_VERSION_NUMBER
+        const char* const NAME = "LibreSSL";
+#else /* LIBRESSL_VERSION_NUMBER */
+        const char* const NAME = "OpenSSL";
+#endif /* LIBRESSL_VERSION_NUMBER */
+
+        std::unique_ptr< Backend::Signer > MakeSigner(EVP_PKEY* key) {
+            return std::unique_ptr< Backend::Signer >(new OpenSslSigner(key));
+        }
+
+        std::unique_ptr< Backend::Verifier > MakeVerifier(EVP_PKEY* key) {
+            return std::unique_ptr< Backend::Verifier >(
+                new OpenSslVerifier(key)
+            );
+        }
+
+        Key MakeRsaPublicKey(
+            const uint8_t* modulus,
+            size_t modulusLength,
+            const uint8_t* exponent,
+            size_t exponentLength
+        ) {
+            Key key(
+                nullptr,
+                [](EVP_PKEY* p){
+                    EVP_PKEY_free(p);
+                }
+            );
+            std::unique_ptr< BIGNUM, std::function< void(BIGNUM*) > > n(
+                BN_bin2bn(modulus, (int)modulusLength, NULL),
+                [](BIGNUM* p){
+                    BN_free(p);
+                }
+            );
+            std::unique_ptr< BIGNUM, std::function< void(BIGNUM*) > > e(
+                BN_bin2bn(exponent, (int)exponentLength, NULL),
+                [](BIGNUM* p){
+                    BN_free(p);
+                }
+            );
+            if (
+                (n == nullptr)
+                || (e == nullptr)
+            ) {
+                return key;
+            }
+#ifdef CRYPTO_SIGNING_OPENSSL_3
+            std::unique_ptr<
+                OSSL_PARAM_BLD,
+                std::function< void(OSSL_PARAM_BLD*) >
+            > builder(
+                OSSL_PARAM_BLD_new(),
+                [](OSSL_PARAM_BLD* p){
+                    OSSL_PARAM_BLD_free(p);
+                }
+            );
+            if (
+                (builder == nullptr)
+                || (
+                    OSSL_PARAM_BLD_push_BN(
+                        builder.get(),
+                        OSSL_PKEY_PARAM_RSA_N,
+                        n.get()
+                    ) != 1
+                )
+                || (
+                    OSSL_PARAM_BLD_push_BN(
+                        builder.get(),
+                        OSSL_PKEY_PARAM_RSA_E,
+                        e.get()
+                    ) != 1
+                )
+            ) {
+                return key;
+            }
+            std::unique_ptr< OSSL_PARAM, std::function< void(OSSL_PARAM*) > > params(
+                OSSL_PARAM_BLD_to_param(builder.get()),
+                [](OSSL_PARAM* p){
+                    OSSL_PARAM_free(p);
+                }
+            );
+            std::unique_ptr< EVP_PKEY_CTX, std::function< void(EVP_PKEY_CTX*) > > ctx(
+                EVP_PKEY_CTX_new_from_name(NULL, "RSA", NULL),
+                [](EVP_PKEY_CTX* p){
+                    EVP_PKEY_CTX_free(p);
+                }
+            );
+            EVP_PKEY* rawKey = NULL;
+            if (
+                (params != nullptr)
+                && (ctx != nullptr)
+                && (EVP_PKEY_fromdata_init(ctx.get()) == 1)
+                && (
+                    EVP_PKEY_fromdata(
+                        ctx.get(),
+                        &rawKey,
+                        EVP_PKEY_PUBLIC_KEY,
+                        params.get()
+                    ) == 1
+                )
+            ) {
+                key.reset(rawKey);
+            }
+#else /* CRYPTO_SIGNING_OPENSSL_3 */
+            std::unique_ptr< RSA, std::function< void(RSA*) > > rsa(
+                RSA_new(),
+                [](RSA* p){
+                    RSA_free(p);
+                }
+            );
+            if (
+                (rsa == nullptr)
+                || (RSA_set0_key(rsa.get(), n.get(), e.get(), NULL) != 1)
+            ) {
+                return key;
+            }
+            (void)n.release();
+            (void)e.release();
+            key.reset(EVP_PKEY_new());
+            if (
+                (key == nullptr)
+                || (EVP_PKEY_assign_RSA(key.get(), rsa.get()) != 1)
+            ) {
+                key.reset();
+                return key;
+            }
+            (void)rsa.release();
+#endif /* CRYPTO_SIGNING_OPENSSL_3 */
+            return key;
+        }
+
+    }
+
+}
@@ -0,0 +1,92 @@
+#ifndef CRYPTO_SIGNING_OPENSSL_BACKEND_HPP
+#define CRYPTO_SIGNING_OPENSSL_BACKEND_HPP
+
+/**
+ * @file OpenSslBackend.hpp
+ *
+ * This module declares the CryptoSigning::OpenSslBackend functions,
+ * which carry out cryptographic operations using libcrypto, whether it
+ * comes from OpenSSL or LibreSSL.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Backend.hpp"
+
+#include <functional>
+#include <memory>
+#include <openssl/evp.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CryptoSigning {
+
+    namespace OpenSslBackend {
+
+        /**
+         * This is the name of the backend.
+         */
+        extern const char* const NAME;
+
+        /**
+         * This is the type of smart pointer used to hold keys.
+         */
+        typedef std::unique_ptr<
+            EVP_PKEY,
+            std::function< void(EVP_PKEY*) >
+        > Key;
+
+        /**
+         * This function makes a signer for the given private key.
+         *
+         * @param[in] key
+         *     This is the private key to use.
+         *
+         * @return
+         *     The signer is returned, or nullptr if the key
+         *     isn't supported.
+         */
+        std::unique_ptr< Backend::Signer > MakeSigner(EVP_PKEY* key);
+
+        /**
+         * This function makes a verifier for the given key.
+         *
+         * @param[in] key
+         *     This is the public or private key to use.
+         *
+         * @return
+         *     The verifier is returned, or nullptr if the key
+         *     isn't supported.
+         */
+        std::unique_ptr< Backend::Verifier > MakeVerifier(EVP_PKEY* key);
+
+        /**
+         * This function makes an RSA public key from its parameters.
+         *
+         * @param[in] modulus
+         *     This points to the big-endian modulus of the key.
+         *
+         * @param[in] modulusLength
+         *     This is the length, in bytes, of the modulus.
+         *
+         * @param[in] exponent
+         *     This points to the big-endian public exponent of the key.
+         *
+         * @param[in] exponentLength
+         *     This is the length, in bytes, of the public exponent.
+         *
+         * @return
+         *     The key is returned, or nullptr if it could not be made.
+         */
+        Key MakeRsaPublicKey(
+            const uint8_t* modulus,
+            size_t modulusLength,
+            const uint8_t* exponent,
+            size_t exponentLength
+        );
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_OPENSSL_BACKEND_HPP */
@@ -0,0 +1,48 @@
+/**
+ * @file Parallel.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::RunInParallel function.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace CryptoSigning {
+
+    void RunInParallel(
+        size_t count,
+        size_t workers,
+        std::function< void(size_t index) > job
+    ) {
+        if (workers == 0) {
+            workers = (size_t)std::thread::hardware_concurrency();
+        }
+        workers = std::max(std::min(workers, count), (size_t)1);
+        std::atomic< size_t > nextIndex(0);
+        const auto worker = [&]{
+            for (;;) {
+                const auto index = nextIndex++;
+                if (index >= count) {
+                    break;
+                }
+                job(index);
+            }
+        };
+        std::vector< std::thread > threads;
+        for (size_t i = 1; i < workers; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread: threads) {
+            thread.join();
+        }
+    }
+
+}
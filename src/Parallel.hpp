@@ -0,0 +1,40 @@
+#ifndef CRYPTO_SIGNING_PARALLEL_HPP
+#define CRYPTO_SIGNING_PARALLEL_HPP
+
+/**
+ * @file Parallel.hpp
+ *
+ * This module declares the CryptoSigning::RunInParallel function.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <functional>
+#include <stddef.h>
+
+namespace CryptoSigning {
+
+    /**
+     * This function runs the given job once for each index in the range
+     * [0, count), spreading the work across a pool of worker threads.
+     * The calling thread is one of the workers.
+     *
+     * @param[in] count
+     *     This is the number of jobs to run.
+     *
+     * @param[in] workers
+     *     This is the maximum number of worker threads to use.  If zero,
+     *     the number of hardware threads available is used.
+     *
+     * @param[in] job
+     *     This is the function to call for each index.
+     */
+    void RunInParallel(
+        size_t count,
+        size_t workers,
+        std::function< void(size_t index) > job
+    );
+
+}
+
+#endif /* CRYPTO_SIGNING_PARALLEL_HPP */
@@ -0,0 +1,68 @@
+/**
+ * @file Pkcs1.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::Pkcs1 functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Pkcs1.hpp"
+#include "Sha256.hpp"
+
+#include <string.h>
+
+namespace {
+
+    /**
+     * This is the DER encoding of the DigestInfo structure for SHA-256,
+     * up to (but not including) the digest itself.
+     */
+    constexpr uint8_t SHA256_DIGEST_INFO_PREFIX[] = {
+        0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86,
+        0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x05,
+        0x00, 0x04, 0x20,
+    };
+
+    /**
+     * This is the smallest number of padding bytes allowed by the encoding.
+     */
+    constexpr size_t MIN_PADDING = 8;
+
+}
+
+namespace CryptoSigning {
+
+    namespace Pkcs1 {
+
+        std::vector< uint8_t > EncodeSha256(
+            const uint8_t* digest,
+            size_t length
+        ) {
+            const auto tLength = (
+                sizeof(SHA256_DIGEST_INFO_PREFIX) + SHA256_DIGEST_SIZE
+            );
+            if (length < tLength + MIN_PADDING + 3) {
+                return {};
+            }
+            std::vector< uint8_t > encoded(length, 0xff);
+            encoded[0] = 0x00;
+            encoded[1] = 0x01;
+            const auto t = encoded.data() + length - tLength;
+            t[-1] = 0x00;
+            (void)memcpy(
+                t,
+                SHA256_DIGEST_INFO_PREFIX,
+                sizeof(SHA256_DIGEST_INFO_PREFIX)
+            );
+            (void)memcpy(
+                t + sizeof(SHA256_DIGEST_INFO_PREFIX),
+                digest,
+                SHA256_DIGEST_SIZE
+            );
+            return encoded;
+        }
+
+    }
+
+}
@@ -0,0 +1,46 @@
+#ifndef CRYPTO_SIGNING_PKCS1_HPP
+#define CRYPTO_SIGNING_PKCS1_HPP
+
+/**
+ * @file Pkcs1.hpp
+ *
+ * This module declares the CryptoSigning::Pkcs1 functions, which
+ * implement the EMSA-PKCS1-v1_5 encoding used in RSA signatures
+ * (RFC 8017 section 9.2) with SHA-256.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    namespace Pkcs1 {
+
+        /**
+         * This function encodes the given SHA-256 digest into a message
+         * representative of the given length, ready for the RSA private-key
+         * operation.
+         *
+         * @param[in] digest
+         *     This points to the SHA-256 digest to encode.
+         *
+         * @param[in] length
+         *     This is the length, in bytes, of the RSA modulus.
+         *
+         * @return
+         *     The encoded message is returned, or an empty vector if the
+         *     modulus is too small to hold the encoding.
+         */
+        std::vector< uint8_t > EncodeSha256(
+            const uint8_t* digest,
+            size_t length
+        );
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_PKCS1_HPP */
@@ -0,0 +1,446 @@
+/**
+ * @file RsaBatchVerifier.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::RsaBatchVerifier class.
+ *
+ * Numbers are held in radix 2^52, as "limbs" of 52 bits each, least
+ * significant first.  The eight signatures of a batch are interleaved, so
+ * that each AVX-512 register holds the same limb of eight different
+ * numbers, and each instruction works on all eight at once.  Modular
+ * multiplication uses the "almost Montgomery multiplication" of the
+ * OpenSSL rsaz code, which leaves results less than twice the modulus
+ * rather than fully reduced; this is harmless while R = 2^(52 * limbs)
+ * exceeds four times the modulus, and the final conversion out of
+ * Montgomery form brings the result into range.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "BignumUtil.hpp"
+#include "Pkcs1.hpp"
+#include "RsaBatchVerifier.hpp"
+
+#include <algorithm>
+#include <openssl/bn.h>
+#include <string.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRYPTO_SIGNING_IFMA
+#include <immintrin.h>
+#define IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+#endif
+
+namespace {
+
+    /**
+     * This is the number of signatures verified at once.
+     */
+    constexpr size_t LANES = 8;
+
+    /**
+     * This is the number of bits in each limb.
+     */
+    constexpr size_t LIMB_BITS = 52;
+
+    /**
+     * This is used to select the bits of a limb.
+     */
+    constexpr uint64_t LIMB_MASK = (UINT64_C(1) << LIMB_BITS) - 1;
+
+    /**
+     * This is the largest number of limbs supported, which is enough
+     * for a 4096-bit modulus.
+     */
+    constexpr size_t MAX_LIMBS = 79;
+
+    /**
+     * This is the only public exponent supported.
+     */
+    constexpr unsigned long SUPPORTED_EXPONENT = 65537;
+
+    /**
+     * This function converts the given big-endian number into limbs.
+     *
+     * @param[in] bytes
+     *     This points to the big-endian number.
+     *
+     * @param[in] length
+     *     This is the length, in bytes, of the number.
+     *
+     * @param[out] limbs
+     *     This is where to store the limbs.
+     *
+     * @param[in] numLimbs
+     *     This is the number of limbs to store.
+     *
+     * @return
+     *     An indication of whether or not the number fit in the limbs
+     *     is returned.  If not, the bits which didn't fit are left out.
+     */
+    bool ToLimbs(
+        const uint8_t* bytes,
+        size_t length,
+        uint64_t* limbs,
+        size_t numLimbs
+    ) {
+        (void)memset(limbs, 0, numLimbs * sizeof(*limbs));
+        const auto totalBits = numLimbs * LIMB_BITS;
+        bool fits = true;
+        for (size_t i = 0; i < length; ++i) {
+            const auto bit = i * 8;
+            const auto byte = (uint64_t)bytes[length - 1 - i];
+            if (bit + 8 > totalBits) {
+                const auto keptBits = (bit < totalBits) ? (totalBits - bit) : 0;
+                if ((byte >> keptBits) != 0) {
+                    fits = false;
+                }
+                if (keptBits == 0) {
+                    continue;
+                }
+            }
+            const auto limb = bit / LIMB_BITS;
+            const auto shift = bit % LIMB_BITS;
+            limbs[limb] |= (byte << shift) & LIMB_MASK;
+            if (
+                (shift > LIMB_BITS - 8)
+                && (limb + 1 < numLimbs)
+            ) {
+                limbs[limb + 1] |= byte >> (LIMB_BITS - shift);
+            }
+        }
+        return fits;
+    }
+
+    /**
+     * This function compares two numbers held as limbs.
+     *
+     * @param[in] a
+     *     This points to the limbs of the first number.
+     *
+     * @param[in] b
+     *     This points to the limbs of the second number.
+     *
+     * @param[in] numLimbs
+     *     This is the number of limbs in each number.
+     *
+     * @return
+     *     An indication of whether or not the first number is less than
+     *     the second is returned.
+     */
+    bool LessThan(
+        const uint64_t* a,
+        const uint64_t* b,
+        size_t numLimbs
+    ) {
+        for (size_t i = numLimbs; i > 0; --i) {
+            if (a[i - 1] != b[i - 1]) {
+                return (a[i - 1] < b[i - 1]);
+            }
+        }
+        return false;
+    }
+
+#ifdef CRYPTO_SIGNING_IFMA
+    /**
+     * This function computes a * b / R mod n, for eight pairs of numbers
+     * at once, where R = 2^(52 * numLimbs).  The result is less than
+     * twice the modulus, and its limbs are normalized to 52 bits.
+     *
+     * @param[out] result
+     *     This is where to store the results.
+     *
+     * @param[in] a
+     *     These are the first factors, with normalized limbs,
+     *     each less than twice the modulus.
+     *
+     * @param[in] b
+     *     These are the second factors, with normalized limbs,
+     *     each less than twice the modulus.
+     *
+     * @param[in] modulus
+     *     These are the limbs of the modulus.
+     *
+     * @param[in] k0
+     *     This is -1/n mod 2^52.
+     *
+     * @param[in] numLimbs
+     *     This is the number of limbs in each number.
+     */
+    IFMA_TARGET void AlmostMontgomeryMultiply(
+        __m512i* result,
+        const __m512i* a,
+        const __m512i* b,
+        const uint64_t* modulus,
+        uint64_t k0,
+        size_t numLimbs
+    ) {
+        __m512i t[2 * MAX_LIMBS + 1];
+        const auto zero = _mm512_setzero_si512();
+        for (size_t i = 0; i < 2 * numLimbs + 1; ++i) {
+            t[i] = zero;
+        }
+        const auto k0s = _mm512_set1_epi64((long long)k0);
+        for (size_t i = 0; i < numLimbs; ++i) {
+            const auto ai = a[i];
+            const auto window = t + i;
+            const auto m = _mm512_madd52lo_epu64(
+                zero,
+                _mm512_madd52lo_epu64(window[0], ai, b[0]),
+                k0s
+            );
+            for (size_t j = 0; j < numLimbs; ++j) {
+                const auto nj = _mm512_set1_epi64((long long)modulus[j]);
+                window[j] = _mm512_madd52lo_epu64(
+                    _mm512_madd52lo_epu64(window[j], ai, b[j]),
+                    m,
+                    nj
+                );
+                window[j + 1] = _mm512_madd52hi_epu64(
+                    _mm512_madd52hi_epu64(window[j + 1], ai, b[j]),
+                    m,
+                    nj
+                );
+            }
+            window[1] = _mm512_add_epi64(
+                window[1],
+                _mm512_srli_epi64(window[0], LIMB_BITS)
+            );
+        }
+        const auto mask = _mm512_set1_epi64((long long)LIMB_MASK);
+        auto carry = zero;
+        for (size_t j = 0; j < numLimbs; ++j) {
+            const auto value = _mm512_add_epi64(t[numLimbs + j], carry);
+            result[j] = _mm512_and_si512(value, mask);
+            carry = _mm512_srli_epi64(value, LIMB_BITS);
+        }
+    }
+
+    /**
+     * This function computes s^65537 mod n for eight numbers at once.
+     *
+     * @param[in,out] lanes
+     *     On input, this holds the interleaved limbs of the eight bases.
+     *     On output, it holds the interleaved limbs of the results.
+     *     These are fully reduced, except that a result of zero may
+     *     come out as the modulus instead.
+     *
+     * @param[in] modulus
+     *     These are the limbs of the modulus.
+     *
+     * @param[in] rr
+     *     These are the limbs of R^2 mod n.
+     *
+     * @param[in] k0
+     *     This is -1/n mod 2^52.
+     *
+     * @param[in] numLimbs
+     *     This is the number of limbs in each number.
+     */
+    IFMA_TARGET void ModExp65537(
+        uint64_t (*lanes)[LANES],
+        const uint64_t* modulus,
+        const uint64_t* rr,
+        uint64_t k0,
+        size_t numLimbs
+    ) {
+        __m512i base[MAX_LIMBS];
+        __m512i x[MAX_LIMBS];
+        __m512i y[MAX_LIMBS];
+        for (size_t j = 0; j < numLimbs; ++j) {
+            x[j] = _mm512_loadu_si512(lanes[j]);
+            y[j] = _mm512_set1_epi64((long long)rr[j]);
+        }
+        AlmostMontgomeryMultiply(base, x, y, modulus, k0, numLimbs);
+        AlmostMontgomeryMultiply(x, base, base, modulus, k0, numLimbs);
+        for (int i = 1; i < 16; ++i) {
+            AlmostMontgomeryMultiply(y, x, x, modulus, k0, numLimbs);
+            for (size_t j = 0; j < numLimbs; ++j) {
+                x[j] = y[j];
+            }
+        }
+        AlmostMontgomeryMultiply(y, x, base, modulus, k0, numLimbs);
+        for (size_t j = 0; j < numLimbs; ++j) {
+            x[j] = _mm512_setzero_si512();
+        }
+        x[0] = _mm512_set1_epi64(1);
+        AlmostMontgomeryMultiply(base, y, x, modulus, k0, numLimbs);
+        for (size_t j = 0; j < numLimbs; ++j) {
+            _mm512_storeu_si512(lanes[j], base[j]);
+        }
+    }
+#endif /* CRYPTO_SIGNING_IFMA */
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a RsaBatchVerifier instance.
+     */
+    struct RsaBatchVerifier::Impl {
+        /**
+         * This is the length, in bytes, of the modulus.
+         */
+        size_t length = 0;
+
+        /**
+         * This is the number of limbs in each number.
+         */
+        size_t numLimbs = 0;
+
+        /**
+         * These are the limbs of the modulus.
+         */
+        uint64_t modulus[MAX_LIMBS];
+
+        /**
+         * These are the limbs of R^2 mod n, used to convert numbers
+         * into Montgomery form.
+         */
+        uint64_t rr[MAX_LIMBS];
+
+        /**
+         * This is -1/n mod 2^52.
+         */
+        uint64_t k0 = 0;
+    };
+
+    RsaBatchVerifier::~RsaBatchVerifier() noexcept = default;
+
+    RsaBatchVerifier::RsaBatchVerifier()
+        : impl_(new Impl())
+    {
+    }
+
+    bool RsaBatchVerifier::IsSupportedByCpu() {
+#ifdef CRYPTO_SIGNING_IFMA
+        static const bool supported = (
+            __builtin_cpu_supports("avx512f")
+            && __builtin_cpu_supports("avx512ifma")
+        );
+        return supported;
+#else /* CRYPTO_SIGNING_IFMA */
+        return false;
+#endif /* CRYPTO_SIGNING_IFMA */
+    }
+
+    std::unique_ptr< RsaBatchVerifier > RsaBatchVerifier::Create(EVP_PKEY* key) {
+        if (!IsSupportedByCpu()) {
+            return nullptr;
+        }
+        Bignum n;
+        Bignum e;
+        if (
+            !GetRsaPublicParameters(key, n, e)
+            || (BN_get_word(e.get()) != SUPPORTED_EXPONENT)
+            || !BN_is_odd(n.get())
+        ) {
+            return nullptr;
+        }
+        const auto bits = (size_t)BN_num_bits(n.get());
+        const auto numLimbs = (bits + 2 + LIMB_BITS - 1) / LIMB_BITS;
+        if (numLimbs > MAX_LIMBS) {
+            return nullptr;
+        }
+        std::unique_ptr< RsaBatchVerifier > verifier(new RsaBatchVerifier());
+        auto& impl = *verifier->impl_;
+        impl.length = (size_t)BN_num_bytes(n.get());
+        impl.numLimbs = numLimbs;
+        std::vector< uint8_t > buffer(impl.length);
+        (void)BN_bn2binpad(n.get(), buffer.data(), (int)buffer.size());
+        (void)ToLimbs(buffer.data(), buffer.size(), impl.modulus, numLimbs);
+        const auto ctx = MakeBignumContext();
+        const auto rr = MakeBignum();
+        if (
+            (ctx == nullptr)
+            || (rr == nullptr)
+            || (BN_set_bit(rr.get(), (int)(2 * LIMB_BITS * numLimbs)) != 1)
+            || (BN_mod(rr.get(), rr.get(), n.get(), ctx.get()) != 1)
+            || (BN_bn2binpad(rr.get(), buffer.data(), (int)buffer.size()) < 0)
+        ) {
+            return nullptr;
+        }
+        (void)ToLimbs(buffer.data(), buffer.size(), impl.rr, numLimbs);
+        uint64_t inverse = 1;
+        for (int i = 0; i < 6; ++i) {
+            inverse *= 2 - impl.modulus[0] * inverse;
+        }
+        impl.k0 = (0 - inverse) & LIMB_MASK;
+        return verifier;
+    }
+
+    std::vector< bool > RsaBatchVerifier::VerifyDigests(
+        const std::vector< Item >& items
+    ) {
+        std::vector< bool > results(items.size(), false);
+#ifdef CRYPTO_SIGNING_IFMA
+        const auto numLimbs = impl_->numLimbs;
+        uint64_t lanes[MAX_LIMBS][LANES];
+        uint64_t limbs[MAX_LIMBS];
+        for (size_t first = 0; first < items.size(); first += LANES) {
+            const auto count = std::min(LANES, items.size() - first);
+            bool usable[LANES] = {false};
+            bool anyUsable = false;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                (void)memset(limbs, 0, sizeof(limbs));
+                if (lane < count) {
+                    const auto& item = items[first + lane];
+                    if (item.signatureLength == impl_->length) {
+                        usable[lane] = (
+                            ToLimbs(
+                                item.signature,
+                                item.signatureLength,
+                                limbs,
+                                numLimbs
+                            )
+                            && LessThan(
+                                limbs,
+                                impl_->modulus,
+                                numLimbs
+                            )
+                        );
+                        anyUsable = anyUsable || usable[lane];
+                    }
+                    if (!usable[lane]) {
+                        (void)memset(limbs, 0, sizeof(limbs));
+                    }
+                }
+                for (size_t j = 0; j < numLimbs; ++j) {
+                    lanes[j][lane] = limbs[j];
+                }
+            }
+            if (!anyUsable) {
+                continue;
+            }
+            ModExp65537(
+                lanes,
+                impl_->modulus,
+                impl_->rr,
+                impl_->k0,
+                numLimbs
+            );
+            for (size_t lane = 0; lane < count; ++lane) {
+                if (!usable[lane]) {
+                    continue;
+                }
+                const auto encoded = Pkcs1::EncodeSha256(
+                    items[first + lane].digest,
+                    impl_->length
+                );
+                if (encoded.empty()) {
+                    continue;
+                }
+                (void)ToLimbs(encoded.data(), encoded.size(), limbs, numLimbs);
+                bool match = true;
+                for (size_t j = 0; j < numLimbs; ++j) {
+                    match = match && (lanes[j][lane] == limbs[j]);
+                }
+                results[first + lane] = match;
+            }
+        }
+#endif /* CRYPTO_SIGNING_IFMA */
+        return results;
+    }
+
+}
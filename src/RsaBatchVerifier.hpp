@@ -0,0 +1,122 @@
+#ifndef CRYPTO_SIGNING_RSA_BATCH_VERIFIER_HPP
+#define CRYPTO_SIGNING_RSA_BATCH_VERIFIER_HPP
+
+/**
+ * @file RsaBatchVerifier.hpp
+ *
+ * This module declares the CryptoSigning::RsaBatchVerifier class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <memory>
+#include <openssl/evp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class verifies batches of RSA PKCS#1 v1.5 SHA-256 signatures
+     * made with the same key, whose public exponent is 65537.  It runs
+     * eight public-key operations at once, one in each 64-bit lane of the
+     * AVX-512 registers, using the 52-bit multiply-add instructions of the
+     * AVX-512 IFMA extension.  It is only available on processors which
+     * support that extension.
+     */
+    class RsaBatchVerifier {
+        // Types
+    public:
+        /**
+         * This holds one signature to be verified.
+         */
+        struct Item {
+            /**
+             * This points to the SHA-256 digest of the signed data.
+             */
+            const uint8_t* digest = nullptr;
+
+            /**
+             * This points to the signature.
+             */
+            const uint8_t* signature = nullptr;
+
+            /**
+             * This is the length, in bytes, of the signature.
+             */
+            size_t signatureLength = 0;
+        };
+
+        // Lifecycle management
+    public:
+        ~RsaBatchVerifier() noexcept;
+        RsaBatchVerifier(const RsaBatchVerifier&) = delete;
+        RsaBatchVerifier(RsaBatchVerifier&&) = delete;
+        RsaBatchVerifier& operator=(const RsaBatchVerifier&) = delete;
+        RsaBatchVerifier& operator=(RsaBatchVerifier&&) = delete;
+
+        // Public Methods
+    public:
+        /**
+         * This function returns whether or not the processor on which
+         * the program is running supports the instructions used by
+         * this class.
+         *
+         * @return
+         *     An indication of whether or not the processor supports
+         *     AVX-512 IFMA is returned.
+         */
+        static bool IsSupportedByCpu();
+
+        /**
+         * This function makes a verifier for the given key, if the key is
+         * an RSA key of at most 4096 bits with a public exponent of 65537,
+         * and the processor supports AVX-512 IFMA.
+         *
+         * @param[in] key
+         *     This is the public or private key to use.
+         *
+         * @return
+         *     The new verifier is returned, or nullptr if the key or
+         *     processor isn't supported.
+         */
+        static std::unique_ptr< RsaBatchVerifier > Create(EVP_PKEY* key);
+
+        /**
+         * This method verifies the given signatures.
+         *
+         * @param[in] items
+         *     These are the signatures to verify.
+         *
+         * @return
+         *     For each signature, an indication of whether or not it
+         *     is valid is returned, in the same order as the signatures.
+         */
+        std::vector< bool > VerifyDigests(const std::vector< Item >& items);
+
+        // Private Methods
+    private:
+        /**
+         * This is the constructor used by Create.
+         */
+        RsaBatchVerifier();
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_RSA_BATCH_VERIFIER_HPP */
@@ -0,0 +1,877 @@
+/**
+ * @file RsaBlindedSigner.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::RsaBlindedSigner class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "BignumUtil.hpp"
+#include "Pkcs1.hpp"
+#include "RsaBlindedSigner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <openssl/bn.h>
+#include <openssl/rsa.h>
+#include <thread>
+#include <vector>
+
+#ifdef CRYPTO_SIGNING_OPENSSL_3
+#include <openssl/core_names.h>
+#endif /* CRYPTO_SIGNING_OPENSSL_3 */
+
+namespace {
+
+    /**
+     * This is the number of blinding factors derived, by squaring, from
+     * each freshly computed pair, before computing a fresh pair again.
+     * This matches the refresh interval libcrypto uses for its own
+     * blinding factors.
+     */
+    constexpr size_t BLINDING_REFRESH_INTERVAL = 32;
+
+    /**
+     * This is how long the refill thread waits before trying again
+     * after failing to compute blinding factors for the first time
+     * in a row.
+     */
+    constexpr std::chrono::milliseconds MIN_RETRY_DELAY(10);
+
+    /**
+     * This is the longest the refill thread waits before trying again
+     * after failing to compute blinding factors.  The delay doubles with
+     * each failure in a row, up to this limit.
+     */
+    constexpr std::chrono::milliseconds MAX_RETRY_DELAY(10000);
+
+    /**
+     * This holds one pair of blinding factors.
+     */
+    struct BlindingFactor {
+        /**
+         * This is r^e mod n, for a random r.  The message is multiplied
+         * by this before the private-key operation.
+         */
+        CryptoSigning::Bignum blind;
+
+        /**
+         * This is r^-1 mod n.  The result of the private-key operation
+         * is multiplied by this to remove the blinding.
+         */
+        CryptoSigning::Bignum unblind;
+    };
+
+    /**
+     * This holds the parameters of one of the third and subsequent prime
+     * factors of a multi-prime RSA private key (RFC 8017 section 3.2).
+     */
+    struct ExtraPrime {
+        /**
+         * This is the prime factor.
+         */
+        CryptoSigning::Bignum r;
+
+        /**
+         * This is the private exponent reduced modulo r - 1.
+         */
+        CryptoSigning::Bignum d;
+
+        /**
+         * This is the inverse, modulo r, of the product of all the
+         * prime factors which come before this one.
+         */
+        CryptoSigning::Bignum t;
+    };
+
+    /**
+     * This holds the parameters of an RSA private key.
+     */
+    struct RsaParameters {
+        /**
+         * This is the modulus.
+         */
+        CryptoSigning::Bignum n;
+
+        /**
+         * This is the public exponent.
+         */
+        CryptoSigning::Bignum e;
+
+        /**
+         * This is the first prime factor of the modulus.
+         */
+        CryptoSigning::Bignum p;
+
+        /**
+         * This is the second prime factor of the modulus.
+         */
+        CryptoSigning::Bignum q;
+
+        /**
+         * This is the private exponent reduced modulo p - 1.
+         */
+        CryptoSigning::Bignum dP;
+
+        /**
+         * This is the private exponent reduced modulo q - 1.
+         */
+        CryptoSigning::Bignum dQ;
+
+        /**
+         * This is the inverse of q modulo p.
+         */
+        CryptoSigning::Bignum qInv;
+
+        /**
+         * These are the parameters of the third and subsequent prime
+         * factors, if the key has more than two.
+         */
+        std::vector< ExtraPrime > extraPrimes;
+    };
+
+    /**
+     * This function extracts the parameters of the given RSA private key.
+     *
+     * @param[in] key
+     *     This is the key whose parameters are to be extracted.
+     *
+     * @param[out] parameters
+     *     This is where to store the parameters of the key.
+     *
+     * @return
+     *     An indication of whether or not the key is an RSA private key
+     *     whose parameters could be extracted is returned.
+     */
+    bool GetRsaParameters(
+        EVP_PKEY* key,
+        RsaParameters& parameters
+    ) {
+        if (EVP_PKEY_base_id(key) != EVP_PKEY_RSA) {
+            return false;
+        }
+#ifdef CRYPTO_SIGNING_OPENSSL_3
+        const auto get = [key](const char* name, CryptoSigning::Bignum& value){
+            BIGNUM* bn = NULL;
+            if (EVP_PKEY_get_bn_param(key, name, &bn) != 1) {
+                return false;
+            }
+            value = CryptoSigning::MakeBignum(bn);
+            return true;
+        };
+        if (
+            !get(OSSL_PKEY_PARAM_RSA_N, parameters.n)
+            || !get(OSSL_PKEY_PARAM_RSA_E, parameters.e)
+            || !get(OSSL_PKEY_PARAM_RSA_FACTOR1, parameters.p)
+            || !get(OSSL_PKEY_PARAM_RSA_FACTOR2, parameters.q)
+            || !get(OSSL_PKEY_PARAM_RSA_EXPONENT1, parameters.dP)
+            || !get(OSSL_PKEY_PARAM_RSA_EXPONENT2, parameters.dQ)
+            || !get(OSSL_PKEY_PARAM_RSA_COEFFICIENT1, parameters.qInv)
+        ) {
+            return false;
+        }
+        static const char* const extraFactorNames[] = {
+            OSSL_PKEY_PARAM_RSA_FACTOR3,
+            OSSL_PKEY_PARAM_RSA_FACTOR4,
+            OSSL_PKEY_PARAM_RSA_FACTOR5,
+            OSSL_PKEY_PARAM_RSA_FACTOR6,
+            OSSL_PKEY_PARAM_RSA_FACTOR7,
+            OSSL_PKEY_PARAM_RSA_FACTOR8,
+            OSSL_PKEY_PARAM_RSA_FACTOR9,
+            OSSL_PKEY_PARAM_RSA_FACTOR10,
+        };
+        static const char* const extraExponentNames[] = {
+            OSSL_PKEY_PARAM_RSA_EXPONENT3,
+            OSSL_PKEY_PARAM_RSA_EXPONENT4,
+            OSSL_PKEY_PARAM_RSA_EXPONENT5,
+            OSSL_PKEY_PARAM_RSA_EXPONENT6,
+            OSSL_PKEY_PARAM_RSA_EXPONENT7,
+            OSSL_PKEY_PARAM_RSA_EXPONENT8,
+            OSSL_PKEY_PARAM_RSA_EXPONENT9,
+            OSSL_PKEY_PARAM_RSA_EXPONENT10,
+        };
+        static const char* const extraCoefficientNames[] = {
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT2,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT3,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT4,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT5,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT6,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT7,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT8,
+            OSSL_PKEY_PARAM_RSA_COEFFICIENT9,
+        };
+        const auto maxExtraPrimes = (
+            sizeof(extraFactorNames) / sizeof(*extraFactorNames)
+        );
+        for (size_t i = 0; i < maxExtraPrimes; ++i) {
+            ExtraPrime extraPrime;
+            if (!get(extraFactorNames[i], extraPrime.r)) {
+                break;
+            }
+            if (
+                !get(extraExponentNames[i], extraPrime.d)
+                || !get(extraCoefficientNames[i], extraPrime.t)
+            ) {
+                return false;
+            }
+            parameters.extraPrimes.push_back(std::move(extraPrime));
+        }
+        return true;
+#else
+        const auto rsa = EVP_PKEY_get0_RSA(key);
+        const BIGNUM* n = NULL;
+        const BIGNUM* e = NULL;
+        const BIGNUM* p = NULL;
+        const BIGNUM* q = NULL;
+        const BIGNUM* dP = NULL;
+        const BIGNUM* dQ = NULL;
+        const BIGNUM* qInv = NULL;
+        RSA_get0_key(rsa, &n, &e, NULL);
+        RSA_get0_factors(rsa, &p, &q);
+        RSA_get0_crt_params(rsa, &dP, &dQ, &qInv);
+        if (
+            (n == NULL) || (e == NULL) || (p == NULL) || (q == NULL)
+            || (dP == NULL) || (dQ == NULL) || (qInv == NULL)
+        ) {
+            return false;
+        }
+        parameters.n = CryptoSigning::MakeBignum(BN_dup(n));
+        parameters.e = CryptoSigning::MakeBignum(BN_dup(e));
+        parameters.p = CryptoSigning::MakeBignum(BN_dup(p));
+        parameters.q = CryptoSigning::MakeBignum(BN_dup(q));
+        parameters.dP = CryptoSigning::MakeBignum(BN_dup(dP));
+        parameters.dQ = CryptoSigning::MakeBignum(BN_dup(dQ));
+        parameters.qInv = CryptoSigning::MakeBignum(BN_dup(qInv));
+#ifdef CRYPTO_SIGNING_MULTI_PRIME
+        const auto extraCount = RSA_get_multi_prime_extra_count(rsa);
+        if (extraCount > 0) {
+            std::vector< const BIGNUM* > primes((size_t)extraCount + 2);
+            std::vector< const BIGNUM* > exponents((size_t)extraCount + 2);
+            std::vector< const BIGNUM* > coefficients((size_t)extraCount + 1);
+            if (
+                (RSA_get0_multi_prime_factors(rsa, primes.data()) != 1)
+                || (
+                    RSA_get0_multi_prime_crt_params(
+                        rsa,
+                        exponents.data(),
+                        coefficients.data()
+                    ) != 1
+                )
+            ) {
+                return false;
+            }
+            for (size_t i = 0; i < (size_t)extraCount; ++i) {
+                ExtraPrime extraPrime;
+                extraPrime.r = CryptoSigning::MakeBignum(
+                    BN_dup(primes[i + 2])
+                );
+                extraPrime.d = CryptoSigning::MakeBignum(
+                    BN_dup(exponents[i + 2])
+                );
+                extraPrime.t = CryptoSigning::MakeBignum(
+                    BN_dup(coefficients[i + 1])
+                );
+                parameters.extraPrimes.push_back(std::move(extraPrime));
+            }
+        }
+#endif
+        return true;
+#endif
+    }
+
+    /**
+     * This function computes two modular exponentiations with secret
+     * exponents.  Where libcrypto supports it, the two are computed
+     * together, which is faster on processors with wide multipliers.
+     *
+     * @param[out] result1
+     *     This is where to store the first result.
+     *
+     * @param[in] base1
+     *     This is the first base, which must be less than modulus1.
+     *
+     * @param[in] exponent1
+     *     This is the first exponent.
+     *
+     * @param[in] modulus1
+     *     This is the first modulus.
+     *
+     * @param[in] mont1
+     *     These are the precomputed values used in Montgomery
+     *     multiplication modulo the first modulus.
+     *
+     * @param[out] result2
+     *     This is where to store the second result.
+     *
+     * @param[in] base2
+     *     This is the second base, which must be less than modulus2.
+     *
+     * @param[in] exponent2
+     *     This is the second exponent.
+     *
+     * @param[in] modulus2
+     *     This is the second modulus.
+     *
+     * @param[in] mont2
+     *     These are the precomputed values used in Montgomery
+     *     multiplication modulo the second modulus.
+     *
+     * @param[in] ctx
+     *     This is the scratch space to use.
+     *
+     * @return
+     *     An indication of whether or not the results were computed
+     *     is returned.
+     */
+    bool ModExpPair(
+        BIGNUM* result1,
+        const BIGNUM* base1,
+        const BIGNUM* exponent1,
+        const BIGNUM* modulus1,
+        BN_MONT_CTX* mont1,
+        BIGNUM* result2,
+        const BIGNUM* base2,
+        const BIGNUM* exponent2,
+        const BIGNUM* modulus2,
+        BN_MONT_CTX* mont2,
+        BN_CTX* ctx
+    ) {
+#ifdef CRYPTO_SIGNING_OPENSSL_3
+        return (
+            BN_mod_exp_mont_consttime_x2(
+                result1,
+                base1,
+                exponent1,
+                modulus1,
+                mont1,
+                result2,
+                base2,
+                exponent2,
+                modulus2,
+                mont2,
+                ctx
+            ) == 1
+        );
+#else
+        return (
+            (
+                BN_mod_exp_mont_consttime(
+                    result1,
+                    base1,
+                    exponent1,
+                    modulus1,
+                    ctx,
+                    mont1
+                ) == 1
+            )
+            && (
+                BN_mod_exp_mont_consttime(
+                    result2,
+                    base2,
+                    exponent2,
+                    modulus2,
+                    ctx,
+                    mont2
+                ) == 1
+            )
+        );
+#endif
+    }
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a RsaBlindedSigner instance.
+     */
+    struct RsaBlindedSigner::Impl {
+        /**
+         * These are the parameters of the private key.
+         */
+        RsaParameters key;
+
+        /**
+         * This is the length, in bytes, of the modulus.
+         */
+        size_t length = 0;
+
+        /**
+         * These are the precomputed values used in Montgomery
+         * multiplication modulo n.
+         */
+        MontContext montN;
+
+        /**
+         * These are the precomputed values used in Montgomery
+         * multiplication modulo p.
+         */
+        MontContext montP;
+
+        /**
+         * These are the precomputed values used in Montgomery
+         * multiplication modulo q.
+         */
+        MontContext montQ;
+
+        /**
+         * These are the precomputed values used in Montgomery
+         * multiplication modulo each of the third and subsequent
+         * prime factors, if the key has more than two.
+         */
+        std::vector< MontContext > montExtra;
+
+        /**
+         * This is the number of blinding factors to keep ready.
+         */
+        size_t poolSize = 0;
+
+        /**
+         * This is used to synchronize access to the pool.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake up the background thread when the pool
+         * needs refilling or the signer is being destroyed.
+         */
+        std::condition_variable wakeRefiller;
+
+        /**
+         * These are the blinding factors ready to use.
+         */
+        std::deque< BlindingFactor > pool;
+
+        /**
+         * This indicates whether or not the signer is being destroyed.
+         */
+        bool stopping = false;
+
+        /**
+         * This is the thread which keeps the pool filled.
+         */
+        std::thread refiller;
+
+        // Methods
+
+        /**
+         * This method computes a fresh pair of blinding factors.
+         *
+         * @param[in] ctx
+         *     This is the scratch space to use.
+         *
+         * @param[out] factor
+         *     This is where to store the blinding factors.
+         *
+         * @return
+         *     An indication of whether or not the blinding factors
+         *     were computed is returned.
+         */
+        bool MakeBlindingFactor(
+            BN_CTX* ctx,
+            BlindingFactor& factor
+        ) {
+            auto r = MakeBignum();
+            factor.blind = MakeBignum();
+            for (int attempt = 0; attempt < 32; ++attempt) {
+                if (BN_priv_rand_range(r.get(), key.n.get()) != 1) {
+                    return false;
+                }
+                factor.unblind = MakeBignum(
+                    BN_mod_inverse(NULL, r.get(), key.n.get(), ctx)
+                );
+                if (factor.unblind != nullptr) {
+                    return (
+                        BN_mod_exp_mont(
+                            factor.blind.get(),
+                            r.get(),
+                            key.e.get(),
+                            key.n.get(),
+                            ctx,
+                            montN.get()
+                        ) == 1
+                    );
+                }
+            }
+            return false;
+        }
+
+        /**
+         * This method takes a pair of blinding factors from the pool,
+         * or computes a fresh pair if the pool is empty.
+         *
+         * @param[in] ctx
+         *     This is the scratch space to use.
+         *
+         * @param[out] factor
+         *     This is where to store the blinding factors.
+         *
+         * @return
+         *     An indication of whether or not blinding factors
+         *     were obtained is returned.
+         */
+        bool TakeBlindingFactor(
+            BN_CTX* ctx,
+            BlindingFactor& factor
+        ) {
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                if (!pool.empty()) {
+                    factor = std::move(pool.front());
+                    pool.pop_front();
+                    wakeRefiller.notify_one();
+                    return true;
+                }
+            }
+            return MakeBlindingFactor(ctx, factor);
+        }
+
+        /**
+         * This method is the body of the thread which keeps
+         * the pool filled.
+         */
+        void Refiller() {
+            const auto ctx = MakeBignumContext();
+            BlindingFactor seed;
+            size_t uses = 0;
+            auto retryDelay = MIN_RETRY_DELAY;
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            for (;;) {
+                wakeRefiller.wait(
+                    lock,
+                    [this]{ return stopping || (pool.size() < poolSize); }
+                );
+                if (stopping) {
+                    break;
+                }
+                lock.unlock();
+                bool made;
+                if (uses == 0) {
+                    made = MakeBlindingFactor(ctx.get(), seed);
+                } else {
+                    made = (
+                        (
+                            BN_mod_sqr(
+                                seed.blind.get(),
+                                seed.blind.get(),
+                                key.n.get(),
+                                ctx.get()
+                            ) == 1
+                        )
+                        && (
+                            BN_mod_sqr(
+                                seed.unblind.get(),
+                                seed.unblind.get(),
+                                key.n.get(),
+                                ctx.get()
+                            ) == 1
+                        )
+                    );
+                }
+                uses = (uses + 1) % BLINDING_REFRESH_INTERVAL;
+                BlindingFactor factor;
+                if (made) {
+                    factor.blind = MakeBignum(BN_dup(seed.blind.get()));
+                    factor.unblind = MakeBignum(BN_dup(seed.unblind.get()));
+                }
+                lock.lock();
+                if (
+                    (factor.blind == nullptr)
+                    || (factor.unblind == nullptr)
+                ) {
+                    // Start over from a freshly computed pair, after
+                    // backing off rather than spinning, in case the
+                    // failure persists.  Signing goes on meanwhile,
+                    // computing blinding factors as it needs them.
+                    uses = 0;
+                    (void)wakeRefiller.wait_for(
+                        lock,
+                        retryDelay,
+                        [this]{ return stopping; }
+                    );
+                    retryDelay = std::min(retryDelay * 2, MAX_RETRY_DELAY);
+                    continue;
+                }
+                retryDelay = MIN_RETRY_DELAY;
+                pool.push_back(std::move(factor));
+            }
+        }
+
+        /**
+         * This method computes c^d mod n, using the Chinese Remainder
+         * Theorem, as given in RFC 8017 section 5.1.2 for keys with
+         * any number of prime factors.
+         *
+         * @param[in] c
+         *     This is the blinded message representative.
+         *
+         * @param[out] s
+         *     This is where to store the result.
+         *
+         * @param[in] ctx
+         *     This is the scratch space to use.
+         *
+         * @return
+         *     An indication of whether or not the result was computed
+         *     is returned.
+         */
+        bool PrivateExponentiation(
+            const BIGNUM* c,
+            BIGNUM* s,
+            BN_CTX* ctx
+        ) {
+            const auto cp = MakeBignum();
+            const auto cq = MakeBignum();
+            const auto m1 = MakeBignum();
+            const auto m2 = MakeBignum();
+            const auto h = MakeBignum();
+            if (
+                (BN_nnmod(cp.get(), c, key.p.get(), ctx) != 1)
+                || (BN_nnmod(cq.get(), c, key.q.get(), ctx) != 1)
+                || !ModExpPair(
+                    m1.get(),
+                    cp.get(),
+                    key.dP.get(),
+                    key.p.get(),
+                    montP.get(),
+                    m2.get(),
+                    cq.get(),
+                    key.dQ.get(),
+                    key.q.get(),
+                    montQ.get(),
+                    ctx
+                )
+                || (BN_sub(h.get(), m1.get(), m2.get()) != 1)
+                || (BN_nnmod(h.get(), h.get(), key.p.get(), ctx) != 1)
+                || (
+                    BN_mod_mul(
+                        h.get(),
+                        h.get(),
+                        key.qInv.get(),
+                        key.p.get(),
+                        ctx
+                    ) != 1
+                )
+                || (BN_mul(s, h.get(), key.q.get(), ctx) != 1)
+                || (BN_add(s, s, m2.get()) != 1)
+            ) {
+                return false;
+            }
+            const auto numExtraPrimes = key.extraPrimes.size();
+            if (numExtraPrimes == 0) {
+                return true;
+            }
+            std::vector< Bignum > extraBases;
+            std::vector< Bignum > extraResults;
+            for (const auto& extraPrime: key.extraPrimes) {
+                extraBases.push_back(MakeBignum());
+                extraResults.push_back(MakeBignum());
+                if (
+                    BN_nnmod(
+                        extraBases.back().get(),
+                        c,
+                        extraPrime.r.get(),
+                        ctx
+                    ) != 1
+                ) {
+                    return false;
+                }
+            }
+            for (size_t i = 0; i < numExtraPrimes; i += 2) {
+                const auto& first = key.extraPrimes[i];
+                if (i + 1 < numExtraPrimes) {
+                    const auto& second = key.extraPrimes[i + 1];
+                    if (
+                        !ModExpPair(
+                            extraResults[i].get(),
+                            extraBases[i].get(),
+                            first.d.get(),
+                            first.r.get(),
+                            montExtra[i].get(),
+                            extraResults[i + 1].get(),
+                            extraBases[i + 1].get(),
+                            second.d.get(),
+                            second.r.get(),
+                            montExtra[i + 1].get(),
+                            ctx
+                        )
+                    ) {
+                        return false;
+                    }
+                } else if (
+                    BN_mod_exp_mont_consttime(
+                        extraResults[i].get(),
+                        extraBases[i].get(),
+                        first.d.get(),
+                        first.r.get(),
+                        ctx,
+                        montExtra[i].get()
+                    ) != 1
+                ) {
+                    return false;
+                }
+            }
+            const auto product = MakeBignum();
+            if (BN_mul(product.get(), key.p.get(), key.q.get(), ctx) != 1) {
+                return false;
+            }
+            for (size_t i = 0; i < numExtraPrimes; ++i) {
+                const auto& extraPrime = key.extraPrimes[i];
+                if (
+                    (BN_sub(h.get(), extraResults[i].get(), s) != 1)
+                    || (BN_nnmod(h.get(), h.get(), extraPrime.r.get(), ctx) != 1)
+                    || (
+                        BN_mod_mul(
+                            h.get(),
+                            h.get(),
+                            extraPrime.t.get(),
+                            extraPrime.r.get(),
+                            ctx
+                        ) != 1
+                    )
+                    || (BN_mul(h.get(), h.get(), product.get(), ctx) != 1)
+                    || (BN_add(s, s, h.get()) != 1)
+                    || (
+                        BN_mul(
+                            product.get(),
+                            product.get(),
+                            extraPrime.r.get(),
+                            ctx
+                        ) != 1
+                    )
+                ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    RsaBlindedSigner::~RsaBlindedSigner() noexcept {
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            impl_->stopping = true;
+            impl_->wakeRefiller.notify_all();
+        }
+        if (impl_->refiller.joinable()) {
+            impl_->refiller.join();
+        }
+    }
+
+    RsaBlindedSigner::RsaBlindedSigner()
+        : impl_(new Impl())
+    {
+    }
+
+    std::unique_ptr< RsaBlindedSigner > RsaBlindedSigner::Create(
+        EVP_PKEY* key,
+        size_t poolSize
+    ) {
+        std::unique_ptr< RsaBlindedSigner > signer(new RsaBlindedSigner());
+        auto& impl = *signer->impl_;
+        if (!GetRsaParameters(key, impl.key)) {
+            return nullptr;
+        }
+        const auto ctx = MakeBignumContext();
+        impl.montN = MakeMontContext(impl.key.n.get(), ctx.get());
+        impl.montP = MakeMontContext(impl.key.p.get(), ctx.get());
+        impl.montQ = MakeMontContext(impl.key.q.get(), ctx.get());
+        if (
+            (impl.montN == nullptr)
+            || (impl.montP == nullptr)
+            || (impl.montQ == nullptr)
+        ) {
+            return nullptr;
+        }
+        BN_set_flags(impl.key.p.get(), BN_FLG_CONSTTIME);
+        BN_set_flags(impl.key.q.get(), BN_FLG_CONSTTIME);
+        BN_set_flags(impl.key.dP.get(), BN_FLG_CONSTTIME);
+        BN_set_flags(impl.key.dQ.get(), BN_FLG_CONSTTIME);
+        for (const auto& extraPrime: impl.key.extraPrimes) {
+            auto mont = MakeMontContext(extraPrime.r.get(), ctx.get());
+            if (mont == nullptr) {
+                return nullptr;
+            }
+            impl.montExtra.push_back(std::move(mont));
+            BN_set_flags(extraPrime.r.get(), BN_FLG_CONSTTIME);
+            BN_set_flags(extraPrime.d.get(), BN_FLG_CONSTTIME);
+        }
+        impl.length = (size_t)BN_num_bytes(impl.key.n.get());
+        impl.poolSize = poolSize;
+        impl.refiller = std::thread(&Impl::Refiller, &impl);
+        return signer;
+    }
+
+    std::vector< uint8_t > RsaBlindedSigner::SignDigest(const uint8_t* digest) {
+        const auto encoded = Pkcs1::EncodeSha256(digest, impl_->length);
+        if (encoded.empty()) {
+            return {};
+        }
+        const auto ctx = MakeBignumContext();
+        const auto m = MakeBignum(
+            BN_bin2bn(encoded.data(), (int)encoded.size(), NULL)
+        );
+        const auto c = MakeBignum();
+        const auto s = MakeBignum();
+        const auto check = MakeBignum();
+        BlindingFactor factor;
+        if (
+            (ctx == nullptr)
+            || (m == nullptr)
+            || !impl_->TakeBlindingFactor(ctx.get(), factor)
+            || (
+                BN_mod_mul(
+                    c.get(),
+                    m.get(),
+                    factor.blind.get(),
+                    impl_->key.n.get(),
+                    ctx.get()
+                ) != 1
+            )
+            || !impl_->PrivateExponentiation(c.get(), s.get(), ctx.get())
+            || (
+                BN_mod_mul(
+                    s.get(),
+                    s.get(),
+                    factor.unblind.get(),
+                    impl_->key.n.get(),
+                    ctx.get()
+                ) != 1
+            )
+            || (
+                BN_mod_exp_mont(
+                    check.get(),
+                    s.get(),
+                    impl_->key.e.get(),
+                    impl_->key.n.get(),
+                    ctx.get(),
+                    impl_->montN.get()
+                ) != 1
+            )
+            || (BN_cmp(check.get(), m.get()) != 0)
+        ) {
+            return {};
+        }
+        std::vector< uint8_t > signature(impl_->length);
+        if (
+            BN_bn2binpad(
+                s.get(),
+                signature.data(),
+                (int)signature.size()
+            ) != (int)signature.size()
+        ) {
+            return {};
+        }
+        return signature;
+    }
+
+    size_t RsaBlindedSigner::GetPoolLevel() {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        return impl_->pool.size();
+    }
+
+}
@@ -0,0 +1,101 @@
+#ifndef CRYPTO_SIGNING_RSA_BLINDED_SIGNER_HPP
+#define CRYPTO_SIGNING_RSA_BLINDED_SIGNER_HPP
+
+/**
+ * @file RsaBlindedSigner.hpp
+ *
+ * This module declares the CryptoSigning::RsaBlindedSigner class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <memory>
+#include <openssl/evp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This class makes RSA PKCS#1 v1.5 SHA-256 signatures using the
+     * Chinese Remainder Theorem, with the message blinded by factors
+     * taken from a pool.  A background thread keeps the pool filled, so
+     * that computing fresh blinding factors stays off the critical path
+     * of making a signature.
+     */
+    class RsaBlindedSigner {
+        // Lifecycle management
+    public:
+        ~RsaBlindedSigner() noexcept;
+        RsaBlindedSigner(const RsaBlindedSigner&) = delete;
+        RsaBlindedSigner(RsaBlindedSigner&&) = delete;
+        RsaBlindedSigner& operator=(const RsaBlindedSigner&) = delete;
+        RsaBlindedSigner& operator=(RsaBlindedSigner&&) = delete;
+
+        // Public Methods
+    public:
+        /**
+         * This function makes a signer for the given key, if the key
+         * is an RSA private key whose parameters can be used directly.
+         *
+         * @param[in] key
+         *     This is the private key to use.
+         *
+         * @param[in] poolSize
+         *     This is the number of blinding factors to keep ready.
+         *
+         * @return
+         *     The new signer is returned, or nullptr if the key
+         *     isn't supported.
+         */
+        static std::unique_ptr< RsaBlindedSigner > Create(
+            EVP_PKEY* key,
+            size_t poolSize
+        );
+
+        /**
+         * This method signs the given SHA-256 digest.
+         *
+         * @param[in] digest
+         *     This points to the SHA-256 digest to sign.
+         *
+         * @return
+         *     The raw binary cryptographic signature is returned, or an
+         *     empty vector if the signature could not be made.
+         */
+        std::vector< uint8_t > SignDigest(const uint8_t* digest);
+
+        /**
+         * This method returns the number of blinding factors ready to use.
+         *
+         * @return
+         *     The number of blinding factors ready to use is returned.
+         */
+        size_t GetPoolLevel();
+
+        // Private Methods
+    private:
+        /**
+         * This is the constructor used by Create.
+         */
+        RsaBlindedSigner();
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_RSA_BLINDED_SIGNER_HPP */
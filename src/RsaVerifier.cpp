@@ -0,0 +1,162 @@
+/**
+ * @file RsaVerifier.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::RsaVerifier class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "BignumUtil.hpp"
+#include "Pkcs1.hpp"
+#include "RsaVerifier.hpp"
+
+#include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is the only public exponent supported.
+     */
+    constexpr unsigned long SUPPORTED_EXPONENT = 65537;
+
+    /**
+     * This is the number of times the signature is squared in the
+     * public-key operation, since the supported public exponent
+     * is 2^16 + 1.
+     */
+    constexpr int SQUARINGS = 16;
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a RsaVerifier instance.
+     */
+    struct RsaVerifier::Impl {
+        /**
+         * This is the modulus.
+         */
+        Bignum n;
+
+        /**
+         * This is the length, in bytes, of the modulus.
+         */
+        size_t length = 0;
+
+        /**
+         * These are the precomputed values used in Montgomery
+         * multiplication modulo n.
+         */
+        MontContext mont;
+    };
+
+    RsaVerifier::~RsaVerifier() noexcept = default;
+
+    RsaVerifier::RsaVerifier()
+        : impl_(new Impl())
+    {
+    }
+
+    std::unique_ptr< RsaVerifier > RsaVerifier::Create(EVP_PKEY* key) {
+        Bignum n;
+        Bignum e;
+        if (
+            !GetRsaPublicParameters(key, n, e)
+            || (BN_get_word(e.get()) != SUPPORTED_EXPONENT)
+            || !BN_is_odd(n.get())
+        ) {
+            return nullptr;
+        }
+        const auto ctx = MakeBignumContext();
+        if (ctx == nullptr) {
+            return nullptr;
+        }
+        auto mont = MakeMontContext(n.get(), ctx.get());
+        if (mont == nullptr) {
+            return nullptr;
+        }
+        std::unique_ptr< RsaVerifier > verifier(new RsaVerifier());
+        auto& impl = *verifier->impl_;
+        impl.length = (size_t)BN_num_bytes(n.get());
+        impl.n = std::move(n);
+        impl.mont = std::move(mont);
+        return verifier;
+    }
+
+    bool RsaVerifier::VerifyDigest(
+        const uint8_t* digest,
+        const uint8_t* signature,
+        size_t signatureLength
+    ) const {
+        if (signatureLength != impl_->length) {
+            return false;
+        }
+        const auto expected = Pkcs1::EncodeSha256(digest, impl_->length);
+        const auto ctx = MakeBignumContext();
+        const auto s = MakeBignum(
+            BN_bin2bn(signature, (int)signatureLength, NULL)
+        );
+        const auto x = MakeBignum();
+        if (
+            expected.empty()
+            || (ctx == nullptr)
+            || (s == nullptr)
+            || (x == nullptr)
+            || (BN_ucmp(s.get(), impl_->n.get()) >= 0)
+        ) {
+            return false;
+        }
+
+        // x = s * R mod n, then x = s^65536 * R mod n after squaring,
+        // and the final Montgomery multiplication by s (not in Montgomery
+        // form) takes out the factor R, leaving s^65537 mod n.
+        const auto mont = impl_->mont.get();
+        if (BN_to_montgomery(x.get(), s.get(), mont, ctx.get()) != 1) {
+            return false;
+        }
+        for (int i = 0; i < SQUARINGS; ++i) {
+            if (
+                BN_mod_mul_montgomery(
+                    x.get(),
+                    x.get(),
+                    x.get(),
+                    mont,
+                    ctx.get()
+                ) != 1
+            ) {
+                return false;
+            }
+        }
+        std::vector< uint8_t > message(impl_->length);
+        return (
+            (
+                BN_mod_mul_montgomery(
+                    x.get(),
+                    x.get(),
+                    s.get(),
+                    mont,
+                    ctx.get()
+                ) == 1
+            )
+            && (
+                BN_bn2binpad(
+                    x.get(),
+                    message.data(),
+                    (int)message.size()
+                ) == (int)message.size()
+            )
+            && (
+                CRYPTO_memcmp(
+                    message.data(),
+                    expected.data(),
+                    message.size()
+                ) == 0
+            )
+        );
+    }
+
+}
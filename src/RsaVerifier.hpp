@@ -0,0 +1,100 @@
+#ifndef CRYPTO_SIGNING_RSA_VERIFIER_HPP
+#define CRYPTO_SIGNING_RSA_VERIFIER_HPP
+
+/**
+ * @file RsaVerifier.hpp
+ *
+ * This module declares the CryptoSigning::RsaVerifier class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <memory>
+#include <openssl/evp.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace CryptoSigning {
+
+    /**
+     * This class verifies RSA PKCS#1 v1.5 SHA-256 signatures made with
+     * a key whose public exponent is 65537.  The public-key operation is
+     * then just 16 modular squarings and one multiplication, so it's done
+     * directly with Montgomery multiplication, using values precomputed
+     * for the modulus when the verifier is made, and the result is
+     * compared against the expected encoding of the digest.  This avoids
+     * the context setup and dispatch which libcrypto does around each
+     * signature it verifies, which is most of the cost for short messages.
+     */
+    class RsaVerifier {
+        // Lifecycle management
+    public:
+        ~RsaVerifier() noexcept;
+        RsaVerifier(const RsaVerifier&) = delete;
+        RsaVerifier(RsaVerifier&&) = delete;
+        RsaVerifier& operator=(const RsaVerifier&) = delete;
+        RsaVerifier& operator=(RsaVerifier&&) = delete;
+
+        // Public Methods
+    public:
+        /**
+         * This function makes a verifier for the given key, if the key is
+         * an RSA key with a public exponent of 65537.
+         *
+         * @param[in] key
+         *     This is the public or private key to use.
+         *
+         * @return
+         *     The new verifier is returned, or nullptr if the key
+         *     isn't supported.
+         */
+        static std::unique_ptr< RsaVerifier > Create(EVP_PKEY* key);
+
+        /**
+         * This method verifies the given signature of the given digest.
+         * It may be called from more than one thread at a time.
+         *
+         * @param[in] digest
+         *     This points to the SHA-256 digest of the signed data.
+         *
+         * @param[in] signature
+         *     This points to the signature to verify.
+         *
+         * @param[in] signatureLength
+         *     This is the length, in bytes, of the signature.
+         *
+         * @return
+         *     An indication of whether or not the signature is valid
+         *     is returned.
+         */
+        bool VerifyDigest(
+            const uint8_t* digest,
+            const uint8_t* signature,
+            size_t signatureLength
+        ) const;
+
+        // Private Methods
+    private:
+        /**
+         * This is the constructor used by Create.
+         */
+        RsaVerifier();
+
+        // Private Properties
+    private:
+        /**
+         * This is the type of structure that contains the private
+         * properties of the instance.  It is defined in the implementation
+         * and declared here to ensure that it is scoped inside the class.
+         */
+        struct Impl;
+
+        /**
+         * This contains the private properties of the instance.
+         */
+        std::unique_ptr< Impl > impl_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_RSA_VERIFIER_HPP */
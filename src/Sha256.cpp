@@ -0,0 +1,26 @@
+/**
+ * @file Sha256.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::Sha256 functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sha256.hpp"
+
+#include <openssl/evp.h>
+
+namespace CryptoSigning {
+
+    std::vector< uint8_t > Sha256(const uint8_t* data, size_t size) {
+        std::vector< uint8_t > digest(SHA256_DIGEST_SIZE);
+        (void)EVP_Digest(data, size, digest.data(), NULL, EVP_sha256(), NULL);
+        return digest;
+    }
+
+    std::vector< uint8_t > Sha256(const std::vector< uint8_t >& data) {
+        return Sha256(data.data(), data.size());
+    }
+
+}
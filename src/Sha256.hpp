@@ -0,0 +1,50 @@
+#ifndef CRYPTO_SIGNING_SHA256_HPP
+#define CRYPTO_SIGNING_SHA256_HPP
+
+/**
+ * @file Sha256.hpp
+ *
+ * This module declares the CryptoSigning::Sha256 functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This is the size, in bytes, of a SHA-256 digest.
+     */
+    constexpr size_t SHA256_DIGEST_SIZE = 32;
+
+    /**
+     * This function computes the SHA-256 digest of the given data.
+     *
+     * @param[in] data
+     *     This points to the data to digest.
+     *
+     * @param[in] size
+     *     This is the number of bytes of data to digest.
+     *
+     * @return
+     *     The SHA-256 digest of the data is returned.
+     */
+    std::vector< uint8_t > Sha256(const uint8_t* data, size_t size);
+
+    /**
+     * This function computes the SHA-256 digest of the given data.
+     *
+     * @param[in] data
+     *     This is the data to digest.
+     *
+     * @return
+     *     The SHA-256 digest of the data is returned.
+     */
+    std::vector< uint8_t > Sha256(const std::vector< uint8_t >& data);
+
+}
+
+#endif /* CRYPTO_SIGNING_SHA256_HPP */
@@ -7,13 +7,47 @@
  * © 2018 by Richard Walters
  */
 
+#include "Backend.hpp"
+#include "Parallel.hpp"
+#include "Sha256.hpp"
+
+#include <atomic>
 #include <CryptoSigning/Sign.hpp>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <openssl/bio.h>
 #include <openssl/pem.h>
 #include <string>
 
+namespace {
+
+    /**
+     * This holds a key configured for a Sign instance, along with the
+     * means of making signatures with it.  Once published to readers,
+     * it is never modified; instead, a new one replaces it.
+     */
+    struct KeyState {
+        /**
+         * This is the private key to use in making cryptographic
+         * signatures.
+         */
+        std::shared_ptr< EVP_PKEY > key;
+
+        /**
+         * This is used to make signatures with the key.
+         */
+        std::unique_ptr< CryptoSigning::Backend::Signer > signer;
+
+        /**
+         * This indicates whether or not the signer uses an RSA blinding
+         * factor pool.
+         */
+        bool blindingPoolInUse = false;
+    };
+
+}
+
 namespace CryptoSigning {
 
     /**
@@ -21,10 +55,70 @@ namespace CryptoSigning {
      */
     struct Sign::Impl {
         /**
-         * This is the private key, in PEM format, to use in making
-         * cryptographic signatures.
+         * This is the key currently configured, if any.  It is only
+         * ever accessed through std::atomic_load and std::atomic_store,
+         * so that it can be replaced while other threads are using it.
+         */
+        std::shared_ptr< KeyState > state;
+
+        /**
+         * This is used to synchronize configuring the instance, so that
+         * the settings below can be changed while another thread is
+         * configuring a key.  Making signatures doesn't use it.
+         */
+        std::mutex configMutex;
+
+        /**
+         * This is the name of the backend to use, or an empty string
+         * to use the most preferred backend which supports the key.
+         */
+        std::string backendName;
+
+        /**
+         * This is the number of precomputed RSA blinding factors to keep
+         * ready, or zero if the blinding factor pool is turned off.
+         */
+        size_t blindingPoolSize = 0;
+
+        // Methods
+
+        /**
+         * This method takes a snapshot of the key currently configured.
+         * The key remains usable through the snapshot even if it's
+         * replaced in the meantime.
+         *
+         * @return
+         *     The key currently configured is returned, or nullptr
+         *     if no key is configured.
+         */
+        std::shared_ptr< KeyState > GetState() const {
+            return std::atomic_load(&state);
+        }
+
+        /**
+         * This method sets up the instance to use the given key.
+         * The configuration mutex must be held.
+         *
+         * @param[in] key
+         *     This is the key to use.
+         *
+         * @return
+         *     An indication of whether or not the instance was
+         *     successfully set up to use the key is returned.
          */
-        std::unique_ptr< EVP_PKEY, std::function< void(EVP_PKEY*) > > key;
+        bool UseKey(std::shared_ptr< EVP_PKEY > key) {
+            std::shared_ptr< KeyState > newState(new KeyState());
+            newState->signer = Backend::MakeSigner(backendName, key.get());
+            if (newState->signer == nullptr) {
+                return false;
+            }
+            newState->blindingPoolInUse = (
+                newState->signer->SetBlindingPoolSize(blindingPoolSize)
+            );
+            newState->key = std::move(key);
+            std::atomic_store(&state, newState);
+            return true;
+        }
     };
 
     Sign::~Sign() noexcept = default;
@@ -63,61 +157,83 @@ namespace CryptoSigning {
         if (key == NULL) {
             return false;
         }
-        impl_->key = std::move(key);
-        return true;
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        return impl_->UseKey(std::move(key));
     }
 
-    std::vector< uint8_t > Sign::operator()(const std::vector< uint8_t >& data) {
-        if (impl_->key == nullptr) {
-            return {};
+    bool Sign::SetBackend(const std::string& backendName) {
+        if (!Backend::IsKnown(backendName)) {
+            return false;
         }
-        std::unique_ptr< EVP_MD_CTX, std::function< void(EVP_MD_CTX*) > > ctx(
-            EVP_MD_CTX_create(),
-            [](EVP_MD_CTX* p) {
-                EVP_MD_CTX_free(p);
-            }
-        );
-        if (
-            EVP_DigestSignInit(
-                ctx.get(),
-                NULL,
-                EVP_sha256(),
-                NULL,
-                impl_->key.get()
-            ) <= 0
-        ) {
-            return {};
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        impl_->backendName = backendName;
+        return true;
+    }
+
+    bool Sign::SetBlindingPoolSize(size_t poolSize) {
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        impl_->blindingPoolSize = poolSize;
+        const auto state = impl_->GetState();
+        if (state == nullptr) {
+            return (poolSize == 0);
         }
-        if (
-            EVP_DigestSignUpdate(
-                ctx.get(),
-                data.data(),
-                data.size()
-            ) <= 0
-        ) {
-            return {};
+        if (!impl_->UseKey(state->key)) {
+            return false;
         }
-        size_t signatureLength;
-        if (
-            EVP_DigestSignFinal(
-                ctx.get(),
-                NULL,
-                &signatureLength
-            ) <= 0
-        ) {
+        return impl_->GetState()->blindingPoolInUse;
+    }
+
+    std::vector< uint8_t > Sign::operator()(const std::vector< uint8_t >& data) {
+        const auto state = impl_->GetState();
+        if (state == nullptr) {
             return {};
         }
-        std::vector< uint8_t > signature(signatureLength);
+        return state->signer->Sign(data.data(), data.size());
+    }
+
+    std::vector< uint8_t > Sign::SignDigest(const std::vector< uint8_t >& digest) {
+        const auto state = impl_->GetState();
         if (
-            EVP_DigestSignFinal(
-                ctx.get(),
-                signature.data(),
-                &signatureLength
-            ) <= 0
+            (state == nullptr)
+            || (digest.size() != SHA256_DIGEST_SIZE)
         ) {
             return {};
         }
-        return signature;
+        return state->signer->SignDigest(digest.data());
+    }
+
+    std::vector< std::vector< uint8_t > > Sign::SignWithEach(
+        const std::vector< Sign* >& signers,
+        const std::vector< uint8_t >& data,
+        size_t workers
+    ) {
+        const auto digest = Sha256(data);
+        std::vector< std::vector< uint8_t > > signatures(signers.size());
+        RunInParallel(
+            signers.size(),
+            workers,
+            [&](size_t index){
+                const auto sign = signers[index];
+                if (sign == nullptr) {
+                    return;
+                }
+                const auto state = sign->impl_->GetState();
+                if (state == nullptr) {
+                    return;
+                }
+                if (state->signer->SupportsDigests()) {
+                    signatures[index] = state->signer->SignDigest(
+                        digest.data()
+                    );
+                } else {
+                    signatures[index] = state->signer->Sign(
+                        data.data(),
+                        data.size()
+                    );
+                }
+            }
+        );
+        return signatures;
     }
 
 }
@@ -0,0 +1,312 @@
+/**
+ * @file SignClient.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::SignClient class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "SignProtocol.hpp"
+
+#include <CryptoSigning/SignClient.hpp>
+#include <errno.h>
+#include <map>
+#include <mutex>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+    /**
+     * This is the number of bytes to try to read from the server
+     * at a time.
+     */
+    constexpr size_t READ_SIZE = 65536;
+
+    /**
+     * This function returns a future which already holds an empty
+     * signature, used to answer requests which can't be sent.
+     *
+     * @return
+     *     A future holding an empty signature is returned.
+     */
+    std::future< std::vector< uint8_t > > FailedRequest() {
+        std::promise< std::vector< uint8_t > > promise;
+        promise.set_value({});
+        return promise.get_future();
+    }
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a SignClient instance.
+     */
+    struct SignClient::Impl {
+        /**
+         * This is the socket connected to the server.
+         */
+        int sock = -1;
+
+        /**
+         * This is the thread which reads responses from the server.
+         */
+        std::thread reader;
+
+        /**
+         * This is used to synchronize access to the requests
+         * awaiting responses.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to keep requests from different threads
+         * from interleaving.
+         */
+        std::mutex writeMutex;
+
+        /**
+         * These are the promises of the requests awaiting responses,
+         * indexed by request identifier.
+         */
+        std::map< uint32_t, std::promise< std::vector< uint8_t > > > pending;
+
+        /**
+         * This is the identifier to give the next request.
+         */
+        uint32_t nextId = 0;
+
+        /**
+         * This indicates whether or not the client is connected.
+         */
+        bool connected = false;
+
+        // Methods
+
+        /**
+         * This method completes all requests awaiting responses
+         * with empty signatures.
+         */
+        void FailPending() {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            for (auto& request: pending) {
+                request.second.set_value({});
+            }
+            pending.clear();
+            connected = false;
+        }
+
+        /**
+         * This method is the body of the thread which reads responses
+         * from the server.
+         */
+        void ReaderThread() {
+            std::vector< uint8_t > buffer;
+            std::vector< uint8_t > readBuffer(READ_SIZE);
+            for (;;) {
+                const auto amount = recv(
+                    sock,
+                    readBuffer.data(),
+                    readBuffer.size(),
+                    0
+                );
+                if (amount < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    break;
+                } else if (amount == 0) {
+                    break;
+                }
+                buffer.insert(
+                    buffer.end(),
+                    readBuffer.begin(),
+                    readBuffer.begin() + amount
+                );
+                size_t consumed = 0;
+                int found;
+                for (;;) {
+                    size_t payloadSize;
+                    found = SignProtocol::FindFrame(
+                        buffer.data() + consumed,
+                        buffer.size() - consumed,
+                        payloadSize
+                    );
+                    if (found <= 0) {
+                        break;
+                    }
+                    const auto payload = (
+                        buffer.data() + consumed + SignProtocol::FRAME_HEADER_SIZE
+                    );
+                    uint32_t id;
+                    SignProtocol::Status status;
+                    std::vector< uint8_t > signature;
+                    if (
+                        !SignProtocol::DecodeResponse(
+                            payload,
+                            payloadSize,
+                            id,
+                            status,
+                            signature
+                        )
+                    ) {
+                        found = -1;
+                        break;
+                    }
+                    consumed += SignProtocol::FRAME_HEADER_SIZE + payloadSize;
+                    if (status != SignProtocol::Status::Ok) {
+                        signature.clear();
+                    }
+                    std::lock_guard< decltype(mutex) > lock(mutex);
+                    const auto request = pending.find(id);
+                    if (request != pending.end()) {
+                        request->second.set_value(std::move(signature));
+                        (void)pending.erase(request);
+                    }
+                }
+                if (found < 0) {
+                    break;
+                }
+                (void)buffer.erase(buffer.begin(), buffer.begin() + consumed);
+            }
+            FailPending();
+        }
+
+        /**
+         * This method sends requests to sign the given data chunks
+         * to the server.
+         *
+         * @param[in] keyName
+         *     This is the name of the key to use.
+         *
+         * @param[in] dataChunks
+         *     These point to the data chunks to sign.
+         *
+         * @return
+         *     Futures which will hold the signatures are returned.
+         */
+        std::vector< std::future< std::vector< uint8_t > > > SendRequests(
+            const std::string& keyName,
+            const std::vector< const std::vector< uint8_t >* >& dataChunks
+        ) {
+            std::vector< std::future< std::vector< uint8_t > > > futures;
+            std::vector< uint8_t > frames;
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                if (
+                    !connected
+                    || (keyName.size() > SignProtocol::MAX_KEY_NAME_SIZE)
+                ) {
+                    for (size_t i = 0; i < dataChunks.size(); ++i) {
+                        futures.push_back(FailedRequest());
+                    }
+                    return futures;
+                }
+                for (const auto data: dataChunks) {
+                    if (
+                        data->size() + keyName.size()
+                        > SignProtocol::MAX_PAYLOAD_SIZE - 5
+                    ) {
+                        futures.push_back(FailedRequest());
+                        continue;
+                    }
+                    const auto id = nextId++;
+                    auto& promise = pending[id];
+                    futures.push_back(promise.get_future());
+                    (void)SignProtocol::EncodeRequest(
+                        id,
+                        keyName,
+                        *data,
+                        frames
+                    );
+                }
+            }
+            std::lock_guard< decltype(writeMutex) > lock(writeMutex);
+            if (!SignProtocol::SendAll(sock, frames.data(), frames.size())) {
+                (void)shutdown(sock, SHUT_RDWR);
+            }
+            return futures;
+        }
+    };
+
+    SignClient::~SignClient() noexcept {
+        if (impl_ != nullptr) {
+            Disconnect();
+        }
+    }
+    SignClient::SignClient(SignClient&&) noexcept = default;
+    SignClient& SignClient::operator=(SignClient&&) noexcept = default;
+
+    SignClient::SignClient()
+        : impl_(new Impl())
+    {
+    }
+
+    bool SignClient::Connect(const std::string& socketPath) {
+        Disconnect();
+        struct sockaddr_un address;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        (void)memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        (void)memcpy(address.sun_path, socketPath.data(), socketPath.size());
+        impl_->sock = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (impl_->sock < 0) {
+            return false;
+        }
+        if (
+            connect(
+                impl_->sock,
+                (const struct sockaddr*)&address,
+                sizeof(address)
+            ) != 0
+        ) {
+            (void)close(impl_->sock);
+            impl_->sock = -1;
+            return false;
+        }
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            impl_->connected = true;
+        }
+        impl_->reader = std::thread(&Impl::ReaderThread, impl_.get());
+        return true;
+    }
+
+    void SignClient::Disconnect() {
+        if (impl_->sock < 0) {
+            return;
+        }
+        (void)shutdown(impl_->sock, SHUT_RDWR);
+        impl_->reader.join();
+        (void)close(impl_->sock);
+        impl_->sock = -1;
+    }
+
+    std::future< std::vector< uint8_t > > SignClient::operator()(
+        const std::string& keyName,
+        const std::vector< uint8_t >& data
+    ) {
+        auto futures = impl_->SendRequests(keyName, {&data});
+        return std::move(futures[0]);
+    }
+
+    std::vector< std::future< std::vector< uint8_t > > > SignClient::SignBatch(
+        const std::string& keyName,
+        const std::vector< std::vector< uint8_t > >& dataChunks
+    ) {
+        std::vector< const std::vector< uint8_t >* > dataChunkPointers;
+        dataChunkPointers.reserve(dataChunks.size());
+        for (const auto& data: dataChunks) {
+            dataChunkPointers.push_back(&data);
+        }
+        return impl_->SendRequests(keyName, dataChunkPointers);
+    }
+
+}
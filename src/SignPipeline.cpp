@@ -0,0 +1,213 @@
+/**
+ * @file SignPipeline.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::SignPipeline class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Sha256.hpp"
+#include "SpscQueue.hpp"
+
+#include <atomic>
+#include <CryptoSigning/SignPipeline.hpp>
+#include <thread>
+#include <utility>
+
+namespace {
+
+    /**
+     * This holds one data chunk which has been digested and is waiting
+     * to be signed.
+     */
+    struct DigestedData {
+        /**
+         * This is the data chunk to cryptographically sign.  It's kept
+         * for keys which can't sign digests.
+         */
+        std::vector< uint8_t > data;
+
+        /**
+         * This is the SHA-256 digest of the data chunk.
+         */
+        std::vector< uint8_t > digest;
+    };
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a SignPipeline instance.
+     */
+    struct SignPipeline::Impl {
+        /**
+         * This is the configured instance to use to sign data.
+         */
+        std::shared_ptr< Sign > sign;
+
+        /**
+         * This holds data chunks waiting to be digested.
+         */
+        std::unique_ptr< SpscQueue< std::vector< uint8_t > > > toDigest;
+
+        /**
+         * This holds digested data chunks waiting to be signed.
+         */
+        std::unique_ptr< SpscQueue< DigestedData > > toSign;
+
+        /**
+         * This holds signatures waiting to be taken out of the pipeline.
+         */
+        std::unique_ptr< SpscQueue< std::vector< uint8_t > > > signatures;
+
+        /**
+         * This is the thread which digests data chunks.
+         */
+        std::thread digestThread;
+
+        /**
+         * This is the thread which signs digested data chunks.
+         */
+        std::thread signThread;
+
+        /**
+         * This indicates whether or not the pipeline is running.
+         */
+        std::atomic< bool > running{false};
+
+        // Methods
+
+        ~Impl() noexcept {
+            Stop();
+        }
+
+        /**
+         * This method checks whether or not threads waiting on the
+         * queues should give up.
+         *
+         * @return
+         *     An indication of whether or not threads waiting on the
+         *     queues should give up is returned.
+         */
+        bool Stopped() const {
+            return !running;
+        }
+
+        /**
+         * This method stops the threads which carry out the stages
+         * of the pipeline.
+         */
+        void Stop() {
+            running = false;
+            if (toDigest != nullptr) {
+                toDigest->WakeAll();
+                toSign->WakeAll();
+                signatures->WakeAll();
+            }
+            if (digestThread.joinable()) {
+                digestThread.join();
+            }
+            if (signThread.joinable()) {
+                signThread.join();
+            }
+        }
+
+        /**
+         * This method is the body of the thread which digests data chunks.
+         */
+        void DigestThread() {
+            const auto stopped = [this]{ return Stopped(); };
+            for (;;) {
+                DigestedData item;
+                if (!toDigest->Pop(item.data, stopped)) {
+                    break;
+                }
+                item.digest = Sha256(item.data);
+                if (!toSign->Push(item, stopped)) {
+                    break;
+                }
+            }
+        }
+
+        /**
+         * This method is the body of the thread which signs digested
+         * data chunks.
+         */
+        void SignThread() {
+            const auto stopped = [this]{ return Stopped(); };
+            for (;;) {
+                DigestedData item;
+                if (!toSign->Pop(item, stopped)) {
+                    break;
+                }
+                std::vector< uint8_t > signature;
+                if (sign != nullptr) {
+                    signature = sign->SignDigest(item.digest);
+                    if (signature.empty()) {
+                        signature = (*sign)(item.data);
+                    }
+                }
+                if (!signatures->Push(signature, stopped)) {
+                    break;
+                }
+            }
+        }
+    };
+
+    SignPipeline::~SignPipeline() noexcept = default;
+    SignPipeline::SignPipeline(SignPipeline&&) noexcept = default;
+    SignPipeline& SignPipeline::operator=(SignPipeline&&) noexcept = default;
+
+    SignPipeline::SignPipeline()
+        : impl_(new Impl())
+    {
+    }
+
+    void SignPipeline::Start(
+        std::shared_ptr< Sign > sign,
+        size_t queueCapacity
+    ) {
+        impl_->Stop();
+        if (queueCapacity == 0) {
+            queueCapacity = 1;
+        }
+        impl_->sign = sign;
+        impl_->toDigest.reset(
+            new SpscQueue< std::vector< uint8_t > >(queueCapacity)
+        );
+        impl_->toSign.reset(new SpscQueue< DigestedData >(queueCapacity));
+        impl_->signatures.reset(
+            new SpscQueue< std::vector< uint8_t > >(queueCapacity)
+        );
+        impl_->running = true;
+        impl_->digestThread = std::thread(&Impl::DigestThread, impl_.get());
+        impl_->signThread = std::thread(&Impl::SignThread, impl_.get());
+    }
+
+    void SignPipeline::Stop() {
+        impl_->Stop();
+    }
+
+    bool SignPipeline::Push(std::vector< uint8_t > data) {
+        if (impl_->Stopped()) {
+            return false;
+        }
+        return impl_->toDigest->Push(
+            data,
+            [this]{ return impl_->Stopped(); }
+        );
+    }
+
+    bool SignPipeline::Pop(std::vector< uint8_t >& signature) {
+        if (impl_->Stopped()) {
+            return false;
+        }
+        return impl_->signatures->Pop(
+            signature,
+            [this]{ return impl_->Stopped(); }
+        );
+    }
+
+}
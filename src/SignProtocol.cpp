@@ -0,0 +1,164 @@
+/**
+ * @file SignProtocol.cpp
+ *
+ * This module contains the implementation of the framing used between
+ * the CryptoSigning::SignClient and CryptoSigning::SignServer classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "SignProtocol.hpp"
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace {
+
+    /**
+     * This function appends the given 32-bit value to the given buffer,
+     * in big-endian order.
+     *
+     * @param[in] value
+     *     This is the value to append.
+     *
+     * @param[in,out] buffer
+     *     This is the buffer to which to append the value.
+     */
+    void PutUint32(uint32_t value, std::vector< uint8_t >& buffer) {
+        buffer.push_back((uint8_t)(value >> 24));
+        buffer.push_back((uint8_t)(value >> 16));
+        buffer.push_back((uint8_t)(value >> 8));
+        buffer.push_back((uint8_t)value);
+    }
+
+    /**
+     * This function reads a 32-bit big-endian value from the given memory.
+     *
+     * @param[in] data
+     *     This points to the value to read.
+     *
+     * @return
+     *     The value read is returned.
+     */
+    uint32_t GetUint32(const uint8_t* data) {
+        return (
+            ((uint32_t)data[0] << 24)
+            | ((uint32_t)data[1] << 16)
+            | ((uint32_t)data[2] << 8)
+            | (uint32_t)data[3]
+        );
+    }
+
+}
+
+namespace CryptoSigning {
+
+    namespace SignProtocol {
+
+        bool EncodeRequest(
+            uint32_t id,
+            const std::string& keyName,
+            const std::vector< uint8_t >& data,
+            std::vector< uint8_t >& buffer
+        ) {
+            if (keyName.size() > MAX_KEY_NAME_SIZE) {
+                return false;
+            }
+            PutUint32((uint32_t)(4 + 1 + keyName.size() + data.size()), buffer);
+            PutUint32(id, buffer);
+            buffer.push_back((uint8_t)keyName.size());
+            buffer.insert(buffer.end(), keyName.begin(), keyName.end());
+            buffer.insert(buffer.end(), data.begin(), data.end());
+            return true;
+        }
+
+        bool DecodeRequest(
+            const uint8_t* payload,
+            size_t size,
+            uint32_t& id,
+            std::string& keyName,
+            std::vector< uint8_t >& data
+        ) {
+            if (size < 5) {
+                return false;
+            }
+            id = GetUint32(payload);
+            const size_t keyNameSize = payload[4];
+            if (size < 5 + keyNameSize) {
+                return false;
+            }
+            keyName.assign((const char*)payload + 5, keyNameSize);
+            data.assign(payload + 5 + keyNameSize, payload + size);
+            return true;
+        }
+
+        void EncodeResponse(
+            uint32_t id,
+            Status status,
+            const std::vector< uint8_t >& signature,
+            std::vector< uint8_t >& buffer
+        ) {
+            PutUint32((uint32_t)(4 + 1 + signature.size()), buffer);
+            PutUint32(id, buffer);
+            buffer.push_back((uint8_t)status);
+            buffer.insert(buffer.end(), signature.begin(), signature.end());
+        }
+
+        bool DecodeResponse(
+            const uint8_t* payload,
+            size_t size,
+            uint32_t& id,
+            Status& status,
+            std::vector< uint8_t >& signature
+        ) {
+            if (size < 5) {
+                return false;
+            }
+            id = GetUint32(payload);
+            status = (Status)payload[4];
+            signature.assign(payload + 5, payload + size);
+            return true;
+        }
+
+        int FindFrame(
+            const uint8_t* buffer,
+            size_t size,
+            size_t& payloadSize
+        ) {
+            if (size < FRAME_HEADER_SIZE) {
+                return 0;
+            }
+            payloadSize = GetUint32(buffer);
+            if (payloadSize > MAX_PAYLOAD_SIZE) {
+                return -1;
+            }
+            if (size < FRAME_HEADER_SIZE + payloadSize) {
+                return 0;
+            }
+            return 1;
+        }
+
+        bool SendAll(int sock, const uint8_t* data, size_t size) {
+#ifdef MSG_NOSIGNAL
+            const int flags = MSG_NOSIGNAL;
+#else
+            const int flags = 0;
+#endif
+            while (size > 0) {
+                const auto amount = send(sock, data, size, flags);
+                if (amount < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                data += amount;
+                size -= (size_t)amount;
+            }
+            return true;
+        }
+
+    }
+
+}
@@ -0,0 +1,227 @@
+#ifndef CRYPTO_SIGNING_SIGN_PROTOCOL_HPP
+#define CRYPTO_SIGNING_SIGN_PROTOCOL_HPP
+
+/**
+ * @file SignProtocol.hpp
+ *
+ * This module declares the framing used between the
+ * CryptoSigning::SignClient and CryptoSigning::SignServer classes.
+ *
+ * Every message is a frame made up of a 32-bit big-endian payload length
+ * followed by the payload.
+ *
+ * A request payload is a 32-bit big-endian request identifier, an 8-bit
+ * key name length, the key name, and then the data to sign.
+ *
+ * A response payload is the 32-bit big-endian identifier of the request
+ * it answers, an 8-bit status code, and then the signature (if the
+ * status is OK).
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace CryptoSigning {
+
+    namespace SignProtocol {
+
+        /**
+         * This is the size of the length prefix of each frame.
+         */
+        constexpr size_t FRAME_HEADER_SIZE = 4;
+
+        /**
+         * This is the largest payload accepted in a frame.  Larger frames
+         * cause the connection to be dropped.
+         */
+        constexpr size_t MAX_PAYLOAD_SIZE = 16 * 1024 * 1024;
+
+        /**
+         * This is the longest key name which may be given in a request.
+         */
+        constexpr size_t MAX_KEY_NAME_SIZE = 255;
+
+        /**
+         * These are the status codes which may be given in a response.
+         */
+        enum class Status : uint8_t {
+            /**
+             * The data was signed, and the signature follows.
+             */
+            Ok = 0,
+
+            /**
+             * No key with the requested name is held by the server.
+             */
+            UnknownKey = 1,
+
+            /**
+             * The key failed to sign the data.
+             */
+            SignFailed = 2,
+        };
+
+        /**
+         * This function appends a request frame to the given buffer.
+         *
+         * @param[in] id
+         *     This is the identifier of the request.
+         *
+         * @param[in] keyName
+         *     This is the name of the key with which to sign the data.
+         *     It may not be longer than MAX_KEY_NAME_SIZE characters.
+         *
+         * @param[in] data
+         *     This is the data to sign.
+         *
+         * @param[in,out] buffer
+         *     This is the buffer to which to append the frame.
+         *
+         * @return
+         *     An indication of whether or not the request could be encoded
+         *     is returned.  If not, because the key name is too long,
+         *     nothing is appended to the buffer.
+         */
+        bool EncodeRequest(
+            uint32_t id,
+            const std::string& keyName,
+            const std::vector< uint8_t >& data,
+            std::vector< uint8_t >& buffer
+        );
+
+        /**
+         * This function breaks down a request payload.
+         *
+         * @param[in] payload
+         *     This points to the request payload.
+         *
+         * @param[in] size
+         *     This is the size of the request payload.
+         *
+         * @param[out] id
+         *     This is where to store the identifier of the request.
+         *
+         * @param[out] keyName
+         *     This is where to store the name of the requested key.
+         *
+         * @param[out] data
+         *     This is where to store the data to sign.
+         *
+         * @return
+         *     An indication of whether or not the payload was a
+         *     well-formed request is returned.
+         */
+        bool DecodeRequest(
+            const uint8_t* payload,
+            size_t size,
+            uint32_t& id,
+            std::string& keyName,
+            std::vector< uint8_t >& data
+        );
+
+        /**
+         * This function appends a response frame to the given buffer.
+         *
+         * @param[in] id
+         *     This is the identifier of the request being answered.
+         *
+         * @param[in] status
+         *     This is the outcome of the request.
+         *
+         * @param[in] signature
+         *     This is the signature made for the request.
+         *
+         * @param[in,out] buffer
+         *     This is the buffer to which to append the frame.
+         */
+        void EncodeResponse(
+            uint32_t id,
+            Status status,
+            const std::vector< uint8_t >& signature,
+            std::vector< uint8_t >& buffer
+        );
+
+        /**
+         * This function breaks down a response payload.
+         *
+         * @param[in] payload
+         *     This points to the response payload.
+         *
+         * @param[in] size
+         *     This is the size of the response payload.
+         *
+         * @param[out] id
+         *     This is where to store the identifier of the request
+         *     being answered.
+         *
+         * @param[out] status
+         *     This is where to store the outcome of the request.
+         *
+         * @param[out] signature
+         *     This is where to store the signature made for the request.
+         *
+         * @return
+         *     An indication of whether or not the payload was a
+         *     well-formed response is returned.
+         */
+        bool DecodeResponse(
+            const uint8_t* payload,
+            size_t size,
+            uint32_t& id,
+            Status& status,
+            std::vector< uint8_t >& signature
+        );
+
+        /**
+         * This function looks for a complete frame at the front of the
+         * given buffer.
+         *
+         * @param[in] buffer
+         *     This points to the received data not yet consumed.
+         *
+         * @param[in] size
+         *     This is the number of bytes of received data not
+         *     yet consumed.
+         *
+         * @param[out] payloadSize
+         *     This is where to store the size of the payload of the frame.
+         *
+         * @return
+         *     If the buffer starts with a complete frame, 1 is returned.
+         *     If more data is needed, 0 is returned.  If the frame is
+         *     larger than allowed, -1 is returned.
+         */
+        int FindFrame(
+            const uint8_t* buffer,
+            size_t size,
+            size_t& payloadSize
+        );
+
+        /**
+         * This function writes all of the given data to the given socket,
+         * waiting as needed.
+         *
+         * @param[in] sock
+         *     This is the socket to which to write.
+         *
+         * @param[in] data
+         *     This points to the data to write.
+         *
+         * @param[in] size
+         *     This is the number of bytes to write.
+         *
+         * @return
+         *     An indication of whether or not all of the data was written
+         *     is returned.
+         */
+        bool SendAll(int sock, const uint8_t* data, size_t size);
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_SIGN_PROTOCOL_HPP */
@@ -0,0 +1,327 @@
+/**
+ * @file SignScheduler.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::SignScheduler class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <CryptoSigning/SignScheduler.hpp>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace {
+
+    /**
+     * This is the number of request classes.
+     */
+    constexpr size_t NUM_PRIORITIES = 3;
+
+    /**
+     * This holds one request waiting for a worker thread.
+     */
+    struct Request {
+        /**
+         * This is the data chunk to cryptographically sign.
+         */
+        std::vector< uint8_t > data;
+
+        /**
+         * This is the time by which a worker thread must take the
+         * request, after which it is dropped without being signed.
+         */
+        std::chrono::steady_clock::time_point deadline;
+
+        /**
+         * This is the time at which the request was queued.
+         */
+        std::chrono::steady_clock::time_point queued;
+
+        /**
+         * This is used to deliver the result of the request.
+         */
+        std::promise< CryptoSigning::SignResult > result;
+    };
+
+    /**
+     * This holds the requests of one class waiting for a worker thread,
+     * along with statistics about the class.
+     */
+    struct Queue {
+        /**
+         * These are the requests waiting for a worker thread,
+         * oldest first.
+         */
+        std::deque< Request > requests;
+
+        /**
+         * This is the number of requests whose data was signed.
+         */
+        size_t signedCount = 0;
+
+        /**
+         * This is the number of requests dropped because their deadlines
+         * passed while they were waiting in the queue.
+         */
+        size_t deadlineMissedCount = 0;
+
+        /**
+         * This is the number of requests whose data could not be signed.
+         */
+        size_t failedCount = 0;
+
+        /**
+         * This is the number of requests taken by worker threads.
+         */
+        size_t takenCount = 0;
+
+        /**
+         * This is the total time requests taken by worker threads
+         * waited in the queue.
+         */
+        std::chrono::microseconds totalWaitTime{0};
+
+        /**
+         * This is the longest time any request taken by a worker thread
+         * waited in the queue.
+         */
+        std::chrono::microseconds maxWaitTime{0};
+    };
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a SignScheduler instance.
+     */
+    struct SignScheduler::Impl {
+        /**
+         * This is the configured instance to use to sign data.
+         */
+        std::shared_ptr< Sign > sign;
+
+        /**
+         * These are the threads which sign data.
+         */
+        std::vector< std::thread > workers;
+
+        /**
+         * This is used to synchronize access to the queues.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake up worker threads when requests are queued
+         * or the worker threads should stop.
+         */
+        std::condition_variable wakeWorkers;
+
+        /**
+         * These are the queues of requests waiting for a worker thread,
+         * indexed by class, most urgent first.
+         */
+        Queue queues[NUM_PRIORITIES];
+
+        /**
+         * This indicates whether or not the worker threads should stop.
+         */
+        bool stopping = false;
+
+        // Methods
+
+        ~Impl() noexcept {
+            StopWorkers();
+            CancelQueued();
+        }
+
+        /**
+         * This method stops the worker threads, after they finish the
+         * requests they have already taken.
+         */
+        void StopWorkers() {
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                stopping = true;
+                wakeWorkers.notify_all();
+            }
+            for (auto& worker: workers) {
+                worker.join();
+            }
+            workers.clear();
+            stopping = false;
+        }
+
+        /**
+         * This method completes every request waiting in the queues
+         * with the Cancelled status.
+         */
+        void CancelQueued() {
+            std::deque< Request > cancelled;
+            {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                for (auto& queue: queues) {
+                    for (auto& request: queue.requests) {
+                        cancelled.push_back(std::move(request));
+                    }
+                    queue.requests.clear();
+                }
+            }
+            for (auto& request: cancelled) {
+                SignResult result;
+                result.status = SignStatus::Cancelled;
+                request.result.set_value(std::move(result));
+            }
+        }
+
+        /**
+         * This method returns the queue of the most urgent class which
+         * has requests waiting, if any.
+         *
+         * @return
+         *     The queue of the most urgent class which has requests waiting
+         *     is returned, or nullptr if no requests are waiting.
+         */
+        Queue* MostUrgentQueue() {
+            for (auto& queue: queues) {
+                if (!queue.requests.empty()) {
+                    return &queue;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * This method is the body of each worker thread.
+         */
+        void WorkerThread() {
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            for (;;) {
+                Queue* queue = nullptr;
+                wakeWorkers.wait(
+                    lock,
+                    [this, &queue]{
+                        queue = MostUrgentQueue();
+                        return stopping || (queue != nullptr);
+                    }
+                );
+                if (stopping) {
+                    break;
+                }
+                auto request = std::move(queue->requests.front());
+                queue->requests.pop_front();
+                const auto now = std::chrono::steady_clock::now();
+                SignResult result;
+                result.waitTime = (
+                    std::chrono::duration_cast< std::chrono::microseconds >(
+                        now - request.queued
+                    )
+                );
+                ++queue->takenCount;
+                queue->totalWaitTime += result.waitTime;
+                queue->maxWaitTime = std::max(
+                    queue->maxWaitTime,
+                    result.waitTime
+                );
+                if (now > request.deadline) {
+                    ++queue->deadlineMissedCount;
+                    lock.unlock();
+                    result.status = SignStatus::DeadlineMissed;
+                    request.result.set_value(std::move(result));
+                    lock.lock();
+                    continue;
+                }
+                const auto signer = sign;
+                lock.unlock();
+                if (signer != nullptr) {
+                    result.signature = (*signer)(request.data);
+                }
+                const auto success = !result.signature.empty();
+                result.status = (
+                    success
+                    ? SignStatus::Signed
+                    : SignStatus::Failed
+                );
+                lock.lock();
+                if (success) {
+                    ++queue->signedCount;
+                } else {
+                    ++queue->failedCount;
+                }
+                lock.unlock();
+                request.result.set_value(std::move(result));
+                lock.lock();
+            }
+        }
+    };
+
+    SignScheduler::~SignScheduler() noexcept = default;
+    SignScheduler::SignScheduler(SignScheduler&&) noexcept = default;
+    SignScheduler& SignScheduler::operator=(SignScheduler&&) noexcept = default;
+
+    SignScheduler::SignScheduler()
+        : impl_(new Impl())
+    {
+    }
+
+    void SignScheduler::Start(
+        std::shared_ptr< Sign > sign,
+        size_t workers
+    ) {
+        impl_->StopWorkers();
+        if (workers == 0) {
+            workers = std::max(
+                (size_t)std::thread::hardware_concurrency(),
+                (size_t)1
+            );
+        }
+        impl_->sign = sign;
+        for (size_t i = 0; i < workers; ++i) {
+            impl_->workers.emplace_back(&Impl::WorkerThread, impl_.get());
+        }
+    }
+
+    void SignScheduler::Stop() {
+        impl_->StopWorkers();
+        impl_->CancelQueued();
+    }
+
+    std::future< SignResult > SignScheduler::Submit(
+        const std::vector< uint8_t >& data,
+        SignPriority priority,
+        std::chrono::steady_clock::time_point deadline
+    ) {
+        Request request;
+        request.data = data;
+        request.deadline = deadline;
+        request.queued = std::chrono::steady_clock::now();
+        auto result = request.result.get_future();
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        impl_->queues[(size_t)priority].requests.push_back(std::move(request));
+        impl_->wakeWorkers.notify_one();
+        return result;
+    }
+
+    SignQueueMetrics SignScheduler::GetMetrics(SignPriority priority) {
+        std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+        const auto& queue = impl_->queues[(size_t)priority];
+        SignQueueMetrics metrics;
+        metrics.queueDepth = queue.requests.size();
+        metrics.signedCount = queue.signedCount;
+        metrics.deadlineMissedCount = queue.deadlineMissedCount;
+        metrics.failedCount = queue.failedCount;
+        if (queue.takenCount > 0) {
+            metrics.meanWaitTime = (
+                queue.totalWaitTime / (long long)queue.takenCount
+            );
+        }
+        metrics.maxWaitTime = queue.maxWaitTime;
+        return metrics;
+    }
+
+}
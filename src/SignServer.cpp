@@ -0,0 +1,742 @@
+/**
+ * @file SignServer.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::SignServer class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "SignProtocol.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <CryptoSigning/SignServer.hpp>
+#include <deque>
+#include <errno.h>
+#include <fcntl.h>
+#include <map>
+#include <mutex>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+    /**
+     * This is the most requests a worker thread takes from the queue
+     * at once.  Responses to requests taken together from the same
+     * connection are sent together.
+     */
+    constexpr size_t MAX_JOBS_PER_BATCH = 16;
+
+    /**
+     * This is the most requests from one connection which may be waiting
+     * for, or being handled by, a worker thread.  While a connection has
+     * this many, no more requests are read from it.
+     */
+    constexpr size_t MAX_JOBS_PER_CONNECTION = 64;
+
+    /**
+     * This is the most requests, from all connections together, which may
+     * be waiting for, or being handled by, a worker thread.  While there
+     * are this many, no more requests are read from any connection.
+     */
+    constexpr size_t MAX_JOBS = 1024;
+
+    /**
+     * This is the most response data which may be waiting to be sent to
+     * one client before no more requests are read from it.
+     */
+    constexpr size_t MAX_BUFFERED_OUTPUT = 1024 * 1024;
+
+    /**
+     * This is the number of bytes to try to read from a client
+     * at a time.
+     */
+    constexpr size_t READ_SIZE = 65536;
+
+    /**
+     * This holds the state of one connection with a client.
+     */
+    struct Connection {
+        /**
+         * This is the socket connected to the client.
+         */
+        int sock = -1;
+
+        /**
+         * This is used to synchronize access to the output buffer
+         * and the failed flag.
+         */
+        std::mutex outputMutex;
+
+        /**
+         * This holds responses which haven't yet been sent to the client
+         * because its socket wasn't ready to take them.
+         */
+        std::vector< uint8_t > outputBuffer;
+
+        /**
+         * This indicates whether or not sending to the client failed,
+         * in which case the connection is dropped.
+         */
+        bool failed = false;
+
+        /**
+         * This holds data received from the client which hasn't
+         * yet been broken down into requests.  It's only used by
+         * the I/O thread.
+         */
+        std::vector< uint8_t > inputBuffer;
+
+        /**
+         * This is the number of requests received on the connection
+         * which are waiting for, or being handled by, a worker thread.
+         * It's guarded by the server's mutex.
+         */
+        size_t outstandingJobs = 0;
+
+        // Methods
+
+        ~Connection() noexcept {
+            if (sock >= 0) {
+                (void)close(sock);
+            }
+        }
+
+        /**
+         * This method sends as much of the output buffer as the socket
+         * will take without waiting.  The output mutex must be held.
+         *
+         * @return
+         *     An indication of whether or not the connection is still
+         *     usable is returned.
+         */
+        bool Flush() {
+#ifdef MSG_NOSIGNAL
+            const int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+            const int flags = MSG_DONTWAIT;
+#endif
+            size_t sent = 0;
+            while (
+                !failed
+                && (sent < outputBuffer.size())
+            ) {
+                const auto amount = send(
+                    sock,
+                    outputBuffer.data() + sent,
+                    outputBuffer.size() - sent,
+                    flags
+                );
+                if (amount < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    if (
+                        (errno != EAGAIN)
+                        && (errno != EWOULDBLOCK)
+                    ) {
+                        failed = true;
+                    }
+                    break;
+                }
+                sent += (size_t)amount;
+            }
+            (void)outputBuffer.erase(
+                outputBuffer.begin(),
+                outputBuffer.begin() + sent
+            );
+            return !failed;
+        }
+    };
+
+    /**
+     * This holds one request to be handled by a worker thread.
+     */
+    struct Job {
+        /**
+         * This is the connection on which the request was received.
+         */
+        std::shared_ptr< Connection > connection;
+
+        /**
+         * This is the identifier of the request.
+         */
+        uint32_t id = 0;
+
+        /**
+         * This is the name of the key to use.
+         */
+        std::string keyName;
+
+        /**
+         * This is the data to sign.
+         */
+        std::vector< uint8_t > data;
+    };
+
+}
+
+namespace CryptoSigning {
+
+    /**
+     * This contains the private properties of a SignServer instance.
+     */
+    struct SignServer::Impl {
+        /**
+         * These are the keys held by the server, indexed by name.
+         */
+        std::map< std::string, std::shared_ptr< Sign > > keys;
+
+        /**
+         * This is the function to call if an error makes the server
+         * stop serving clients.
+         */
+        ErrorDelegate errorDelegate;
+
+        /**
+         * This is the path of the socket on which clients are accepted.
+         */
+        std::string socketPath;
+
+        /**
+         * This is the socket on which clients are accepted.
+         */
+        int listenSock = -1;
+
+        /**
+         * This is a pipe used to wake up the I/O thread when responses
+         * are ready to send, requests are finished, or the server is
+         * stopping.
+         */
+        int wakePipe[2] = {-1, -1};
+
+        /**
+         * This is the thread which accepts clients, reads their requests,
+         * and sends responses which couldn't be sent right away.
+         */
+        std::thread ioThread;
+
+        /**
+         * These are the threads which sign data.
+         */
+        std::vector< std::thread > workers;
+
+        /**
+         * This is used to synchronize access to the job queue
+         * and the counts of outstanding jobs.
+         */
+        std::mutex mutex;
+
+        /**
+         * This is used to wake up worker threads when jobs are queued
+         * or the server is stopping.
+         */
+        std::condition_variable wakeWorkers;
+
+        /**
+         * These are the requests waiting for a worker thread.
+         */
+        std::deque< Job > jobs;
+
+        /**
+         * This is the number of requests, from all connections, which
+         * are waiting for, or being handled by, a worker thread.
+         */
+        size_t outstandingJobs = 0;
+
+        /**
+         * This indicates whether or not the server is stopping.
+         */
+        bool stopping = false;
+
+        // Methods
+
+        /**
+         * This method closes the sockets and pipes held by the server.
+         */
+        void CloseAll() {
+            if (listenSock >= 0) {
+                (void)close(listenSock);
+                listenSock = -1;
+                (void)unlink(socketPath.c_str());
+            }
+            for (auto& end: wakePipe) {
+                if (end >= 0) {
+                    (void)close(end);
+                    end = -1;
+                }
+            }
+        }
+
+        /**
+         * This method wakes up the I/O thread.
+         */
+        void WakeIoThread() {
+            const uint8_t wake = 0;
+            (void)write(wakePipe[1], &wake, 1);
+        }
+
+        /**
+         * This method returns the number of requests which may be queued
+         * from the given connection without going over the limits on
+         * outstanding requests.
+         *
+         * @param[in] connection
+         *     This is the connection whose requests are to be queued.
+         *
+         * @return
+         *     The number of requests which may be queued is returned.
+         */
+        size_t GetJobAllowance(const Connection& connection) {
+            std::lock_guard< decltype(mutex) > lock(mutex);
+            return std::min(
+                MAX_JOBS_PER_CONNECTION - std::min(
+                    connection.outstandingJobs,
+                    MAX_JOBS_PER_CONNECTION
+                ),
+                MAX_JOBS - std::min(outstandingJobs, MAX_JOBS)
+            );
+        }
+
+        /**
+         * This method checks whether or not more data should be read
+         * from the given connection.  Reading stops while the connection
+         * is at the limit of outstanding requests, already holds a
+         * complete request which couldn't be queued, or has too many
+         * responses waiting to be sent.
+         *
+         * @param[in] connection
+         *     This is the connection to check.
+         *
+         * @return
+         *     An indication of whether or not more data should be read
+         *     from the connection is returned.
+         */
+        bool CanRead(Connection& connection) {
+            size_t payloadSize;
+            if (
+                (GetJobAllowance(connection) == 0)
+                || (
+                    SignProtocol::FindFrame(
+                        connection.inputBuffer.data(),
+                        connection.inputBuffer.size(),
+                        payloadSize
+                    ) != 0
+                )
+            ) {
+                return false;
+            }
+            std::lock_guard< std::mutex > outputLock(connection.outputMutex);
+            return (connection.outputBuffer.size() < MAX_BUFFERED_OUTPUT);
+        }
+
+        /**
+         * This method breaks down the requests received so far on the
+         * given connection and queues them for the worker threads, as far
+         * as the limits on outstanding requests allow.  Requests beyond
+         * the limits are left in the connection's input buffer.
+         *
+         * @param[in] connection
+         *     This is the connection on which the requests were received.
+         *
+         * @return
+         *     An indication of whether or not the requests were well-formed
+         *     is returned.
+         */
+        bool QueueRequests(const std::shared_ptr< Connection >& connection) {
+            auto& buffer = connection->inputBuffer;
+            const auto allowance = GetJobAllowance(*connection);
+            size_t consumed = 0;
+            std::vector< Job > newJobs;
+            while (newJobs.size() < allowance) {
+                size_t payloadSize;
+                const auto found = SignProtocol::FindFrame(
+                    buffer.data() + consumed,
+                    buffer.size() - consumed,
+                    payloadSize
+                );
+                if (found < 0) {
+                    return false;
+                } else if (found == 0) {
+                    break;
+                }
+                const auto payload = (
+                    buffer.data() + consumed + SignProtocol::FRAME_HEADER_SIZE
+                );
+                Job job;
+                job.connection = connection;
+                if (
+                    !SignProtocol::DecodeRequest(
+                        payload,
+                        payloadSize,
+                        job.id,
+                        job.keyName,
+                        job.data
+                    )
+                ) {
+                    return false;
+                }
+                newJobs.push_back(std::move(job));
+                consumed += SignProtocol::FRAME_HEADER_SIZE + payloadSize;
+            }
+            (void)buffer.erase(buffer.begin(), buffer.begin() + consumed);
+            if (!newJobs.empty()) {
+                std::lock_guard< decltype(mutex) > lock(mutex);
+                connection->outstandingJobs += newJobs.size();
+                outstandingJobs += newJobs.size();
+                for (auto& job: newJobs) {
+                    jobs.push_back(std::move(job));
+                }
+                wakeWorkers.notify_all();
+            }
+            return true;
+        }
+
+        /**
+         * This method reads whatever the client has sent on the given
+         * connection, and queues any complete requests.
+         *
+         * @param[in] connection
+         *     This is the connection from which to read.
+         *
+         * @param[in] readBuffer
+         *     This is the buffer to use to receive data.
+         *
+         * @return
+         *     An indication of whether or not the connection is still
+         *     usable is returned.
+         */
+        bool Receive(
+            const std::shared_ptr< Connection >& connection,
+            std::vector< uint8_t >& readBuffer
+        ) {
+            const auto amount = recv(
+                connection->sock,
+                readBuffer.data(),
+                readBuffer.size(),
+                MSG_DONTWAIT
+            );
+            if (amount < 0) {
+                return (
+                    (errno == EINTR)
+                    || (errno == EAGAIN)
+                    || (errno == EWOULDBLOCK)
+                );
+            } else if (amount == 0) {
+                return false;
+            }
+            connection->inputBuffer.insert(
+                connection->inputBuffer.end(),
+                readBuffer.begin(),
+                readBuffer.begin() + amount
+            );
+            return QueueRequests(connection);
+        }
+
+        /**
+         * This method is the body of the thread which accepts clients,
+         * reads their requests, and sends responses which couldn't be
+         * sent right away.
+         */
+        void IoThread() {
+            std::vector< std::shared_ptr< Connection > > connections;
+            std::vector< uint8_t > readBuffer(READ_SIZE);
+            for (;;) {
+                // Queue requests held back earlier by the limits, now that
+                // some may have been handled, and decide what to wait for
+                // on each connection.
+                std::vector< std::shared_ptr< Connection > > survivors;
+                std::vector< struct pollfd > pollFds(2);
+                pollFds[0].fd = wakePipe[0];
+                pollFds[0].events = POLLIN;
+                pollFds[1].fd = listenSock;
+                pollFds[1].events = POLLIN;
+                for (const auto& connection: connections) {
+                    if (!QueueRequests(connection)) {
+                        continue;
+                    }
+                    struct pollfd pollFd;
+                    pollFd.fd = connection->sock;
+                    pollFd.events = 0;
+                    pollFd.revents = 0;
+                    if (CanRead(*connection)) {
+                        pollFd.events |= POLLIN;
+                    }
+                    {
+                        std::lock_guard< std::mutex > outputLock(
+                            connection->outputMutex
+                        );
+                        if (connection->failed) {
+                            continue;
+                        }
+                        if (!connection->outputBuffer.empty()) {
+                            pollFd.events |= POLLOUT;
+                        }
+                    }
+                    survivors.push_back(connection);
+                    pollFds.push_back(pollFd);
+                }
+                connections.swap(survivors);
+                if (poll(pollFds.data(), (nfds_t)pollFds.size(), -1) < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    const std::string message = (
+                        std::string("unable to wait for clients: ")
+                        + strerror(errno)
+                    );
+                    {
+                        std::lock_guard< decltype(mutex) > lock(mutex);
+                        stopping = true;
+                        jobs.clear();
+                        wakeWorkers.notify_all();
+                    }
+                    if (errorDelegate != nullptr) {
+                        errorDelegate(message);
+                    }
+                    break;
+                }
+                if (pollFds[0].revents != 0) {
+                    uint8_t drain[64];
+                    while (read(wakePipe[0], drain, sizeof(drain)) > 0) {
+                    }
+                    std::lock_guard< decltype(mutex) > lock(mutex);
+                    if (stopping) {
+                        break;
+                    }
+                }
+                survivors.clear();
+                for (size_t i = 0; i < connections.size(); ++i) {
+                    const auto& connection = connections[i];
+                    const auto& pollFd = pollFds[2 + i];
+                    if (pollFd.revents == 0) {
+                        survivors.push_back(connection);
+                        continue;
+                    }
+                    if ((pollFd.revents & POLLOUT) != 0) {
+                        std::lock_guard< std::mutex > outputLock(
+                            connection->outputMutex
+                        );
+                        if (!connection->Flush()) {
+                            continue;
+                        }
+                    }
+                    if ((pollFd.events & POLLIN) != 0) {
+                        if (
+                            ((pollFd.revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+                            && !Receive(connection, readBuffer)
+                        ) {
+                            continue;
+                        }
+                    } else if ((pollFd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0) {
+                        continue;
+                    }
+                    survivors.push_back(connection);
+                }
+                connections.swap(survivors);
+                if (pollFds[1].revents != 0) {
+                    const auto sock = accept(listenSock, NULL, NULL);
+                    if (sock >= 0) {
+                        connections.push_back(std::make_shared< Connection >());
+                        connections.back()->sock = sock;
+                    }
+                }
+            }
+            for (const auto& connection: connections) {
+                (void)shutdown(connection->sock, SHUT_RDWR);
+            }
+        }
+
+        /**
+         * This method is the body of each worker thread.
+         */
+        void WorkerThread() {
+            std::unique_lock< decltype(mutex) > lock(mutex);
+            for (;;) {
+                wakeWorkers.wait(
+                    lock,
+                    [this]{ return stopping || !jobs.empty(); }
+                );
+                if (stopping) {
+                    break;
+                }
+                std::vector< Job > batch;
+                while (
+                    !jobs.empty()
+                    && (batch.size() < MAX_JOBS_PER_BATCH)
+                ) {
+                    batch.push_back(std::move(jobs.front()));
+                    jobs.pop_front();
+                }
+                lock.unlock();
+                std::map< Connection*, std::vector< uint8_t > > responses;
+                for (const auto& job: batch) {
+                    std::vector< uint8_t > signature;
+                    auto status = SignProtocol::Status::Ok;
+                    const auto key = keys.find(job.keyName);
+                    if (key == keys.end()) {
+                        status = SignProtocol::Status::UnknownKey;
+                    } else {
+                        signature = (*key->second)(job.data);
+                        if (signature.empty()) {
+                            status = SignProtocol::Status::SignFailed;
+                        }
+                    }
+                    SignProtocol::EncodeResponse(
+                        job.id,
+                        status,
+                        signature,
+                        responses[job.connection.get()]
+                    );
+                }
+
+                // Send what each socket takes without waiting, leaving
+                // the rest for the I/O thread, so that a client which
+                // doesn't read its responses can't hold up a worker.
+                for (const auto& response: responses) {
+                    const auto connection = response.first;
+                    std::lock_guard< std::mutex > outputLock(
+                        connection->outputMutex
+                    );
+                    connection->outputBuffer.insert(
+                        connection->outputBuffer.end(),
+                        response.second.begin(),
+                        response.second.end()
+                    );
+                    (void)connection->Flush();
+                }
+                lock.lock();
+                for (const auto& job: batch) {
+                    --job.connection->outstandingJobs;
+                }
+                outstandingJobs -= batch.size();
+                WakeIoThread();
+            }
+        }
+    };
+
+    SignServer::~SignServer() noexcept {
+        if (impl_ != nullptr) {
+            Stop();
+        }
+    }
+    SignServer::SignServer(SignServer&&) noexcept = default;
+    SignServer& SignServer::operator=(SignServer&&) noexcept = default;
+
+    SignServer::SignServer()
+        : impl_(new Impl())
+    {
+    }
+
+    bool SignServer::AddKey(
+        const std::string& name,
+        std::shared_ptr< Sign > sign
+    ) {
+        if (impl_->ioThread.joinable()) {
+            return false;
+        }
+        impl_->keys[name] = sign;
+        return true;
+    }
+
+    bool SignServer::SetErrorDelegate(ErrorDelegate errorDelegate) {
+        if (impl_->ioThread.joinable()) {
+            return false;
+        }
+        impl_->errorDelegate = errorDelegate;
+        return true;
+    }
+
+    bool SignServer::Start(
+        const std::string& socketPath,
+        size_t workers
+    ) {
+        Stop();
+        struct sockaddr_un address;
+        if (socketPath.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        (void)memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        (void)memcpy(address.sun_path, socketPath.data(), socketPath.size());
+        impl_->listenSock = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (impl_->listenSock < 0) {
+            return false;
+        }
+        struct stat existing;
+        if (lstat(socketPath.c_str(), &existing) == 0) {
+            if (!S_ISSOCK(existing.st_mode)) {
+                (void)close(impl_->listenSock);
+                impl_->listenSock = -1;
+                return false;
+            }
+            (void)unlink(socketPath.c_str());
+        }
+
+        // Create the socket with permissions for the owner alone from the
+        // start, rather than narrowing them after it's already reachable.
+        const auto oldMask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+        const auto bound = bind(
+            impl_->listenSock,
+            (const struct sockaddr*)&address,
+            sizeof(address)
+        );
+        (void)umask(oldMask);
+        if (bound != 0) {
+            (void)close(impl_->listenSock);
+            impl_->listenSock = -1;
+            return false;
+        }
+        impl_->socketPath = socketPath;
+        if (
+            (listen(impl_->listenSock, SOMAXCONN) != 0)
+            || (pipe(impl_->wakePipe) != 0)
+            || (fcntl(impl_->wakePipe[0], F_SETFL, O_NONBLOCK) != 0)
+            || (fcntl(impl_->wakePipe[1], F_SETFL, O_NONBLOCK) != 0)
+        ) {
+            impl_->CloseAll();
+            return false;
+        }
+        impl_->stopping = false;
+        impl_->outstandingJobs = 0;
+        if (workers == 0) {
+            workers = std::max(
+                (size_t)std::thread::hardware_concurrency(),
+                (size_t)1
+            );
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            impl_->workers.emplace_back(&Impl::WorkerThread, impl_.get());
+        }
+        impl_->ioThread = std::thread(&Impl::IoThread, impl_.get());
+        return true;
+    }
+
+    void SignServer::Stop() {
+        {
+            std::lock_guard< decltype(impl_->mutex) > lock(impl_->mutex);
+            impl_->stopping = true;
+            impl_->jobs.clear();
+            impl_->wakeWorkers.notify_all();
+        }
+        if (impl_->ioThread.joinable()) {
+            impl_->WakeIoThread();
+            impl_->ioThread.join();
+        }
+        for (auto& worker: impl_->workers) {
+            worker.join();
+        }
+        impl_->workers.clear();
+        impl_->CloseAll();
+    }
+
+}
@@ -0,0 +1,192 @@
+/**
+ * @file SodiumBackend.cpp
+ *
+ * This module contains the implementation of the
+ * CryptoSigning::SodiumBackend functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "SodiumBackend.hpp"
+
+#include <sodium.h>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function initializes libsodium, once.
+     *
+     * @return
+     *     An indication of whether or not libsodium is ready
+     *     to use is returned.
+     */
+    bool InitializeSodium() {
+        static const bool initialized = (sodium_init() >= 0);
+        return initialized;
+    }
+
+    /**
+     * This function checks whether or not the given key is an Ed25519 key
+     * which libsodium can use.
+     *
+     * @param[in] key
+     *     This is the key to check.
+     *
+     * @return
+     *     An indication of whether or not the key is an Ed25519 key
+     *     which libsodium can use is returned.
+     */
+    bool IsSupported(EVP_PKEY* key) {
+#ifdef EVP_PKEY_ED25519
+        return (
+            InitializeSodium()
+            && (EVP_PKEY_base_id(key) == EVP_PKEY_ED25519)
+        );
+#else /* EVP_PKEY_ED25519 */
+        return false;
+#endif /* EVP_PKEY_ED25519 */
+    }
+
+    /**
+     * This makes Ed25519 signatures using libsodium.
+     */
+    struct SodiumSigner
+        : public CryptoSigning::Backend::Signer
+    {
+        // Properties
+
+        /**
+         * This is the expanded secret key, in the form libsodium uses.
+         */
+        uint8_t secretKey[crypto_sign_SECRETKEYBYTES];
+
+        // Methods
+
+        ~SodiumSigner() noexcept {
+            sodium_memzero(secretKey, sizeof(secretKey));
+        }
+
+        // CryptoSigning::Backend::Signer
+
+        virtual std::vector< uint8_t > Sign(
+            const uint8_t* data,
+            size_t length
+        ) override {
+            std::vector< uint8_t > signature(crypto_sign_BYTES);
+            unsigned long long signatureLength;
+            if (
+                crypto_sign_detached(
+                    signature.data(),
+                    &signatureLength,
+                    data,
+                    (unsigned long long)length,
+                    secretKey
+                ) != 0
+            ) {
+                return {};
+            }
+            signature.resize((size_t)signatureLength);
+            return signature;
+        }
+    };
+
+    /**
+     * This verifies Ed25519 signatures using libsodium.
+     */
+    struct SodiumVerifier
+        : public CryptoSigning::Backend::Verifier
+    {
+        // Properties
+
+        /**
+         * This is the public key.
+         */
+        uint8_t publicKey[crypto_sign_PUBLICKEYBYTES];
+
+        // CryptoSigning::Backend::Verifier
+
+        virtual bool Verify(
+            const uint8_t* data,
+            size_t dataLength,
+            const uint8_t* signature,
+            size_t signatureLength
+        ) override {
+            return (
+                (signatureLength == crypto_sign_BYTES)
+                && (
+                    crypto_sign_verify_detached(
+                        signature,
+                        data,
+                        (unsigned long long)dataLength,
+                        publicKey
+                    ) == 0
+                )
+            );
+        }
+    };
+
+}
+
+namespace CryptoSigning {
+
+    namespace SodiumBackend {
+
+        std::unique_ptr< Backend::Signer > MakeSigner(EVP_PKEY* key) {
+            if (!IsSupported(key)) {
+                return nullptr;
+            }
+#ifdef EVP_PKEY_ED25519
+            uint8_t seed[crypto_sign_SEEDBYTES];
+            size_t seedLength = sizeof(seed);
+            if (
+                (EVP_PKEY_get_raw_private_key(key, seed, &seedLength) != 1)
+                || (seedLength != sizeof(seed))
+            ) {
+                return nullptr;
+            }
+            std::unique_ptr< SodiumSigner > signer(new SodiumSigner());
+            uint8_t publicKey[crypto_sign_PUBLICKEYBYTES];
+            const auto generated = crypto_sign_seed_keypair(
+                publicKey,
+                signer->secretKey,
+                seed
+            );
+            sodium_memzero(seed, sizeof(seed));
+            if (generated != 0) {
+                return nullptr;
+            }
+            return std::move(signer);
+#else /* EVP_PKEY_ED25519 */
+            return nullptr;
+#endif /* EVP_PKEY_ED25519 */
+        }
+
+        std::unique_ptr< Backend::Verifier > MakeVerifier(EVP_PKEY* key) {
+            if (!IsSupported(key)) {
+                return nullptr;
+            }
+#ifdef EVP_PKEY_ED25519
+            std::unique_ptr< SodiumVerifier > verifier(new SodiumVerifier());
+            size_t publicKeyLength = sizeof(verifier->publicKey);
+            if (
+                (
+                    EVP_PKEY_get_raw_public_key(
+                        key,
+                        verifier->publicKey,
+                        &publicKeyLength
+                    ) != 1
+                )
+                || (publicKeyLength != sizeof(verifier->publicKey))
+            ) {
+                return nullptr;
+            }
+            return std::move(verifier);
+#else /* EVP_PKEY_ED25519 */
+            return nullptr;
+#endif /* EVP_PKEY_ED25519 */
+        }
+
+    }
+
+}
@@ -0,0 +1,50 @@
+#ifndef CRYPTO_SIGNING_SODIUM_BACKEND_HPP
+#define CRYPTO_SIGNING_SODIUM_BACKEND_HPP
+
+/**
+ * @file SodiumBackend.hpp
+ *
+ * This module declares the CryptoSigning::SodiumBackend functions,
+ * which carry out Ed25519 operations using libsodium.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "Backend.hpp"
+
+#include <memory>
+#include <openssl/evp.h>
+
+namespace CryptoSigning {
+
+    namespace SodiumBackend {
+
+        /**
+         * This function makes a signer for the given private key.
+         *
+         * @param[in] key
+         *     This is the private key to use.
+         *
+         * @return
+         *     The signer is returned, or nullptr if the key
+         *     isn't an Ed25519 key.
+         */
+        std::unique_ptr< Backend::Signer > MakeSigner(EVP_PKEY* key);
+
+        /**
+         * This function makes a verifier for the given key.
+         *
+         * @param[in] key
+         *     This is the public or private key to use.
+         *
+         * @return
+         *     The verifier is returned, or nullptr if the key
+         *     isn't an Ed25519 key.
+         */
+        std::unique_ptr< Backend::Verifier > MakeVerifier(EVP_PKEY* key);
+
+    }
+
+}
+
+#endif /* CRYPTO_SIGNING_SODIUM_BACKEND_HPP */
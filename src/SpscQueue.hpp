@@ -0,0 +1,329 @@
+#ifndef CRYPTO_SIGNING_SPSC_QUEUE_HPP
+#define CRYPTO_SIGNING_SPSC_QUEUE_HPP
+
+/**
+ * @file SpscQueue.hpp
+ *
+ * This module declares and defines the CryptoSigning::SpscQueue class
+ * template.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace CryptoSigning {
+
+    /**
+     * This is a bounded first-in, first-out queue which one thread puts
+     * items into while another thread takes them out, without locking.
+     *
+     * A thread which finds the queue full (or empty) may wait for the
+     * other thread to take (or put) an item.  Waiting threads spin
+     * briefly before going to sleep, and only then does the other
+     * thread need to take a lock to wake them up.
+     *
+     * @tparam T
+     *     This is the type of items held in the queue.
+     */
+    template< typename T > class SpscQueue {
+        // Lifecycle management
+    public:
+        ~SpscQueue() noexcept = default;
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue(SpscQueue&&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+        SpscQueue& operator=(SpscQueue&&) = delete;
+
+        // Public Methods
+    public:
+        /**
+         * This is the constructor.
+         *
+         * @param[in] capacity
+         *     This is the most items the queue can hold at once.
+         */
+        explicit SpscQueue(size_t capacity)
+            : slots_(capacity + 1)
+        {
+        }
+
+        /**
+         * This method puts the given item into the queue, if there's room.
+         * Only one thread may put items into the queue.
+         *
+         * @param[in,out] item
+         *     This is the item to put into the queue.  It's moved from
+         *     if there's room for it.
+         *
+         * @return
+         *     An indication of whether or not there was room for the item
+         *     is returned.
+         */
+        bool TryPush(T& item) {
+            if (!PushWithoutNotifying(item)) {
+                return false;
+            }
+            notEmpty_.Notify();
+            return true;
+        }
+
+        /**
+         * This method takes the oldest item out of the queue, if there
+         * are any.  Only one thread may take items out of the queue.
+         *
+         * @param[out] item
+         *     This is where to store the item taken out of the queue.
+         *
+         * @return
+         *     An indication of whether or not an item was taken out
+         *     of the queue is returned.
+         */
+        bool TryPop(T& item) {
+            if (!PopWithoutNotifying(item)) {
+                return false;
+            }
+            notFull_.Notify();
+            return true;
+        }
+
+        /**
+         * This method puts the given item into the queue, waiting for
+         * room if necessary.  Only one thread may put items into the queue.
+         *
+         * @param[in,out] item
+         *     This is the item to put into the queue.  It's moved from
+         *     if it's put into the queue.
+         *
+         * @param[in] cancel
+         *     This is the function to call to check whether or not
+         *     to give up waiting.
+         *
+         * @return
+         *     An indication of whether or not the item was put into
+         *     the queue is returned.  This is false if waiting was
+         *     cancelled.
+         */
+        template< typename Cancel > bool Push(
+            T& item,
+            Cancel cancel
+        ) {
+            bool pushed = false;
+            notFull_.Wait(
+                [&]{
+                    pushed = PushWithoutNotifying(item);
+                    return pushed || cancel();
+                }
+            );
+            if (pushed) {
+                notEmpty_.Notify();
+            }
+            return pushed;
+        }
+
+        /**
+         * This method takes the oldest item out of the queue, waiting
+         * for one if necessary.  Only one thread may take items out of
+         * the queue.
+         *
+         * @param[out] item
+         *     This is where to store the item taken out of the queue.
+         *
+         * @param[in] cancel
+         *     This is the function to call to check whether or not
+         *     to give up waiting.
+         *
+         * @return
+         *     An indication of whether or not an item was taken out of
+         *     the queue is returned.  This is false if waiting was
+         *     cancelled.
+         */
+        template< typename Cancel > bool Pop(
+            T& item,
+            Cancel cancel
+        ) {
+            bool popped = false;
+            notEmpty_.Wait(
+                [&]{
+                    popped = PopWithoutNotifying(item);
+                    return popped || cancel();
+                }
+            );
+            if (popped) {
+                notFull_.Notify();
+            }
+            return popped;
+        }
+
+        /**
+         * This method wakes up any thread waiting on the queue, so that
+         * it can check again whether or not to give up waiting.
+         */
+        void WakeAll() {
+            notEmpty_.Notify();
+            notFull_.Notify();
+        }
+
+        // Private Properties
+    private:
+        /**
+         * This is used by one thread to wait for a change made by
+         * another thread, without the other thread having to lock
+         * anything unless the first thread is actually asleep.
+         */
+        class Signal {
+        public:
+            /**
+             * This method waits until the given function returns true.
+             *
+             * @param[in] ready
+             *     This is the function to call to check whether or not
+             *     to stop waiting.
+             */
+            template< typename Ready > void Wait(Ready ready) {
+                for (size_t i = 0; i < SPINS_BEFORE_SLEEPING; ++i) {
+                    if (ready()) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+                std::unique_lock< decltype(mutex_) > lock(mutex_);
+                ++sleepers_;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wakeCondition_.wait(lock, ready);
+                --sleepers_;
+            }
+
+            /**
+             * This method wakes up the waiting thread, if it's asleep.
+             */
+            void Notify() {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (sleepers_.load(std::memory_order_relaxed) > 0) {
+                    std::lock_guard< decltype(mutex_) > lock(mutex_);
+                    wakeCondition_.notify_all();
+                }
+            }
+
+        private:
+            /**
+             * This is the number of times a waiting thread checks
+             * whether or not to stop waiting before going to sleep.
+             */
+            static constexpr size_t SPINS_BEFORE_SLEEPING = 64;
+
+            /**
+             * This is used to synchronize going to sleep and waking up.
+             */
+            std::mutex mutex_;
+
+            /**
+             * This is used to wake up the waiting thread.
+             */
+            std::condition_variable wakeCondition_;
+
+            /**
+             * This is the number of threads asleep waiting.
+             */
+            std::atomic< size_t > sleepers_{0};
+        };
+
+        /**
+         * This method puts the given item into the queue, if there's room,
+         * without waking up the thread taking items out of the queue.
+         *
+         * @param[in,out] item
+         *     This is the item to put into the queue.  It's moved from
+         *     if there's room for it.
+         *
+         * @return
+         *     An indication of whether or not there was room for the item
+         *     is returned.
+         */
+        bool PushWithoutNotifying(T& item) {
+            const auto tail = tail_.load(std::memory_order_relaxed);
+            const auto nextTail = Next(tail);
+            if (nextTail == head_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            slots_[tail] = std::move(item);
+            tail_.store(nextTail, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * This method takes the oldest item out of the queue, if there
+         * are any, without waking up the thread putting items into
+         * the queue.
+         *
+         * @param[out] item
+         *     This is where to store the item taken out of the queue.
+         *
+         * @return
+         *     An indication of whether or not an item was taken out
+         *     of the queue is returned.
+         */
+        bool PopWithoutNotifying(T& item) {
+            const auto head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = std::move(slots_[head]);
+            slots_[head] = T();
+            head_.store(Next(head), std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * This method returns the index of the slot after the given one.
+         *
+         * @param[in] index
+         *     This is the index of a slot.
+         *
+         * @return
+         *     The index of the slot after the given one is returned.
+         */
+        size_t Next(size_t index) const {
+            return (index + 1 == slots_.size()) ? 0 : index + 1;
+        }
+
+        /**
+         * These hold the items in the queue.  One slot is always left
+         * empty, to tell a full queue from an empty one.
+         */
+        std::vector< T > slots_;
+
+        /**
+         * This is the index of the slot holding the oldest item in the
+         * queue.  Only the thread taking items out of the queue changes it.
+         */
+        std::atomic< size_t > head_{0};
+
+        /**
+         * This is the index of the slot to hold the next item put into the
+         * queue.  Only the thread putting items into the queue changes it.
+         */
+        std::atomic< size_t > tail_{0};
+
+        /**
+         * This is used to wake up the thread taking items out of the queue
+         * when an item is put into it.
+         */
+        Signal notEmpty_;
+
+        /**
+         * This is used to wake up the thread putting items into the queue
+         * when an item is taken out of it.
+         */
+        Signal notFull_;
+    };
+
+}
+
+#endif /* CRYPTO_SIGNING_SPSC_QUEUE_HPP */
@@ -7,15 +7,35 @@
  * © 2018 by Richard Walters
  */
 
+#include "Backend.hpp"
+#include "Base64Url.hpp"
+#include "OpenSslBackend.hpp"
+#include "Parallel.hpp"
+#include "Sha256.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <CryptoSigning/Verify.hpp>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <openssl/bio.h>
-#include <openssl/bn.h>
 #include <openssl/evp.h>
-#include <openssl/rsa.h>
 #include <openssl/pem.h>
 #include <string>
+#include <string.h>
+
+namespace {
+
+    /**
+     * This is the size of the largest signature which is decoded
+     * into a buffer on the stack when verifying a JSON Web Signature.
+     * Larger signatures are decoded into a buffer on the heap instead.
+     */
+    constexpr size_t MAX_STACK_SIGNATURE_SIZE = 1024;
+
+}
 
 namespace CryptoSigning {
 
@@ -24,10 +44,259 @@ namespace CryptoSigning {
      */
     struct Verify::Impl {
         /**
-         * This is the public or private key, in PEM format, to use in
-         * verifying cryptographic signatures.
+         * This holds a key configured for the instance, along with the
+         * means of verifying signatures with it.
          */
-        std::unique_ptr< EVP_PKEY, std::function< void(EVP_PKEY*) > > key;
+        struct ActiveKey {
+            /**
+             * This is the public or private key to use in verifying
+             * cryptographic signatures.
+             */
+            std::unique_ptr<
+                EVP_PKEY,
+                std::function< void(EVP_PKEY*) >
+            > key;
+
+            /**
+             * This is used to verify signatures with the key.
+             */
+            std::unique_ptr< Backend::Verifier > verifier;
+        };
+
+        /**
+         * This holds the keys with which signatures are currently
+         * accepted.  Once published to readers, it is never modified;
+         * instead, a new one replaces it.
+         */
+        struct KeyState {
+            /**
+             * This is the key currently configured.
+             */
+            std::shared_ptr< ActiveKey > current;
+
+            /**
+             * This is the key which the current key replaced, if
+             * signatures made with it are still accepted.
+             */
+            std::shared_ptr< ActiveKey > previous;
+
+            /**
+             * This is the time after which signatures made with the
+             * previous key are no longer accepted.
+             */
+            std::chrono::steady_clock::time_point previousExpires;
+
+            // Methods
+
+            /**
+             * This method returns the key which the current key replaced,
+             * if signatures made with it are still accepted.
+             *
+             * @return
+             *     The key which the current key replaced is returned,
+             *     or nullptr if signatures made with it are no longer
+             *     accepted.
+             */
+            ActiveKey* GetPrevious() const {
+                if (
+                    (previous == nullptr)
+                    || (std::chrono::steady_clock::now() >= previousExpires)
+                ) {
+                    return nullptr;
+                }
+                return previous.get();
+            }
+
+            /**
+             * This method applies the given check to the current key and,
+             * if that fails, to the key which the current key replaced,
+             * if signatures made with it are still accepted.
+             *
+             * @param[in] check
+             *     This is the function to call to check a signature
+             *     with a key.
+             *
+             * @return
+             *     An indication of whether or not the check succeeded with
+             *     any key is returned.
+             */
+            template< typename Check > bool CheckAnyKey(Check check) const {
+                if (check(*current)) {
+                    return true;
+                }
+                const auto previousKey = GetPrevious();
+                return (
+                    (previousKey != nullptr)
+                    && check(*previousKey)
+                );
+            }
+        };
+
+        /**
+         * These are the keys with which signatures are currently accepted,
+         * if any.  It is only ever accessed through std::atomic_load and
+         * std::atomic_store, so that it can be replaced while other threads
+         * are using it.
+         */
+        std::shared_ptr< KeyState > state;
+
+        /**
+         * This is used to synchronize configuring the instance, so that
+         * the settings below can be changed while another thread is
+         * configuring a key.  Verifying signatures doesn't use it.
+         */
+        std::mutex configMutex;
+
+        /**
+         * This is the name of the backend to use, or an empty string
+         * to use the most preferred backend which supports the key.
+         */
+        std::string backendName;
+
+        /**
+         * This is how long signatures made with a key continue to be
+         * accepted after the key is replaced.
+         */
+        std::chrono::milliseconds rotationGracePeriod{0};
+
+        // Methods
+
+        /**
+         * This method takes a snapshot of the keys with which signatures
+         * are currently accepted.  The keys remain usable through the
+         * snapshot even if they're replaced in the meantime.
+         *
+         * @return
+         *     The keys with which signatures are currently accepted are
+         *     returned, or nullptr if no key is configured.
+         */
+        std::shared_ptr< KeyState > GetState() const {
+            return std::atomic_load(&state);
+        }
+
+        /**
+         * This method sets up the instance to use the given key.
+         * The configuration mutex must be held.
+         *
+         * @param[in] newKey
+         *     This is the key to use.
+         *
+         * @return
+         *     An indication of whether or not the instance was
+         *     successfully set up to use the key is returned.
+         */
+        bool UseKey(
+            std::unique_ptr< EVP_PKEY, std::function< void(EVP_PKEY*) > > newKey
+        ) {
+            std::shared_ptr< ActiveKey > current(new ActiveKey());
+            current->verifier = Backend::MakeVerifier(
+                backendName,
+                newKey.get()
+            );
+            if (current->verifier == nullptr) {
+                return false;
+            }
+            current->key = std::move(newKey);
+            std::shared_ptr< KeyState > newState(new KeyState());
+            newState->current = std::move(current);
+            const auto oldState = GetState();
+            if (
+                (oldState != nullptr)
+                && (rotationGracePeriod > std::chrono::milliseconds::zero())
+            ) {
+                newState->previous = oldState->current;
+                newState->previousExpires = (
+                    std::chrono::steady_clock::now() + rotationGracePeriod
+                );
+            }
+            std::atomic_store(&state, newState);
+            return true;
+        }
+
+        /**
+         * This method verifies the given RS256 JSON Web Signature, in
+         * compact serialization, with the given key.
+         *
+         * @param[in] activeKey
+         *     This is the key to use.
+         *
+         * @param[in] token
+         *     This points to the token to verify.
+         *
+         * @param[in] tokenLength
+         *     This is the length of the token, in bytes.
+         *
+         * @return
+         *     An indication of whether or not the token is well-formed
+         *     and its signature matches the key is returned.
+         */
+        static bool VerifyJwsCompact(
+            ActiveKey& activeKey,
+            const char* token,
+            size_t tokenLength
+        ) {
+            if (EVP_PKEY_base_id(activeKey.key.get()) != EVP_PKEY_RSA) {
+                return false;
+            }
+            const auto end = token + tokenLength;
+            const auto firstPeriod = (const char*)memchr(
+                token,
+                '.',
+                tokenLength
+            );
+            if (firstPeriod == NULL) {
+                return false;
+            }
+            const auto secondPeriod = (const char*)memchr(
+                firstPeriod + 1,
+                '.',
+                end - (firstPeriod + 1)
+            );
+            if (secondPeriod == NULL) {
+                return false;
+            }
+            const auto encodedSignature = secondPeriod + 1;
+            const size_t encodedSignatureLength = end - encodedSignature;
+            const auto signatureLength = (size_t)EVP_PKEY_size(
+                activeKey.key.get()
+            );
+            if (
+                (firstPeriod == token)
+                || !Base64Url::IsValid(token, firstPeriod - token)
+                || !Base64Url::IsValid(
+                    firstPeriod + 1,
+                    secondPeriod - (firstPeriod + 1)
+                )
+                || (
+                    Base64Url::DecodedLength(encodedSignatureLength)
+                    != signatureLength
+                )
+            ) {
+                return false;
+            }
+            uint8_t stackBuffer[MAX_STACK_SIGNATURE_SIZE];
+            std::vector< uint8_t > heapBuffer;
+            auto signature = stackBuffer;
+            if (signatureLength > sizeof(stackBuffer)) {
+                heapBuffer.resize(signatureLength);
+                signature = heapBuffer.data();
+            }
+            if (
+                !Base64Url::Decode(
+                    encodedSignature,
+                    encodedSignatureLength,
+                    signature
+                )
+            ) {
+                return false;
+            }
+            return activeKey.verifier->Verify(
+                (const uint8_t*)token,
+                secondPeriod - token,
+                signature,
+                signatureLength
+            );
+        }
     };
 
     Verify::~Verify() noexcept = default;
@@ -79,70 +348,198 @@ namespace CryptoSigning {
         if (key == NULL) {
             return false;
         }
-        impl_->key = std::move(key);
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        return impl_->UseKey(std::move(key));
+    }
+
+    bool Verify::SetBackend(const std::string& backendName) {
+        if (!Backend::IsKnown(backendName)) {
+            return false;
+        }
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        impl_->backendName = backendName;
         return true;
     }
 
+    void Verify::SetRotationGracePeriod(std::chrono::milliseconds gracePeriod) {
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        impl_->rotationGracePeriod = gracePeriod;
+    }
+
     void Verify::Configure(
         const uint8_t* keyModulus,
         size_t keyModulusLength,
         const uint8_t* keyExponent,
         size_t keyExponentLength
     ) {
-        BIGNUM* n = BN_bin2bn(keyModulus, (int)keyModulusLength, NULL);
-        BIGNUM* e = BN_bin2bn(keyExponent, (int)keyExponentLength, NULL);
-        RSA* rsa = RSA_new();
-        RSA_set0_key(rsa, n, e, NULL);
-        std::unique_ptr< EVP_PKEY, std::function< void(EVP_PKEY*) > > key(
-            EVP_PKEY_new(),
-            [](EVP_PKEY* p){
-                EVP_PKEY_free(p);
-            }
-        );
-        EVP_PKEY_assign_RSA(key.get(), rsa);
-        impl_->key = std::move(key);
+        std::lock_guard< decltype(impl_->configMutex) > lock(impl_->configMutex);
+        if (
+            !impl_->UseKey(
+                OpenSslBackend::MakeRsaPublicKey(
+                    keyModulus,
+                    keyModulusLength,
+                    keyExponent,
+                    keyExponentLength
+                )
+            )
+        ) {
+            // Fail closed, rather than leave the replaced key in use.
+            std::atomic_store(
+                &impl_->state,
+                std::shared_ptr< Impl::KeyState >()
+            );
+        }
     }
 
     bool Verify::operator()(
         const std::vector< uint8_t >& data,
         const std::vector< uint8_t >& signature
     ) {
-        if (impl_->key == nullptr) {
+        return (*this)(
+            data.data(),
+            data.size(),
+            signature.data(),
+            signature.size()
+        );
+    }
+
+    bool Verify::operator()(
+        const uint8_t* data,
+        size_t dataLength,
+        const uint8_t* signature,
+        size_t signatureLength
+    ) {
+        const auto state = impl_->GetState();
+        if (state == nullptr) {
             return false;
         }
-        std::unique_ptr< EVP_MD_CTX, std::function< void(EVP_MD_CTX*) > > ctx(
-            EVP_MD_CTX_create(),
-            [](EVP_MD_CTX* p) {
-                EVP_MD_CTX_free(p);
+        return state->CheckAnyKey(
+            [&](Impl::ActiveKey& activeKey){
+                return activeKey.verifier->Verify(
+                    data,
+                    dataLength,
+                    signature,
+                    signatureLength
+                );
             }
         );
+    }
+
+    bool Verify::VerifyDigest(
+        const std::vector< uint8_t >& digest,
+        const std::vector< uint8_t >& signature
+    ) {
+        const auto state = impl_->GetState();
         if (
-            EVP_DigestVerifyInit(
-                ctx.get(),
-                NULL,
-                EVP_sha256(),
-                NULL,
-                impl_->key.get()
-            ) <= 0
+            (state == nullptr)
+            || (digest.size() != SHA256_DIGEST_SIZE)
         ) {
             return false;
         }
-        if (
-            EVP_DigestVerifyUpdate(
-                ctx.get(),
-                data.data(),
-                data.size()
-            ) <= 0
-        ) {
+        return state->CheckAnyKey(
+            [&](Impl::ActiveKey& activeKey){
+                return activeKey.verifier->VerifyDigest(
+                    digest.data(),
+                    signature.data(),
+                    signature.size()
+                );
+            }
+        );
+    }
+
+    std::vector< bool > Verify::VerifyWithEach(
+        const std::vector< Verify* >& verifiers,
+        const std::vector< uint8_t >& data,
+        const std::vector< std::vector< uint8_t > >& signatures,
+        size_t workers
+    ) {
+        const auto digest = Sha256(data);
+
+        // Worker threads record results in bytes, since neighboring
+        // elements of a std::vector< bool > can't be set concurrently.
+        std::vector< char > results(verifiers.size(), 0);
+        RunInParallel(
+            std::min(verifiers.size(), signatures.size()),
+            workers,
+            [&](size_t index){
+                const auto verifier = verifiers[index];
+                if (verifier == nullptr) {
+                    return;
+                }
+                const auto state = verifier->impl_->GetState();
+                if (state == nullptr) {
+                    return;
+                }
+                const auto& signature = signatures[index];
+                results[index] = state->CheckAnyKey(
+                    [&](Impl::ActiveKey& activeKey){
+                        if (activeKey.verifier->SupportsDigests()) {
+                            return activeKey.verifier->VerifyDigest(
+                                digest.data(),
+                                signature.data(),
+                                signature.size()
+                            );
+                        } else {
+                            return activeKey.verifier->Verify(
+                                data.data(),
+                                data.size(),
+                                signature.data(),
+                                signature.size()
+                            );
+                        }
+                    }
+                );
+            }
+        );
+        return std::vector< bool >(results.begin(), results.end());
+    }
+
+    bool Verify::VerifyJwsCompact(
+        const char* token,
+        size_t tokenLength
+    ) {
+        const auto state = impl_->GetState();
+        if (state == nullptr) {
             return false;
         }
-        return (
-            EVP_DigestVerifyFinal(
-                ctx.get(),
-                signature.data(),
-                signature.size()
-            ) == 1
+        return state->CheckAnyKey(
+            [&](Impl::ActiveKey& activeKey){
+                return Impl::VerifyJwsCompact(activeKey, token, tokenLength);
+            }
+        );
+    }
+
+    bool Verify::VerifyJwsCompact(const std::string& token) {
+        return VerifyJwsCompact(token.data(), token.size());
+    }
+
+    std::vector< bool > Verify::VerifyBatch(
+        const std::vector< std::vector< uint8_t > >& dataChunks,
+        const std::vector< std::vector< uint8_t > >& signatures
+    ) {
+        const auto state = impl_->GetState();
+        if (state == nullptr) {
+            return std::vector< bool >(dataChunks.size(), false);
+        }
+        auto results = state->current->verifier->VerifyBatch(
+            dataChunks,
+            signatures
         );
+        const auto previous = state->GetPrevious();
+        if (previous == nullptr) {
+            return results;
+        }
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (!results[i] && (i < signatures.size())) {
+                results[i] = previous->verifier->Verify(
+                    dataChunks[i].data(),
+                    dataChunks[i].size(),
+                    signatures[i].data(),
+                    signatures[i].size()
+                );
+            }
+        }
+        return results;
     }
 
 }
@@ -0,0 +1,237 @@
+/**
+ * @file BackendTests.cpp
+ *
+ * This module contains the unit tests which run the CryptoSigning::Sign
+ * and CryptoSigning::Verify classes against every cryptographic backend
+ * built into the library.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <CryptoSigning/Backends.hpp>
+#include <CryptoSigning/KeyGen.hpp>
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/Verify.hpp>
+#include <gtest/gtest.h>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+    /**
+     * This function returns a key of the given kind, generating it
+     * the first time it's requested.
+     *
+     * @param[in] type
+     *     This is the kind of key to return.
+     *
+     * @return
+     *     The key is returned.
+     */
+    const CryptoSigning::GeneratedKey& GetKey(CryptoSigning::KeyType type) {
+        static std::map< CryptoSigning::KeyType, CryptoSigning::GeneratedKey > keys;
+        auto key = keys.find(type);
+        if (key == keys.end()) {
+            CryptoSigning::KeySpec spec;
+            spec.type = type;
+            key = keys.insert(
+                std::make_pair(type, CryptoSigning::GenerateKey(spec))
+            ).first;
+        }
+        return key->second;
+    }
+
+    /**
+     * This function returns whether or not the given backend is expected
+     * to support the given kind of key.
+     *
+     * @param[in] backendName
+     *     This is the name of the backend.
+     *
+     * @param[in] type
+     *     This is the kind of key.
+     *
+     * @return
+     *     An indication of whether or not the backend is expected
+     *     to support the kind of key is returned.
+     */
+    bool IsSupported(
+        const std::string& backendName,
+        CryptoSigning::KeyType type
+    ) {
+        return (
+            (backendName != "libsodium")
+            || (type == CryptoSigning::KeyType::Ed25519)
+        );
+    }
+
+    /**
+     * This function returns a name for the given test parameters,
+     * for use in test names.
+     *
+     * @param[in] info
+     *     This holds the test parameters.
+     *
+     * @return
+     *     The name for the test parameters is returned.
+     */
+    std::string ParameterName(
+        const ::testing::TestParamInfo<
+            std::tuple< std::string, CryptoSigning::KeyType >
+        >& info
+    ) {
+        static const std::map< CryptoSigning::KeyType, std::string > typeNames{
+            {CryptoSigning::KeyType::Rsa, "Rsa"},
+            {CryptoSigning::KeyType::EcP256, "EcP256"},
+            {CryptoSigning::KeyType::Ed25519, "Ed25519"},
+        };
+        return std::get< 0 >(info.param) + "_" + typeNames.at(std::get< 1 >(info.param));
+    }
+
+}
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct BackendTests
+    : public ::testing::TestWithParam<
+        std::tuple< std::string, CryptoSigning::KeyType >
+    >
+{
+    // Properties
+
+    /**
+     * This is the name of the backend under test.
+     */
+    std::string backendName;
+
+    /**
+     * This is the kind of key under test.
+     */
+    CryptoSigning::KeyType type = CryptoSigning::KeyType::Rsa;
+
+    /**
+     * This is the data chunk to sign in the tests.
+     */
+    const std::vector< uint8_t > dataChunk{
+        'H', 'e', 'l', 'l', 'o', ',', ' ', 'W', 'o', 'r', 'l', 'd', '!'
+    };
+
+    /**
+     * This is used to make signatures with the backend under test.
+     */
+    CryptoSigning::Sign sign;
+
+    /**
+     * This is used to verify signatures with the backend under test.
+     */
+    CryptoSigning::Verify verify;
+
+    // Methods
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        backendName = std::get< 0 >(GetParam());
+        type = std::get< 1 >(GetParam());
+        ASSERT_TRUE(sign.SetBackend(backendName));
+        ASSERT_TRUE(verify.SetBackend(backendName));
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_P(BackendTests, ConfigureOnlySupportedKeys) {
+    const auto& key = GetKey(type);
+    ASSERT_TRUE(key.success);
+    EXPECT_EQ(IsSupported(backendName, type), sign.Configure(key.privateKeyPem));
+    EXPECT_EQ(IsSupported(backendName, type), verify.Configure(key.publicKeyPem));
+}
+
+TEST_P(BackendTests, SignAndVerify) {
+    if (!IsSupported(backendName, type)) {
+        return;
+    }
+    const auto& key = GetKey(type);
+    ASSERT_TRUE(sign.Configure(key.privateKeyPem));
+    ASSERT_TRUE(verify.Configure(key.publicKeyPem));
+    const auto signature = sign(dataChunk);
+    ASSERT_FALSE(signature.empty());
+    EXPECT_TRUE(verify(dataChunk, signature));
+}
+
+TEST_P(BackendTests, RejectTamperedDataOrSignature) {
+    if (!IsSupported(backendName, type)) {
+        return;
+    }
+    const auto& key = GetKey(type);
+    ASSERT_TRUE(sign.Configure(key.privateKeyPem));
+    ASSERT_TRUE(verify.Configure(key.publicKeyPem));
+    const auto signature = sign(dataChunk);
+    auto tamperedData = dataChunk;
+    tamperedData[0] ^= 0x01;
+    EXPECT_FALSE(verify(tamperedData, signature));
+    auto tamperedSignature = signature;
+    tamperedSignature[tamperedSignature.size() / 2] ^= 0x01;
+    EXPECT_FALSE(verify(dataChunk, tamperedSignature));
+    EXPECT_FALSE(verify(dataChunk, {}));
+}
+
+TEST_P(BackendTests, InteroperateWithOtherBackends) {
+    if (!IsSupported(backendName, type)) {
+        return;
+    }
+    const auto& key = GetKey(type);
+    ASSERT_TRUE(sign.Configure(key.privateKeyPem));
+    ASSERT_TRUE(verify.Configure(key.publicKeyPem));
+    for (const auto& otherBackendName: CryptoSigning::GetBackendNames()) {
+        if (!IsSupported(otherBackendName, type)) {
+            continue;
+        }
+        CryptoSigning::Sign otherSign;
+        CryptoSigning::Verify otherVerify;
+        (void)otherSign.SetBackend(otherBackendName);
+        (void)otherVerify.SetBackend(otherBackendName);
+        ASSERT_TRUE(otherSign.Configure(key.privateKeyPem));
+        ASSERT_TRUE(otherVerify.Configure(key.publicKeyPem));
+        EXPECT_TRUE(otherVerify(dataChunk, sign(dataChunk))) << otherBackendName;
+        EXPECT_TRUE(verify(dataChunk, otherSign(dataChunk))) << otherBackendName;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllBackends,
+    BackendTests,
+    ::testing::Combine(
+        ::testing::ValuesIn(CryptoSigning::GetBackendNames()),
+        ::testing::Values(
+            CryptoSigning::KeyType::Rsa,
+            CryptoSigning::KeyType::EcP256,
+            CryptoSigning::KeyType::Ed25519
+        )
+    ),
+    ParameterName
+);
+
+TEST(BackendNamesTests, LibcryptoBackendAlwaysPresent) {
+    const auto backendNames = CryptoSigning::GetBackendNames();
+    ASSERT_FALSE(backendNames.empty());
+    EXPECT_TRUE(
+        (backendNames.back() == "OpenSSL")
+        || (backendNames.back() == "LibreSSL")
+    );
+}
+
+TEST(BackendNamesTests, SetUnknownBackend) {
+    CryptoSigning::Sign sign;
+    CryptoSigning::Verify verify;
+    EXPECT_FALSE(sign.SetBackend("NoSuchBackend"));
+    EXPECT_FALSE(verify.SetBackend("NoSuchBackend"));
+    EXPECT_TRUE(sign.SetBackend(""));
+    EXPECT_TRUE(verify.SetBackend(""));
+}
@@ -0,0 +1,130 @@
+/**
+ * @file BulkLoadTests.cpp
+ *
+ * This module contains the unit tests of the CryptoSigning::LoadSignKeys
+ * and CryptoSigning::LoadVerifyKeys functions.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <CryptoSigning/BulkLoad.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "TestKeys.hpp"
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct BulkLoadTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is a private key, not encrypted, in PEM format.
+     */
+    const std::string unencryptedKey = TestKeys::unencryptedKey;
+
+    /**
+     * This is the same private key, encrypted with a passphrase,
+     * in PEM format.
+     */
+    const std::string encryptedKey = TestKeys::encryptedKey;
+
+    /**
+     * This is the public key that corresponds to the private key,
+     * in PEM format.
+     */
+    const std::string publicKey = TestKeys::publicKey;
+
+    /**
+     * This is the passphrase used to encrypt the encrypted private key
+     * used by these tests.
+     */
+    const std::string correctPassphrase = TestKeys::correctPassphrase;
+
+    /**
+     * This is the test data to sign.
+     */
+    std::vector< uint8_t > dataChunk;
+
+    // Methods
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        const std::string data = "Hello, World!";
+        dataChunk.assign(
+            data.begin(),
+            data.end()
+        );
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(BulkLoadTests, LoadSignKeysReportsPerKeyResults) {
+    const auto results = CryptoSigning::LoadSignKeys(
+        {
+            {unencryptedKey, ""},
+            {encryptedKey, correctPassphrase},
+            {encryptedKey, "FeelsBadMan"},
+            {"This isn't a valid key.", ""},
+        },
+        2
+    );
+    ASSERT_EQ(4, results.size());
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[0].error.empty());
+    EXPECT_TRUE(results[1].success);
+    EXPECT_TRUE(results[1].error.empty());
+    EXPECT_FALSE(results[2].success);
+    EXPECT_FALSE(results[2].error.empty());
+    EXPECT_FALSE(results[3].success);
+    EXPECT_FALSE(results[3].error.empty());
+}
+
+TEST_F(BulkLoadTests, LoadedSignInstancesAreUsable) {
+    std::vector< CryptoSigning::SignKeySource > keys;
+    for (size_t i = 0; i < 8; ++i) {
+        keys.push_back({encryptedKey, correctPassphrase});
+    }
+    auto results = CryptoSigning::LoadSignKeys(keys, 3);
+    ASSERT_EQ(keys.size(), results.size());
+    CryptoSigning::Verify verify;
+    ASSERT_TRUE(verify.Configure(publicKey));
+    for (auto& result: results) {
+        ASSERT_TRUE(result.success);
+        EXPECT_TRUE(verify(dataChunk, result.sign(dataChunk)));
+    }
+}
+
+TEST_F(BulkLoadTests, LoadVerifyKeysReportsPerKeyResults) {
+    CryptoSigning::Sign sign;
+    ASSERT_TRUE(sign.Configure(unencryptedKey));
+    const auto signature = sign(dataChunk);
+    auto results = CryptoSigning::LoadVerifyKeys(
+        {
+            publicKey,
+            unencryptedKey,
+            "This isn't a valid key.",
+        }
+    );
+    ASSERT_EQ(3, results.size());
+    EXPECT_TRUE(results[0].success);
+    EXPECT_TRUE(results[0].verify(dataChunk, signature));
+    EXPECT_TRUE(results[1].success);
+    EXPECT_TRUE(results[1].verify(dataChunk, signature));
+    EXPECT_FALSE(results[2].success);
+    EXPECT_FALSE(results[2].error.empty());
+}
+
+TEST_F(BulkLoadTests, LoadNoKeys) {
+    EXPECT_TRUE(CryptoSigning::LoadSignKeys({}).empty());
+    EXPECT_TRUE(CryptoSigning::LoadVerifyKeys({}).empty());
+}
@@ -0,0 +1,239 @@
+/**
+ * @file ChainedSignTests.cpp
+ *
+ * This module contains the unit tests of the CryptoSigning::ChainedSign
+ * and CryptoSigning::ChainedVerify classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <chrono>
+#include <CryptoSigning/ChainedSign.hpp>
+#include <CryptoSigning/ChainedVerify.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestKeys.hpp"
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct ChainedSignTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the instance used to make signatures.
+     */
+    std::shared_ptr< CryptoSigning::Sign > sign = (
+        std::make_shared< CryptoSigning::Sign >()
+    );
+
+    /**
+     * This is the instance used to verify signatures.
+     */
+    std::shared_ptr< CryptoSigning::Verify > verify = (
+        std::make_shared< CryptoSigning::Verify >()
+    );
+
+    /**
+     * These are the segments of the test stream.
+     */
+    std::vector< std::vector< uint8_t > > segments;
+
+    // Methods
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+        ASSERT_TRUE(verify->Configure(TestKeys::publicKey));
+        for (size_t i = 0; i < 10; ++i) {
+            const std::string segment = "Segment " + std::to_string(i);
+            segments.emplace_back(segment.begin(), segment.end());
+        }
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(ChainedSignTests, SignatureIssuedEveryNSegments) {
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(sign, 3, std::chrono::milliseconds::zero());
+    std::vector< size_t > signedAfter;
+    std::vector< uint8_t > signature;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (
+            chainedSign(segments[i], signature)
+            == CryptoSigning::ChainedSign::Status::Signed
+        ) {
+            EXPECT_FALSE(signature.empty());
+            signedAfter.push_back(i);
+        } else {
+            EXPECT_TRUE(signature.empty());
+        }
+    }
+    EXPECT_EQ(
+        (std::vector< size_t >{2, 5, 8}),
+        signedAfter
+    );
+    EXPECT_EQ(segments.size(), chainedSign.GetSegments());
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::Signed,
+        chainedSign.Flush(signature)
+    );
+    EXPECT_FALSE(signature.empty());
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::NotDue,
+        chainedSign.Flush(signature)
+    );
+    EXPECT_TRUE(signature.empty());
+}
+
+TEST_F(ChainedSignTests, SignatureIssuedAfterInterval) {
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(sign, 0, std::chrono::milliseconds(20));
+    std::vector< uint8_t > signature;
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::NotDue,
+        chainedSign(segments[0], signature)
+    );
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::Signed,
+        chainedSign(segments[1], signature)
+    );
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::NotDue,
+        chainedSign(segments[2], signature)
+    );
+}
+
+TEST_F(ChainedSignTests, FailedSignatureLeavesSegmentsPending) {
+    const auto unconfiguredSign = std::make_shared< CryptoSigning::Sign >();
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(
+        unconfiguredSign,
+        2,
+        std::chrono::milliseconds::zero()
+    );
+    CryptoSigning::ChainedVerify chainedVerify;
+    chainedVerify.Configure(verify);
+    std::vector< uint8_t > signature;
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::NotDue,
+        chainedSign(segments[0], signature)
+    );
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::Failed,
+        chainedSign(segments[1], signature)
+    );
+    EXPECT_TRUE(signature.empty());
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::Failed,
+        chainedSign.Flush(signature)
+    );
+    ASSERT_TRUE(unconfiguredSign->Configure(TestKeys::unencryptedKey));
+    EXPECT_EQ(
+        CryptoSigning::ChainedSign::Status::Signed,
+        chainedSign(segments[2], signature)
+    );
+    for (size_t i = 0; i < 3; ++i) {
+        (void)chainedVerify(segments[i]);
+    }
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Verified,
+        chainedVerify.Checkpoint(signature)
+    );
+    EXPECT_EQ(3, chainedVerify.GetVerifiedSegments());
+}
+
+TEST_F(ChainedSignTests, VerifyStreamProgressively) {
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(sign, 4, std::chrono::milliseconds::zero());
+    CryptoSigning::ChainedVerify chainedVerify;
+    chainedVerify.Configure(verify, 4);
+    std::vector< uint8_t > signature;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        (void)chainedSign(segments[i], signature);
+        EXPECT_EQ(
+            CryptoSigning::ChainedVerify::Status::Pending,
+            chainedVerify(segments[i])
+        );
+        if (!signature.empty()) {
+            EXPECT_EQ(
+                CryptoSigning::ChainedVerify::Status::Verified,
+                chainedVerify.Checkpoint(signature)
+            );
+            EXPECT_EQ(i + 1, chainedVerify.GetVerifiedSegments());
+        }
+    }
+    EXPECT_EQ(8, chainedVerify.GetVerifiedSegments());
+    (void)chainedSign.Flush(signature);
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Verified,
+        chainedVerify.Checkpoint(signature)
+    );
+    EXPECT_EQ(segments.size(), chainedVerify.GetVerifiedSegments());
+}
+
+TEST_F(ChainedSignTests, TamperedSegmentFailsStream) {
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(sign, 2, std::chrono::milliseconds::zero());
+    CryptoSigning::ChainedVerify chainedVerify;
+    chainedVerify.Configure(verify);
+    std::vector< uint8_t > signature;
+    (void)chainedSign(segments[0], signature);
+    (void)chainedSign(segments[1], signature);
+    (void)chainedVerify(segments[0]);
+    (void)chainedVerify(segments[2]);
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Failed,
+        chainedVerify.Checkpoint(signature)
+    );
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Failed,
+        chainedVerify(segments[3])
+    );
+    EXPECT_EQ(0, chainedVerify.GetVerifiedSegments());
+}
+
+TEST_F(ChainedSignTests, ReorderedSegmentsFailStream) {
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(sign, 2, std::chrono::milliseconds::zero());
+    CryptoSigning::ChainedVerify chainedVerify;
+    chainedVerify.Configure(verify);
+    std::vector< uint8_t > signature;
+    (void)chainedSign(segments[0], signature);
+    (void)chainedSign(segments[1], signature);
+    (void)chainedVerify(segments[1]);
+    (void)chainedVerify(segments[0]);
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Failed,
+        chainedVerify.Checkpoint(signature)
+    );
+}
+
+TEST_F(ChainedSignTests, TooManyPendingSegmentsFailsStream) {
+    CryptoSigning::ChainedVerify chainedVerify;
+    chainedVerify.Configure(verify, 2);
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Pending,
+        chainedVerify(segments[0])
+    );
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Pending,
+        chainedVerify(segments[1])
+    );
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Failed,
+        chainedVerify(segments[2])
+    );
+}
@@ -0,0 +1,218 @@
+/**
+ * @file KeyGenTests.cpp
+ *
+ * This module contains the unit tests of the CryptoSigning::GenerateKey
+ * function and the CryptoSigning::KeyPool class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <atomic>
+#include <chrono>
+#include <CryptoSigning/KeyGen.hpp>
+#include <CryptoSigning/KeyPool.hpp>
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct KeyGenTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the data chunk to sign in the tests.
+     */
+    const std::vector< uint8_t > dataChunk{'H', 'e', 'l', 'l', 'o'};
+
+    // Methods
+
+    /**
+     * This method checks that the given generated key can be used
+     * to make and verify signatures.
+     *
+     * @param[in] key
+     *     This is the key to check.
+     */
+    void ExpectUsable(CryptoSigning::GeneratedKey& key) {
+        ASSERT_TRUE(key.success);
+        const auto signature = key.sign(dataChunk);
+        ASSERT_FALSE(signature.empty());
+        EXPECT_TRUE(key.verify(dataChunk, signature));
+        CryptoSigning::Verify verify;
+        ASSERT_TRUE(verify.Configure(key.publicKeyPem));
+        EXPECT_TRUE(verify(dataChunk, signature));
+        CryptoSigning::Sign sign;
+        EXPECT_TRUE(sign.Configure(key.privateKeyPem));
+    }
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(KeyGenTests, GenerateRsaKey) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Rsa;
+    spec.bits = 2048;
+    auto key = CryptoSigning::GenerateKey(spec);
+    ExpectUsable(key);
+    EXPECT_NE(std::string::npos, key.publicKeyPem.find("BEGIN PUBLIC KEY"));
+    EXPECT_NE(std::string::npos, key.privateKeyPem.find("BEGIN PRIVATE KEY"));
+}
+
+TEST_F(KeyGenTests, GenerateEcP256Key) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    auto key = CryptoSigning::GenerateKey(spec);
+    ExpectUsable(key);
+}
+
+TEST_F(KeyGenTests, GeneratedKeysDiffer) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    const auto first = CryptoSigning::GenerateKey(spec);
+    const auto second = CryptoSigning::GenerateKey(spec);
+    EXPECT_NE(first.privateKeyPem, second.privateKeyPem);
+}
+
+TEST_F(KeyGenTests, GenerateInvalidRsaKey) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Rsa;
+    spec.bits = 16;
+    const auto key = CryptoSigning::GenerateKey(spec);
+    EXPECT_FALSE(key.success);
+}
+
+TEST_F(KeyGenTests, GenerateMultiPrimeRsaKey) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Rsa;
+    spec.bits = 2048;
+    spec.primes = 3;
+    auto key = CryptoSigning::GenerateKey(spec);
+    ExpectUsable(key);
+}
+
+TEST_F(KeyGenTests, GenerateRsaKeyWithTooManyPrimes) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Rsa;
+    spec.bits = 2048;
+    spec.primes = 5;
+    const auto key = CryptoSigning::GenerateKey(spec);
+    EXPECT_FALSE(key.success);
+}
+
+TEST_F(KeyGenTests, MultiPrimeRsaKeyWithBlindingPool) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Rsa;
+    spec.bits = 4096;
+    spec.primes = 4;
+    auto key = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(key.success);
+    const auto expectedSignature = key.sign(dataChunk);
+    EXPECT_TRUE(key.sign.SetBlindingPoolSize(4));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(expectedSignature, key.sign(dataChunk));
+    }
+}
+
+TEST_F(KeyGenTests, KeyPoolFillsInBackground) {
+    CryptoSigning::KeyPool pool;
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    ASSERT_TRUE(pool.Configure(spec, 4, 2));
+    const auto deadline = (
+        std::chrono::steady_clock::now() + std::chrono::seconds(10)
+    );
+    while (
+        (pool.GetPoolLevel() < 4)
+        && (std::chrono::steady_clock::now() < deadline)
+    ) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(4, pool.GetPoolLevel());
+    auto key = pool.Take();
+    ExpectUsable(key);
+}
+
+TEST_F(KeyGenTests, KeyPoolTakeWhenEmpty) {
+    CryptoSigning::KeyPool pool;
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    ASSERT_TRUE(pool.Configure(spec, 0));
+    EXPECT_EQ(1, pool.GetPoolLevel());
+    auto key = pool.Take();
+    ExpectUsable(key);
+    EXPECT_EQ(0, pool.GetPoolLevel());
+    auto otherKey = pool.Take();
+    ExpectUsable(otherKey);
+    EXPECT_NE(key.privateKeyPem, otherKey.privateKeyPem);
+    EXPECT_EQ(0, pool.GetPoolLevel());
+}
+
+TEST_F(KeyGenTests, KeyPoolRejectsNoWorkers) {
+    CryptoSigning::KeyPool pool;
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    EXPECT_FALSE(pool.Configure(spec, 4, 0));
+    EXPECT_EQ(0, pool.GetPoolLevel());
+}
+
+TEST_F(KeyGenTests, KeyPoolReconfigureWhileTaking) {
+    CryptoSigning::KeyPool pool;
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    ASSERT_TRUE(pool.Configure(spec, 2));
+    std::atomic< bool > stop(false);
+    std::thread taker(
+        [&]{
+            while (!stop) {
+                auto key = pool.Take();
+                ExpectUsable(key);
+            }
+        }
+    );
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(pool.Configure(spec, 2));
+    }
+    stop = true;
+    taker.join();
+}
+
+TEST_F(KeyGenTests, KeyPoolHandsOutDistinctKeys) {
+    CryptoSigning::KeyPool pool;
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    ASSERT_TRUE(pool.Configure(spec, 8));
+    std::vector< std::string > keys;
+    for (size_t i = 0; i < 16; ++i) {
+        keys.push_back(pool.Take().privateKeyPem);
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        for (size_t j = i + 1; j < keys.size(); ++j) {
+            EXPECT_NE(keys[i], keys[j]);
+        }
+    }
+}
+
+TEST_F(KeyGenTests, KeyPoolRejectsKeysWhichCannotBeGenerated) {
+    CryptoSigning::KeyPool pool;
+    CryptoSigning::KeySpec spec;
+    spec.bits = 100;
+    EXPECT_FALSE(pool.Configure(spec, 4));
+    spec.bits = 2048;
+    spec.primes = 6;
+    EXPECT_FALSE(pool.Configure(spec, 4));
+    EXPECT_EQ(0, pool.GetPoolLevel());
+    EXPECT_FALSE(pool.Take().success);
+}
@@ -0,0 +1,287 @@
+/**
+ * @file LogSignTests.cpp
+ *
+ * This module contains the unit tests of the CryptoSigning::LogSign
+ * and CryptoSigning::LogVerify classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <chrono>
+#include <CryptoSigning/ChainedSign.hpp>
+#include <CryptoSigning/ChainedVerify.hpp>
+#include <CryptoSigning/LogSign.hpp>
+#include <CryptoSigning/LogVerify.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "TestKeys.hpp"
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct LogSignTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the instance used to sign checkpoints.
+     */
+    std::shared_ptr< CryptoSigning::Sign > sign = (
+        std::make_shared< CryptoSigning::Sign >()
+    );
+
+    /**
+     * This is the instance used to verify checkpoints.
+     */
+    std::shared_ptr< CryptoSigning::Verify > verify = (
+        std::make_shared< CryptoSigning::Verify >()
+    );
+
+    /**
+     * These are the entries of the test log.
+     */
+    std::vector< std::vector< uint8_t > > entries;
+
+    /**
+     * This is used to sign the test log.
+     */
+    CryptoSigning::LogSign logSign;
+
+    /**
+     * This is used to verify the test log.
+     */
+    CryptoSigning::LogVerify logVerify;
+
+    // Methods
+
+    /**
+     * This method returns the given range of entries of the test log.
+     *
+     * @param[in] first
+     *     This is the index of the first entry to return.
+     *
+     * @param[in] last
+     *     This is the index one past the last entry to return.
+     *
+     * @return
+     *     The entries are returned.
+     */
+    std::vector< std::vector< uint8_t > > Entries(
+        size_t first,
+        size_t last
+    ) const {
+        return std::vector< std::vector< uint8_t > >(
+            entries.begin() + first,
+            entries.begin() + last
+        );
+    }
+
+    /**
+     * This method appends the given range of entries of the test log
+     * to the signed log, and returns a checkpoint covering them.
+     *
+     * @param[in] first
+     *     This is the index of the first entry to append.
+     *
+     * @param[in] last
+     *     This is the index one past the last entry to append.
+     *
+     * @return
+     *     The checkpoint made after appending the entries is returned.
+     */
+    CryptoSigning::LogCheckpoint AppendEntries(
+        size_t first,
+        size_t last
+    ) {
+        for (size_t i = first; i < last; ++i) {
+            logSign.Append(entries[i]);
+        }
+        return logSign.Checkpoint();
+    }
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+        ASSERT_TRUE(verify->Configure(TestKeys::publicKey));
+        for (size_t i = 0; i < 20; ++i) {
+            const std::string entry = "Audit event " + std::to_string(i);
+            entries.emplace_back(entry.begin(), entry.end());
+        }
+        logSign.Configure(sign);
+        logVerify.Configure(verify);
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(LogSignTests, VerifyOnlyNewEntriesAfterCheckpoint) {
+    const auto first = AppendEntries(0, 10);
+    EXPECT_EQ(10, first.entries);
+    EXPECT_EQ(10, logSign.GetEntries());
+    ASSERT_TRUE(logVerify(Entries(0, 10), first));
+    EXPECT_EQ(10, logVerify.GetVerifiedEntries());
+    const auto second = AppendEntries(10, 15);
+    ASSERT_TRUE(logVerify(Entries(10, 15), second));
+    EXPECT_EQ(15, logVerify.GetVerifiedEntries());
+    const auto lastVerified = logVerify.GetLastVerifiedCheckpoint();
+    EXPECT_EQ(second.entries, lastVerified.entries);
+    EXPECT_EQ(second.digest, lastVerified.digest);
+    EXPECT_EQ(second.signature, lastVerified.signature);
+}
+
+TEST_F(LogSignTests, NoNewEntries) {
+    const auto checkpoint = AppendEntries(0, 5);
+    ASSERT_TRUE(logVerify(Entries(0, 5), checkpoint));
+    EXPECT_TRUE(logVerify({}, logSign.Checkpoint()));
+    EXPECT_EQ(5, logVerify.GetVerifiedEntries());
+}
+
+TEST_F(LogSignTests, TamperedNewEntry) {
+    ASSERT_TRUE(logVerify(Entries(0, 10), AppendEntries(0, 10)));
+    const auto checkpoint = AppendEntries(10, 15);
+    auto newEntries = Entries(10, 15);
+    newEntries[2][0] ^= 0x01;
+    EXPECT_FALSE(logVerify(newEntries, checkpoint));
+    EXPECT_EQ(10, logVerify.GetVerifiedEntries());
+    EXPECT_TRUE(logVerify(Entries(10, 15), checkpoint));
+}
+
+TEST_F(LogSignTests, RewrittenHistory) {
+    ASSERT_TRUE(logVerify(Entries(0, 10), AppendEntries(0, 10)));
+    CryptoSigning::LogSign rewrittenLog;
+    rewrittenLog.Configure(sign);
+    for (size_t i = 0; i < 15; ++i) {
+        auto entry = entries[i];
+        if (i == 3) {
+            entry[0] ^= 0x01;
+        }
+        rewrittenLog.Append(entry);
+    }
+    EXPECT_FALSE(logVerify(Entries(10, 15), rewrittenLog.Checkpoint()));
+    EXPECT_EQ(10, logVerify.GetVerifiedEntries());
+}
+
+TEST_F(LogSignTests, WrongNumberOfNewEntries) {
+    ASSERT_TRUE(logVerify(Entries(0, 10), AppendEntries(0, 10)));
+    const auto checkpoint = AppendEntries(10, 15);
+    EXPECT_FALSE(logVerify(Entries(10, 14), checkpoint));
+    EXPECT_FALSE(logVerify(Entries(9, 15), checkpoint));
+    EXPECT_FALSE(logVerify({}, CryptoSigning::LogCheckpoint()));
+    EXPECT_EQ(10, logVerify.GetVerifiedEntries());
+}
+
+TEST_F(LogSignTests, BadSignature) {
+    auto checkpoint = AppendEntries(0, 10);
+    checkpoint.signature[0] ^= 0x01;
+    EXPECT_FALSE(logVerify(Entries(0, 10), checkpoint));
+    EXPECT_EQ(0, logVerify.GetVerifiedEntries());
+}
+
+TEST_F(LogSignTests, NotConfigured) {
+    const auto checkpoint = AppendEntries(0, 10);
+    CryptoSigning::LogVerify unconfigured;
+    EXPECT_FALSE(unconfigured(Entries(0, 10), checkpoint));
+    CryptoSigning::LogSign unconfiguredSign;
+    EXPECT_TRUE(unconfiguredSign.Checkpoint().signature.empty());
+}
+
+TEST_F(LogSignTests, SerializeAndParse) {
+    const auto checkpoint = AppendEntries(0, 10);
+    const auto encoding = checkpoint.Serialize();
+    const std::string context = "CryptoSigning log checkpoint v1";
+    ASSERT_EQ(
+        context.size() + 1 + 8 + 32 + checkpoint.signature.size(),
+        encoding.size()
+    );
+    EXPECT_EQ(
+        context,
+        std::string(encoding.begin(), encoding.begin() + context.size())
+    );
+    EXPECT_EQ(0, encoding[context.size()]);
+    CryptoSigning::LogCheckpoint parsed;
+    ASSERT_TRUE(parsed.Parse(encoding));
+    EXPECT_EQ(checkpoint.entries, parsed.entries);
+    EXPECT_EQ(checkpoint.digest, parsed.digest);
+    EXPECT_EQ(checkpoint.signature, parsed.signature);
+    EXPECT_TRUE(logVerify(Entries(0, 10), parsed));
+    EXPECT_FALSE(
+        parsed.Parse(
+            std::vector< uint8_t >(
+                encoding.begin(),
+                encoding.begin() + context.size() + 1 + 8 + 32
+            )
+        )
+    );
+    auto wrongContext = encoding;
+    wrongContext[0] ^= 1;
+    EXPECT_FALSE(parsed.Parse(wrongContext));
+    EXPECT_EQ(checkpoint.entries, parsed.entries);
+    EXPECT_FALSE(parsed.Parse({}));
+}
+
+TEST_F(LogSignTests, ResumeVerificationFromRecordedCheckpoint) {
+    ASSERT_TRUE(logVerify(Entries(0, 10), AppendEntries(0, 10)));
+    const auto recorded = logVerify.GetLastVerifiedCheckpoint().Serialize();
+    CryptoSigning::LogCheckpoint checkpoint;
+    ASSERT_TRUE(checkpoint.Parse(recorded));
+    CryptoSigning::LogVerify resumed;
+    resumed.Configure(verify);
+    auto forged = checkpoint;
+    forged.entries = 9;
+    EXPECT_FALSE(resumed.Resume(forged));
+    EXPECT_EQ(0, resumed.GetVerifiedEntries());
+    ASSERT_TRUE(resumed.Resume(checkpoint));
+    EXPECT_EQ(10, resumed.GetVerifiedEntries());
+    EXPECT_TRUE(resumed(Entries(10, 20), AppendEntries(10, 20)));
+    EXPECT_EQ(20, resumed.GetVerifiedEntries());
+}
+
+TEST_F(LogSignTests, ResumeSigningFromCheckpoint) {
+    const auto checkpoint = AppendEntries(0, 10);
+    CryptoSigning::LogSign resumed;
+    resumed.Configure(sign);
+    EXPECT_FALSE(resumed.Resume(CryptoSigning::LogCheckpoint()));
+    ASSERT_TRUE(resumed.Resume(checkpoint));
+    for (size_t i = 10; i < 15; ++i) {
+        resumed.Append(entries[i]);
+    }
+    EXPECT_EQ(15, resumed.GetEntries());
+    const auto expected = AppendEntries(10, 15);
+    const auto actual = resumed.Checkpoint();
+    EXPECT_EQ(expected.digest, actual.digest);
+    EXPECT_TRUE(logVerify(Entries(0, 15), actual));
+}
+
+TEST_F(LogSignTests, StreamSignaturesNotAcceptedAsCheckpoints) {
+    auto checkpoint = AppendEntries(0, 10);
+    CryptoSigning::ChainedSign chainedSign;
+    chainedSign.Configure(sign, 0, std::chrono::milliseconds(0));
+    std::vector< uint8_t > streamSignature;
+    for (size_t i = 0; i < 10; ++i) {
+        (void)chainedSign(entries[i], streamSignature);
+    }
+    ASSERT_EQ(
+        CryptoSigning::ChainedSign::Status::Signed,
+        chainedSign.Flush(streamSignature)
+    );
+    auto forged = checkpoint;
+    forged.signature = streamSignature;
+    EXPECT_FALSE(logVerify(Entries(0, 10), forged));
+    CryptoSigning::ChainedVerify chainedVerify;
+    chainedVerify.Configure(verify);
+    for (size_t i = 0; i < 10; ++i) {
+        (void)chainedVerify(entries[i]);
+    }
+    EXPECT_EQ(
+        CryptoSigning::ChainedVerify::Status::Failed,
+        chainedVerify.Checkpoint(checkpoint.signature)
+    );
+}
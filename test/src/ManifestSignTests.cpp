@@ -0,0 +1,273 @@
+/**
+ * @file ManifestSignTests.cpp
+ *
+ * This module contains the unit tests of the CryptoSigning::ManifestSign
+ * and CryptoSigning::ManifestVerify classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <chrono>
+#include <CryptoSigning/ManifestSign.hpp>
+#include <CryptoSigning/ManifestVerify.hpp>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <openssl/sha.h>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestKeys.hpp"
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct ManifestSignTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the instance used to make signatures.
+     */
+    std::shared_ptr< CryptoSigning::Sign > sign = (
+        std::make_shared< CryptoSigning::Sign >()
+    );
+
+    /**
+     * This is the instance used to verify signatures.
+     */
+    std::shared_ptr< CryptoSigning::Verify > verify = (
+        std::make_shared< CryptoSigning::Verify >()
+    );
+
+    /**
+     * This is the manifest signer under test.
+     */
+    CryptoSigning::ManifestSign manifestSign;
+
+    /**
+     * This is the manifest verifier under test.
+     */
+    CryptoSigning::ManifestVerify manifestVerify;
+
+    // Methods
+
+    /**
+     * This method makes the given number of distinct test items.
+     *
+     * @param[in] count
+     *     This is the number of items to make.
+     *
+     * @return
+     *     The test items are returned.
+     */
+    static std::vector< std::vector< uint8_t > > MakeItems(size_t count) {
+        std::vector< std::vector< uint8_t > > items;
+        for (size_t i = 0; i < count; ++i) {
+            const std::string item = "Item " + std::to_string(i);
+            items.emplace_back(item.begin(), item.end());
+        }
+        return items;
+    }
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+        ASSERT_TRUE(verify->Configure(TestKeys::publicKey));
+        manifestSign.Configure(sign);
+        manifestVerify.Configure(verify);
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(ManifestSignTests, EveryItemVerifiesForManySizes) {
+    for (size_t count = 1; count <= 17; ++count) {
+        const auto items = MakeItems(count);
+        const auto proofs = manifestSign(items);
+        ASSERT_EQ(count, proofs.size());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(i, proofs[i].index);
+            EXPECT_EQ(count, proofs[i].size);
+            EXPECT_TRUE(manifestVerify(items[i], proofs[i])) << count << ":" << i;
+        }
+    }
+}
+
+TEST_F(ManifestSignTests, OneSignaturePerManifest) {
+    const auto proofs = manifestSign(MakeItems(8));
+    ASSERT_EQ(8, proofs.size());
+    for (const auto& proof: proofs) {
+        EXPECT_EQ(proofs[0].signature, proof.signature);
+        EXPECT_EQ(3, proof.path.size());
+    }
+}
+
+TEST_F(ManifestSignTests, AddAndFlush) {
+    const auto items = MakeItems(5);
+    std::vector< std::future< CryptoSigning::ManifestProof > > futureProofs;
+    for (const auto& item: items) {
+        futureProofs.push_back(manifestSign.Add(item));
+    }
+    const auto proofs = manifestSign.Flush();
+    ASSERT_EQ(items.size(), proofs.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_TRUE(manifestVerify(items[i], proofs[i]));
+        const auto proof = futureProofs[i].get();
+        EXPECT_EQ(i, proof.index);
+        EXPECT_TRUE(manifestVerify(items[i], proof));
+    }
+    EXPECT_TRUE(manifestSign.Flush().empty());
+    auto proof = manifestSign.Add(items[0]);
+    ASSERT_EQ(1, manifestSign.Flush().size());
+    EXPECT_EQ(0, proof.get().index);
+}
+
+TEST_F(ManifestSignTests, AddFromManyThreads) {
+    const auto items = MakeItems(40);
+    std::vector< std::future< CryptoSigning::ManifestProof > > futureProofs(
+        items.size()
+    );
+    std::vector< std::thread > adders;
+    for (size_t i = 0; i < 4; ++i) {
+        adders.emplace_back(
+            [&, i]{
+                for (size_t j = i; j < items.size(); j += 4) {
+                    futureProofs[j] = manifestSign.Add(items[j]);
+                    if (j % 7 == 0) {
+                        (void)manifestSign.Flush();
+                    }
+                }
+            }
+        );
+    }
+    for (auto& adder: adders) {
+        adder.join();
+    }
+    (void)manifestSign.Flush();
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_TRUE(manifestVerify(items[i], futureProofs[i].get())) << i;
+    }
+}
+
+TEST_F(ManifestSignTests, SignWhenMaxItemsReached) {
+    manifestSign.Configure(sign, 3);
+    const auto items = MakeItems(3);
+    auto first = manifestSign.Add(items[0]);
+    auto second = manifestSign.Add(items[1]);
+    EXPECT_EQ(
+        std::future_status::timeout,
+        first.wait_for(std::chrono::milliseconds(0))
+    );
+    auto third = manifestSign.Add(items[2]);
+    ASSERT_EQ(
+        std::future_status::ready,
+        first.wait_for(std::chrono::milliseconds(0))
+    );
+    EXPECT_TRUE(manifestVerify(items[0], first.get()));
+    EXPECT_TRUE(manifestVerify(items[1], second.get()));
+    EXPECT_TRUE(manifestVerify(items[2], third.get()));
+}
+
+TEST_F(ManifestSignTests, SignAfterMaxDelay) {
+    manifestSign.Configure(sign, 0, std::chrono::milliseconds(20));
+    const auto items = MakeItems(2);
+    auto first = manifestSign.Add(items[0]);
+    auto second = manifestSign.Add(items[1]);
+    ASSERT_EQ(
+        std::future_status::ready,
+        second.wait_for(std::chrono::seconds(10))
+    );
+    EXPECT_TRUE(manifestVerify(items[0], first.get()));
+    EXPECT_TRUE(manifestVerify(items[1], second.get()));
+}
+
+TEST_F(ManifestSignTests, FailureToSignReportedToAdders) {
+    CryptoSigning::ManifestSign unconfigured;
+    const auto items = MakeItems(2);
+    auto first = unconfigured.Add(items[0]);
+    auto second = unconfigured.Add(items[1]);
+    EXPECT_TRUE(unconfigured.Flush().empty());
+    const auto proof = second.get();
+    EXPECT_TRUE(proof.signature.empty());
+    EXPECT_EQ(1, proof.index);
+    EXPECT_EQ(2, proof.size);
+    EXPECT_TRUE(first.get().signature.empty());
+}
+
+TEST_F(ManifestSignTests, PendingItemsSignedOnDestruction) {
+    auto proof = manifestSign.Add(MakeItems(1)[0]);
+    manifestSign = CryptoSigning::ManifestSign();
+    EXPECT_TRUE(manifestVerify(MakeItems(1)[0], proof.get()));
+}
+
+TEST_F(ManifestSignTests, WrongItemDoesNotVerify) {
+    const auto items = MakeItems(6);
+    const auto proofs = manifestSign(items);
+    EXPECT_FALSE(manifestVerify(items[1], proofs[2]));
+    const std::string other = "Not in the manifest";
+    EXPECT_FALSE(
+        manifestVerify(
+            std::vector< uint8_t >(other.begin(), other.end()),
+            proofs[0]
+        )
+    );
+}
+
+TEST_F(ManifestSignTests, TamperedProofDoesNotVerify) {
+    const auto items = MakeItems(6);
+    const auto proofs = manifestSign(items);
+    auto proof = proofs[3];
+    proof.path[0][0] ^= 1;
+    EXPECT_FALSE(manifestVerify(items[3], proof));
+    proof = proofs[3];
+    proof.index = 7;
+    EXPECT_FALSE(manifestVerify(items[3], proof));
+    proof = proofs[3];
+    proof.size = 7;
+    EXPECT_FALSE(manifestVerify(items[3], proof));
+    proof = proofs[3];
+    proof.path.pop_back();
+    EXPECT_FALSE(manifestVerify(items[3], proof));
+    proof = proofs[3];
+    proof.signature[0] ^= 1;
+    EXPECT_FALSE(manifestVerify(items[3], proof));
+}
+
+TEST_F(ManifestSignTests, SignWhenNotConfigured) {
+    CryptoSigning::ManifestSign unconfigured;
+    EXPECT_TRUE(unconfigured(MakeItems(3)).empty());
+}
+
+TEST_F(ManifestSignTests, SignNoItems) {
+    EXPECT_TRUE(manifestSign({}).empty());
+    EXPECT_TRUE(manifestSign.Flush().empty());
+}
+
+TEST_F(ManifestSignTests, OnlyLabelledRootSignaturesVerify) {
+    // The root of a manifest of one item is the item's leaf hash.
+    const auto item = MakeItems(1)[0];
+    std::vector< uint8_t > leafInput(1, 0x00);
+    leafInput.insert(leafInput.end(), item.begin(), item.end());
+    std::vector< uint8_t > root(SHA256_DIGEST_LENGTH);
+    (void)SHA256(leafInput.data(), leafInput.size(), root.data());
+    std::vector< uint8_t > unlabelled(7, 0x00);
+    unlabelled.push_back(0x01);
+    unlabelled.insert(unlabelled.end(), root.begin(), root.end());
+    CryptoSigning::ManifestProof proof;
+    proof.size = 1;
+    proof.signature = (*sign)(unlabelled);
+    EXPECT_FALSE(manifestVerify(item, proof));
+    const std::string context = "CryptoSigning manifest root v1";
+    std::vector< uint8_t > labelled(context.begin(), context.end());
+    labelled.push_back(0x00);
+    labelled.insert(labelled.end(), unlabelled.begin(), unlabelled.end());
+    proof.signature = (*sign)(labelled);
+    EXPECT_TRUE(manifestVerify(item, proof));
+}
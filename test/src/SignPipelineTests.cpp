@@ -0,0 +1,162 @@
+/**
+ * @file SignPipelineTests.cpp
+ *
+ * This module contains the unit tests of the
+ * CryptoSigning::SignPipeline class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "TestKeys.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <CryptoSigning/KeyGen.hpp>
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/SignPipeline.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct SignPipelineTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the configured instance used by the pipeline to sign data.
+     */
+    std::shared_ptr< CryptoSigning::Sign > sign = (
+        std::make_shared< CryptoSigning::Sign >()
+    );
+
+    /**
+     * This is the unit under test.
+     */
+    CryptoSigning::SignPipeline pipeline;
+
+    // Methods
+
+    /**
+     * This method returns a data chunk which differs for each index.
+     *
+     * @param[in] index
+     *     This is the index of the data chunk.
+     *
+     * @return
+     *     The data chunk is returned.
+     */
+    static std::vector< uint8_t > MakeData(size_t index) {
+        const auto data = "message " + std::to_string(index);
+        return std::vector< uint8_t >(data.begin(), data.end());
+    }
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(SignPipelineTests, SignaturesComeOutInOrder) {
+    constexpr size_t numMessages = 50;
+    pipeline.Start(sign, 4);
+    std::thread producer(
+        [this]{
+            for (size_t i = 0; i < numMessages; ++i) {
+                ASSERT_TRUE(pipeline.Push(MakeData(i)));
+            }
+        }
+    );
+    for (size_t i = 0; i < numMessages; ++i) {
+        std::vector< uint8_t > signature;
+        ASSERT_TRUE(pipeline.Pop(signature));
+        EXPECT_EQ((*sign)(MakeData(i)), signature) << i;
+    }
+    producer.join();
+}
+
+TEST_F(SignPipelineTests, PushWaitsWhenPipelineFull) {
+    constexpr size_t queueCapacity = 2;
+    constexpr size_t numMessages = 30;
+    pipeline.Start(sign, queueCapacity);
+    std::atomic< size_t > pushed(0);
+    std::thread producer(
+        [&]{
+            for (size_t i = 0; i < numMessages; ++i) {
+                if (!pipeline.Push(MakeData(i))) {
+                    break;
+                }
+                ++pushed;
+            }
+        }
+    );
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // Each of the three queues can be full, and each of the two stages
+    // can be holding one more item.
+    EXPECT_LE(pushed, 3 * queueCapacity + 2);
+    for (size_t i = 0; i < numMessages; ++i) {
+        std::vector< uint8_t > signature;
+        ASSERT_TRUE(pipeline.Pop(signature));
+    }
+    producer.join();
+    EXPECT_EQ(numMessages, pushed);
+}
+
+TEST_F(SignPipelineTests, StopReleasesWaitingThreads) {
+    pipeline.Start(sign, 1);
+    std::atomic< bool > pushFailed(false);
+    std::thread producer(
+        [&]{
+            for (size_t i = 0; i < 100; ++i) {
+                if (!pipeline.Push(MakeData(i))) {
+                    pushFailed = true;
+                    break;
+                }
+            }
+        }
+    );
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pipeline.Stop();
+    producer.join();
+    EXPECT_TRUE(pushFailed);
+    std::vector< uint8_t > signature;
+    EXPECT_FALSE(pipeline.Pop(signature));
+    EXPECT_FALSE(pipeline.Push(MakeData(0)));
+}
+
+TEST_F(SignPipelineTests, NotStarted) {
+    std::vector< uint8_t > signature;
+    EXPECT_FALSE(pipeline.Push(MakeData(0)));
+    EXPECT_FALSE(pipeline.Pop(signature));
+}
+
+TEST_F(SignPipelineTests, KeyWhichCannotSignDigests) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Ed25519;
+    auto key = CryptoSigning::GenerateKey(spec);
+    if (!key.success) {
+        GTEST_SKIP() << "Ed25519 keys are not supported by this build";
+    }
+    auto edSign = std::make_shared< CryptoSigning::Sign >(std::move(key.sign));
+    pipeline.Start(edSign);
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pipeline.Push(MakeData(i)));
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        std::vector< uint8_t > signature;
+        ASSERT_TRUE(pipeline.Pop(signature));
+        EXPECT_TRUE(key.verify(MakeData(i), signature));
+    }
+}
@@ -0,0 +1,164 @@
+/**
+ * @file SignSchedulerTests.cpp
+ *
+ * This module contains the unit tests of the
+ * CryptoSigning::SignScheduler class.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include "TestKeys.hpp"
+
+#include <chrono>
+#include <CryptoSigning/Sign.hpp>
+#include <CryptoSigning/SignScheduler.hpp>
+#include <CryptoSigning/Verify.hpp>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct SignSchedulerTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the configured instance used by the scheduler to sign data.
+     */
+    std::shared_ptr< CryptoSigning::Sign > sign = (
+        std::make_shared< CryptoSigning::Sign >()
+    );
+
+    /**
+     * This is used to check signatures made by the scheduler.
+     */
+    CryptoSigning::Verify verify;
+
+    /**
+     * This is the unit under test.
+     */
+    CryptoSigning::SignScheduler scheduler;
+
+    /**
+     * This is the data to sign.
+     */
+    const std::vector< uint8_t > data{'H', 'e', 'l', 'l', 'o'};
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+        ASSERT_TRUE(verify.Configure(TestKeys::publicKey));
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(SignSchedulerTests, SignAtEachPriority) {
+    scheduler.Start(sign, 2);
+    const CryptoSigning::SignPriority priorities[] = {
+        CryptoSigning::SignPriority::Urgent,
+        CryptoSigning::SignPriority::Normal,
+        CryptoSigning::SignPriority::Bulk,
+    };
+    for (const auto priority: priorities) {
+        auto result = scheduler.Submit(data, priority).get();
+        EXPECT_EQ(CryptoSigning::SignStatus::Signed, result.status);
+        EXPECT_TRUE(verify(data, result.signature));
+        const auto metrics = scheduler.GetMetrics(priority);
+        EXPECT_EQ(1, metrics.signedCount);
+        EXPECT_EQ(0, metrics.deadlineMissedCount);
+        EXPECT_EQ(0, metrics.failedCount);
+        EXPECT_EQ(0, metrics.queueDepth);
+    }
+}
+
+TEST_F(SignSchedulerTests, UrgentRequestsTakenBeforeBulkRequests) {
+    std::vector< std::future< CryptoSigning::SignResult > > bulk;
+    for (size_t i = 0; i < 3; ++i) {
+        bulk.push_back(
+            scheduler.Submit(data, CryptoSigning::SignPriority::Bulk)
+        );
+    }
+    auto urgent = scheduler.Submit(data, CryptoSigning::SignPriority::Urgent);
+    EXPECT_EQ(
+        3,
+        scheduler.GetMetrics(CryptoSigning::SignPriority::Bulk).queueDepth
+    );
+    EXPECT_EQ(
+        1,
+        scheduler.GetMetrics(CryptoSigning::SignPriority::Urgent).queueDepth
+    );
+    scheduler.Start(sign, 1);
+    const auto urgentResult = urgent.get();
+    ASSERT_EQ(CryptoSigning::SignStatus::Signed, urgentResult.status);
+    for (auto& future: bulk) {
+        const auto bulkResult = future.get();
+        ASSERT_EQ(CryptoSigning::SignStatus::Signed, bulkResult.status);
+        EXPECT_GT(bulkResult.waitTime, urgentResult.waitTime);
+    }
+    const auto metrics = scheduler.GetMetrics(
+        CryptoSigning::SignPriority::Bulk
+    );
+    EXPECT_EQ(0, metrics.queueDepth);
+    EXPECT_EQ(3, metrics.signedCount);
+    EXPECT_GT(metrics.maxWaitTime, urgentResult.waitTime);
+    EXPECT_LE(metrics.meanWaitTime, metrics.maxWaitTime);
+}
+
+TEST_F(SignSchedulerTests, RequestPastDeadlineDropped) {
+    auto expired = scheduler.Submit(
+        data,
+        CryptoSigning::SignPriority::Normal,
+        std::chrono::steady_clock::now() - std::chrono::milliseconds(1)
+    );
+    auto current = scheduler.Submit(
+        data,
+        CryptoSigning::SignPriority::Normal,
+        std::chrono::steady_clock::now() + std::chrono::hours(1)
+    );
+    scheduler.Start(sign, 1);
+    const auto expiredResult = expired.get();
+    EXPECT_EQ(
+        CryptoSigning::SignStatus::DeadlineMissed,
+        expiredResult.status
+    );
+    EXPECT_TRUE(expiredResult.signature.empty());
+    const auto currentResult = current.get();
+    EXPECT_EQ(CryptoSigning::SignStatus::Signed, currentResult.status);
+    EXPECT_TRUE(verify(data, currentResult.signature));
+    const auto metrics = scheduler.GetMetrics(
+        CryptoSigning::SignPriority::Normal
+    );
+    EXPECT_EQ(1, metrics.signedCount);
+    EXPECT_EQ(1, metrics.deadlineMissedCount);
+}
+
+TEST_F(SignSchedulerTests, StopCancelsQueuedRequests) {
+    auto result = scheduler.Submit(data);
+    scheduler.Stop();
+    EXPECT_EQ(CryptoSigning::SignStatus::Cancelled, result.get().status);
+    EXPECT_EQ(
+        0,
+        scheduler.GetMetrics(CryptoSigning::SignPriority::Normal).queueDepth
+    );
+}
+
+TEST_F(SignSchedulerTests, SignFailsWithoutKey) {
+    scheduler.Start(std::make_shared< CryptoSigning::Sign >(), 1);
+    const auto result = scheduler.Submit(data).get();
+    EXPECT_EQ(CryptoSigning::SignStatus::Failed, result.status);
+    EXPECT_TRUE(result.signature.empty());
+    EXPECT_EQ(
+        1,
+        scheduler.GetMetrics(CryptoSigning::SignPriority::Normal).failedCount
+    );
+}
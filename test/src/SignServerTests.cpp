@@ -0,0 +1,299 @@
+/**
+ * @file SignServerTests.cpp
+ *
+ * This module contains the unit tests of the CryptoSigning::SignServer
+ * and CryptoSigning::SignClient classes.
+ *
+ * © 2018 by Richard Walters
+ */
+
+#include <CryptoSigning/SignClient.hpp>
+#include <CryptoSigning/SignServer.hpp>
+#include <CryptoSigning/Verify.hpp>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <string.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#include "TestKeys.hpp"
+
+namespace {
+
+    /**
+     * This function appends to the given buffer a raw request frame
+     * asking the server to sign the given data with the given key.
+     *
+     * @param[in] id
+     *     This is the identifier of the request.
+     *
+     * @param[in] keyName
+     *     This is the name of the key to use.
+     *
+     * @param[in] data
+     *     This is the data to sign.
+     *
+     * @param[in,out] buffer
+     *     This is the buffer to which to append the frame.
+     */
+    void EncodeRawRequest(
+        uint32_t id,
+        const std::string& keyName,
+        const std::string& data,
+        std::vector< uint8_t >& buffer
+    ) {
+        const auto payloadSize = (uint32_t)(4 + 1 + keyName.size() + data.size());
+        for (auto shift = 24; shift >= 0; shift -= 8) {
+            buffer.push_back((uint8_t)(payloadSize >> shift));
+        }
+        for (auto shift = 24; shift >= 0; shift -= 8) {
+            buffer.push_back((uint8_t)(id >> shift));
+        }
+        buffer.push_back((uint8_t)keyName.size());
+        buffer.insert(buffer.end(), keyName.begin(), keyName.end());
+        buffer.insert(buffer.end(), data.begin(), data.end());
+    }
+
+}
+
+/**
+ * This is the test fixture for these tests, providing common
+ * setup and teardown for each test.
+ */
+struct SignServerTests
+    : public ::testing::Test
+{
+    // Properties
+
+    /**
+     * This is the temporary directory holding the server's socket.
+     */
+    std::string directory;
+
+    /**
+     * This is the path of the server's socket.
+     */
+    std::string socketPath;
+
+    /**
+     * This is the server under test.
+     */
+    CryptoSigning::SignServer server;
+
+    /**
+     * This is the client under test.
+     */
+    CryptoSigning::SignClient client;
+
+    /**
+     * This is used to verify signatures made by the server.
+     */
+    CryptoSigning::Verify verify;
+
+    /**
+     * This is the test data to sign.
+     */
+    std::vector< uint8_t > dataChunk;
+
+    // Methods
+
+    // ::testing::Test
+
+    virtual void SetUp() {
+        char directoryTemplate[] = "/tmp/CryptoSigningTestsXXXXXX";
+        ASSERT_FALSE(mkdtemp(directoryTemplate) == NULL);
+        directory = directoryTemplate;
+        socketPath = directory + "/sign.sock";
+        auto sign = std::make_shared< CryptoSigning::Sign >();
+        ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+        ASSERT_TRUE(server.AddKey("test", sign));
+        ASSERT_TRUE(verify.Configure(TestKeys::publicKey));
+        const std::string data = "Hello, World!";
+        dataChunk.assign(
+            data.begin(),
+            data.end()
+        );
+    }
+
+    virtual void TearDown() {
+        client.Disconnect();
+        server.Stop();
+        (void)rmdir(directory.c_str());
+    }
+};
+
+TEST_F(SignServerTests, SignOneRequest) {
+    ASSERT_TRUE(server.Start(socketPath, 2));
+    ASSERT_TRUE(client.Connect(socketPath));
+    const auto signature = client("test", dataChunk).get();
+    EXPECT_TRUE(verify(dataChunk, signature));
+}
+
+TEST_F(SignServerTests, SignManyPipelinedRequests) {
+    ASSERT_TRUE(server.Start(socketPath, 3));
+    ASSERT_TRUE(client.Connect(socketPath));
+    std::vector< std::vector< uint8_t > > dataChunks;
+    std::vector< std::future< std::vector< uint8_t > > > signatures;
+    for (size_t i = 0; i < 50; ++i) {
+        const std::string data = "Message " + std::to_string(i);
+        dataChunks.emplace_back(data.begin(), data.end());
+        signatures.push_back(client("test", dataChunks.back()));
+    }
+    for (size_t i = 0; i < dataChunks.size(); ++i) {
+        EXPECT_TRUE(verify(dataChunks[i], signatures[i].get())) << i;
+    }
+}
+
+TEST_F(SignServerTests, SignBatch) {
+    ASSERT_TRUE(server.Start(socketPath, 2));
+    ASSERT_TRUE(client.Connect(socketPath));
+    std::vector< std::vector< uint8_t > > dataChunks;
+    for (size_t i = 0; i < 20; ++i) {
+        const std::string data = "Message " + std::to_string(i);
+        dataChunks.emplace_back(data.begin(), data.end());
+    }
+    auto signatures = client.SignBatch("test", dataChunks);
+    ASSERT_EQ(dataChunks.size(), signatures.size());
+    for (size_t i = 0; i < dataChunks.size(); ++i) {
+        EXPECT_TRUE(verify(dataChunks[i], signatures[i].get())) << i;
+    }
+}
+
+TEST_F(SignServerTests, UnknownKeyGivesEmptySignature) {
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    ASSERT_TRUE(client.Connect(socketPath));
+    EXPECT_TRUE(client("nope", dataChunk).get().empty());
+    EXPECT_TRUE(verify(dataChunk, client("test", dataChunk).get()));
+}
+
+TEST_F(SignServerTests, ConnectWhenServerNotStarted) {
+    EXPECT_FALSE(client.Connect(socketPath));
+    EXPECT_TRUE(client("test", dataChunk).get().empty());
+}
+
+TEST_F(SignServerTests, RequestsFailAfterServerStops) {
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    ASSERT_TRUE(client.Connect(socketPath));
+    EXPECT_FALSE(client("test", dataChunk).get().empty());
+    server.Stop();
+    EXPECT_TRUE(client("test", dataChunk).get().empty());
+}
+
+TEST_F(SignServerTests, SocketRemovedWhenServerStops) {
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    EXPECT_EQ(0, access(socketPath.c_str(), F_OK));
+    server.Stop();
+    EXPECT_NE(0, access(socketPath.c_str(), F_OK));
+}
+
+TEST_F(SignServerTests, ClientWhichDoesNotReadDoesNotStallOthers) {
+    ASSERT_TRUE(server.Start(socketPath, 1));
+
+    // Flood the server with requests from a client which never reads
+    // its responses, and which has a small receive buffer, so that
+    // the server can't send them.
+    const auto sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(sock, 0);
+    const int receiveBufferSize = 4096;
+    (void)setsockopt(
+        sock,
+        SOL_SOCKET,
+        SO_RCVBUF,
+        &receiveBufferSize,
+        sizeof(receiveBufferSize)
+    );
+    struct sockaddr_un address;
+    (void)memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    (void)memcpy(address.sun_path, socketPath.data(), socketPath.size());
+    ASSERT_EQ(
+        0,
+        connect(sock, (const struct sockaddr*)&address, sizeof(address))
+    );
+    std::vector< uint8_t > requests;
+    for (uint32_t id = 0; id < 1000; ++id) {
+        EncodeRawRequest(id, "test", "Message " + std::to_string(id), requests);
+    }
+    size_t sent = 0;
+    while (sent < requests.size()) {
+        const auto amount = send(
+            sock,
+            requests.data() + sent,
+            requests.size() - sent,
+            MSG_DONTWAIT
+        );
+        if (amount <= 0) {
+            break;
+        }
+        sent += (size_t)amount;
+    }
+
+    // Another client should still be served promptly.
+    ASSERT_TRUE(client.Connect(socketPath));
+    auto signature = client("test", dataChunk);
+    ASSERT_EQ(
+        std::future_status::ready,
+        signature.wait_for(std::chrono::seconds(10))
+    );
+    EXPECT_TRUE(verify(dataChunk, signature.get()));
+    (void)close(sock);
+}
+
+TEST_F(SignServerTests, OverlongKeyNameRejected) {
+    const std::string longName(256, 'k');
+    auto sign = std::make_shared< CryptoSigning::Sign >();
+    ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+    ASSERT_TRUE(server.AddKey(longName.substr(0, 255), sign));
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    ASSERT_TRUE(client.Connect(socketPath));
+    EXPECT_TRUE(client(longName, dataChunk).get().empty());
+    const auto signature = client(longName.substr(0, 255), dataChunk).get();
+    EXPECT_TRUE(verify(dataChunk, signature));
+}
+
+TEST_F(SignServerTests, AddKeyRejectedWhileStarted) {
+    auto sign = std::make_shared< CryptoSigning::Sign >();
+    ASSERT_TRUE(sign->Configure(TestKeys::unencryptedKey));
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    EXPECT_FALSE(server.AddKey("other", sign));
+    EXPECT_FALSE(server.SetErrorDelegate([](const std::string&){}));
+    ASSERT_TRUE(client.Connect(socketPath));
+    EXPECT_TRUE(client("other", dataChunk).get().empty());
+    server.Stop();
+    EXPECT_TRUE(server.AddKey("other", sign));
+}
+
+TEST_F(SignServerTests, SocketOnlyAccessibleToOwner) {
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    struct stat status;
+    ASSERT_EQ(0, lstat(socketPath.c_str(), &status));
+    EXPECT_TRUE(S_ISSOCK(status.st_mode));
+    EXPECT_EQ(S_IRUSR | S_IWUSR, status.st_mode & 0777);
+}
+
+TEST_F(SignServerTests, StartLeavesOtherFilesAlone) {
+    const auto file = fopen(socketPath.c_str(), "w");
+    ASSERT_FALSE(file == NULL);
+    (void)fclose(file);
+    EXPECT_FALSE(server.Start(socketPath, 1));
+    struct stat status;
+    ASSERT_EQ(0, lstat(socketPath.c_str(), &status));
+    EXPECT_TRUE(S_ISREG(status.st_mode));
+    (void)unlink(socketPath.c_str());
+}
+
+TEST_F(SignServerTests, StartReplacesStaleSocket) {
+    ASSERT_TRUE(server.Start(socketPath, 1));
+    CryptoSigning::SignServer other;
+    EXPECT_TRUE(other.Start(socketPath, 1));
+    other.Stop();
+}
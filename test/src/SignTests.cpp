@@ -6,10 +6,14 @@
  * © 2018 by Richard Walters
  */
 
+#include <atomic>
+#include <CryptoSigning/KeyGen.hpp>
 #include <CryptoSigning/Sign.hpp>
 #include <gtest/gtest.h>
+#include <openssl/sha.h>
 #include <stdint.h>
 #include <string>
+#include <thread>
 #include <vector>
 
 /**
@@ -282,3 +286,138 @@ TEST_F(SignTests, SignWhenNotConfigured) {
         sign(dataChunk)
     );
 }
+
+TEST_F(SignTests, SignWithBlindingPool) {
+    (void)sign.Configure(unencryptedKey);
+    EXPECT_TRUE(sign.SetBlindingPoolSize(4));
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(
+            validSignature,
+            sign(dataChunk)
+        );
+    }
+}
+
+TEST_F(SignTests, BlindingPoolCarriesOverToNewKey) {
+    EXPECT_FALSE(sign.SetBlindingPoolSize(4));
+    (void)sign.Configure(encryptedKey, correctPassphrase);
+    EXPECT_EQ(
+        validSignature,
+        sign(dataChunk)
+    );
+    EXPECT_TRUE(sign.SetBlindingPoolSize(2));
+}
+
+TEST_F(SignTests, TurnOffBlindingPool) {
+    (void)sign.Configure(unencryptedKey);
+    EXPECT_TRUE(sign.SetBlindingPoolSize(4));
+    EXPECT_TRUE(sign.SetBlindingPoolSize(0));
+    EXPECT_EQ(
+        validSignature,
+        sign(dataChunk)
+    );
+}
+
+TEST_F(SignTests, RotateKeysWhileSigning) {
+    CryptoSigning::KeySpec spec;
+    auto newKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(newKey.success);
+    ASSERT_TRUE(sign.Configure(unencryptedKey));
+    std::atomic< bool > stop(false);
+    std::atomic< size_t > failures(0);
+    std::vector< std::thread > signers;
+    for (size_t i = 0; i < 2; ++i) {
+        signers.emplace_back(
+            [&]{
+                while (!stop) {
+                    const auto signature = sign(dataChunk);
+                    if (
+                        (signature != validSignature)
+                        && !newKey.verify(dataChunk, signature)
+                    ) {
+                        ++failures;
+                    }
+                }
+            }
+        );
+    }
+    for (size_t i = 0; i < 50; ++i) {
+        if (i % 2 == 0) {
+            ASSERT_TRUE(sign.Configure(newKey.privateKeyPem));
+        } else {
+            ASSERT_TRUE(sign.Configure(unencryptedKey));
+        }
+        (void)sign.SetBlindingPoolSize(i % 3);
+    }
+    stop = true;
+    for (auto& signer: signers) {
+        signer.join();
+    }
+    EXPECT_EQ(0, failures);
+}
+
+TEST_F(SignTests, ChangeSettingsWhileConfiguring) {
+    std::atomic< bool > stop(false);
+    std::thread changer(
+        [&]{
+            for (size_t i = 0; !stop; ++i) {
+                (void)sign.SetBackend("");
+                (void)sign.SetBlindingPoolSize(i % 2);
+            }
+        }
+    );
+    for (size_t i = 0; i < 20; ++i) {
+        EXPECT_TRUE(sign.Configure(unencryptedKey));
+    }
+    stop = true;
+    changer.join();
+    EXPECT_EQ(validSignature, sign(dataChunk));
+}
+
+TEST_F(SignTests, SignDigestMatchesSign) {
+    (void)sign.Configure(unencryptedKey);
+    std::vector< uint8_t > digest(SHA256_DIGEST_LENGTH);
+    (void)SHA256(dataChunk.data(), dataChunk.size(), digest.data());
+    EXPECT_EQ(validSignature, sign.SignDigest(digest));
+    EXPECT_TRUE(sign.SetBlindingPoolSize(4));
+    EXPECT_EQ(validSignature, sign.SignDigest(digest));
+    digest.pop_back();
+    EXPECT_TRUE(sign.SignDigest(digest).empty());
+}
+
+TEST_F(SignTests, SignDigestNotSupportedByEd25519) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Ed25519;
+    auto key = CryptoSigning::GenerateKey(spec);
+    if (!key.success) {
+        GTEST_SKIP() << "Ed25519 keys are not supported by this build";
+    }
+    std::vector< uint8_t > digest(SHA256_DIGEST_LENGTH);
+    (void)SHA256(dataChunk.data(), dataChunk.size(), digest.data());
+    EXPECT_TRUE(key.sign.SignDigest(digest).empty());
+}
+
+TEST_F(SignTests, SignWithEach) {
+    (void)sign.Configure(unencryptedKey);
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    auto ecKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(ecKey.success);
+    spec.type = CryptoSigning::KeyType::Ed25519;
+    auto edKey = CryptoSigning::GenerateKey(spec);
+    if (!edKey.success) {
+        GTEST_SKIP() << "Ed25519 keys are not supported by this build";
+    }
+    CryptoSigning::Sign unconfigured;
+    const auto signatures = CryptoSigning::Sign::SignWithEach(
+        {&sign, &ecKey.sign, &edKey.sign, &unconfigured, nullptr},
+        dataChunk,
+        2
+    );
+    ASSERT_EQ(5, signatures.size());
+    EXPECT_EQ(validSignature, signatures[0]);
+    EXPECT_TRUE(ecKey.verify(dataChunk, signatures[1]));
+    EXPECT_TRUE(edKey.verify(dataChunk, signatures[2]));
+    EXPECT_TRUE(signatures[3].empty());
+    EXPECT_TRUE(signatures[4].empty());
+}
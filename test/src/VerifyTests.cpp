@@ -6,12 +6,224 @@
  * © 2018 by Richard Walters
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <CryptoSigning/Backends.hpp>
+#include <CryptoSigning/KeyGen.hpp>
+#include <CryptoSigning/Sign.hpp>
 #include <CryptoSigning/Verify.hpp>
+#include <functional>
 #include <gtest/gtest.h>
+#include <memory>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/sha.h>
 #include <stdint.h>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "TestKeys.hpp"
+
+namespace {
+
+    /**
+     * This function encodes the given data in unpadded base64url.
+     *
+     * @param[in] data
+     *     This is the data to encode.
+     *
+     * @return
+     *     The unpadded base64url encoding of the data is returned.
+     */
+    std::string Base64UrlEncode(const std::vector< uint8_t >& data) {
+        const char alphabet[] = (
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+            "abcdefghijklmnopqrstuvwxyz"
+            "0123456789-_"
+        );
+        std::string output;
+        uint32_t bits = 0;
+        size_t numBits = 0;
+        for (const auto byte: data) {
+            bits = (bits << 8) | byte;
+            numBits += 8;
+            while (numBits >= 6) {
+                numBits -= 6;
+                output.push_back(alphabet[(bits >> numBits) & 0x3f]);
+            }
+        }
+        if (numBits > 0) {
+            output.push_back(alphabet[(bits << (6 - numBits)) & 0x3f]);
+        }
+        return output;
+    }
+
+    /**
+     * This is the type of smart pointer used to hold keys read
+     * directly with libcrypto.
+     */
+    typedef std::unique_ptr<
+        EVP_PKEY,
+        std::function< void(EVP_PKEY*) >
+    > Key;
+
+    /**
+     * This function reads the given key directly with libcrypto.
+     *
+     * @param[in] pem
+     *     This is the key in PEM format.
+     *
+     * @param[in] isPrivate
+     *     This indicates whether or not the key is a private key.
+     *
+     * @return
+     *     The key is returned, or nullptr if it could not be read.
+     */
+    Key ReadKey(
+        const std::string& pem,
+        bool isPrivate
+    ) {
+        const auto bio = BIO_new_mem_buf(pem.data(), (int)pem.size());
+        Key key(
+            (
+                isPrivate
+                ? PEM_read_bio_PrivateKey(bio, NULL, NULL, NULL)
+                : PEM_read_bio_PUBKEY(bio, NULL, NULL, NULL)
+            ),
+            [](EVP_PKEY* p){
+                EVP_PKEY_free(p);
+            }
+        );
+        BIO_free(bio);
+        return key;
+    }
+
+    /**
+     * This function verifies the given RSA PKCS#1 v1.5 SHA-256 signature
+     * through the generic libcrypto interface, as a reference against
+     * which to check Verify.
+     *
+     * @param[in] key
+     *     This is the public key to use.
+     *
+     * @param[in] data
+     *     This is the signed data.
+     *
+     * @param[in] signature
+     *     This is the signature to verify.
+     *
+     * @return
+     *     An indication of whether or not libcrypto considers the
+     *     signature valid is returned.
+     */
+    bool VerifyWithLibcrypto(
+        EVP_PKEY* key,
+        const std::vector< uint8_t >& data,
+        const std::vector< uint8_t >& signature
+    ) {
+        const auto ctx = EVP_MD_CTX_new();
+        const auto valid = (
+            (EVP_DigestVerifyInit(ctx, NULL, EVP_sha256(), NULL, key) == 1)
+            && (EVP_DigestVerifyUpdate(ctx, data.data(), data.size()) == 1)
+            && (
+                EVP_DigestVerifyFinal(
+                    ctx,
+                    signature.data(),
+                    signature.size()
+                ) == 1
+            )
+        );
+        EVP_MD_CTX_free(ctx);
+        return valid;
+    }
+
+    /**
+     * This function applies the raw RSA private-key operation to the
+     * given message representative, without any padding, in order to
+     * make signatures with arbitrary (and possibly malformed) encodings.
+     *
+     * @param[in] key
+     *     This is the private key to use.
+     *
+     * @param[in] message
+     *     This is the message representative, which must be the same
+     *     length as the modulus.
+     *
+     * @return
+     *     The signature is returned.
+     */
+    std::vector< uint8_t > SignRaw(
+        EVP_PKEY* key,
+        const std::vector< uint8_t >& message
+    ) {
+        const auto ctx = EVP_PKEY_CTX_new(key, NULL);
+        size_t signatureLength = message.size();
+        std::vector< uint8_t > signature(signatureLength);
+        if (
+            (EVP_PKEY_sign_init(ctx) != 1)
+            || (EVP_PKEY_CTX_set_rsa_padding(ctx, RSA_NO_PADDING) != 1)
+            || (
+                EVP_PKEY_sign(
+                    ctx,
+                    signature.data(),
+                    &signatureLength,
+                    message.data(),
+                    message.size()
+                ) != 1
+            )
+        ) {
+            signature.clear();
+        }
+        EVP_PKEY_CTX_free(ctx);
+        return signature;
+    }
+
+    /**
+     * This function makes an EMSA-PKCS1-v1_5 style message representative
+     * from the given parts.
+     *
+     * @param[in] length
+     *     This is the length, in bytes, of the modulus.
+     *
+     * @param[in] blockType
+     *     This is the block type byte which follows the leading zero.
+     *
+     * @param[in] digestInfo
+     *     This is the encoding of the digest algorithm which
+     *     precedes the digest.
+     *
+     * @param[in] digest
+     *     This is the digest.
+     *
+     * @return
+     *     The message representative is returned.
+     */
+    std::vector< uint8_t > MakeMessageRepresentative(
+        size_t length,
+        uint8_t blockType,
+        const std::vector< uint8_t >& digestInfo,
+        const std::vector< uint8_t >& digest
+    ) {
+        std::vector< uint8_t > message(length, 0xff);
+        message[0] = 0x00;
+        message[1] = blockType;
+        const auto tailLength = digestInfo.size() + digest.size();
+        message[length - tailLength - 1] = 0x00;
+        std::copy(
+            digestInfo.begin(),
+            digestInfo.end(),
+            message.end() - tailLength
+        );
+        std::copy(digest.begin(), digest.end(), message.end() - digest.size());
+        return message;
+    }
+
+}
+
 /**
  * This is the test fixture for these tests, providing common
  * setup and teardown for each test.
@@ -252,6 +464,31 @@ struct VerifyTests
 
     virtual void TearDown() {
     }
+
+    /**
+     * This method makes a JSON Web Signature in compact serialization
+     * for the given payload, signed with the test private key.
+     *
+     * @param[in] payload
+     *     This is the payload to sign.
+     *
+     * @return
+     *     The token is returned.
+     */
+    std::string MakeJws(const std::string& payload) {
+        const std::string header = "{\"alg\":\"RS256\",\"typ\":\"JWT\"}";
+        const auto signingInput = (
+            Base64UrlEncode(std::vector< uint8_t >(header.begin(), header.end()))
+            + "."
+            + Base64UrlEncode(std::vector< uint8_t >(payload.begin(), payload.end()))
+        );
+        CryptoSigning::Sign sign;
+        (void)sign.Configure(privateKey);
+        const auto signature = sign(
+            std::vector< uint8_t >(signingInput.begin(), signingInput.end())
+        );
+        return signingInput + "." + Base64UrlEncode(signature);
+    }
 };
 
 TEST_F(VerifyTests, ConfigureValidKey) {
@@ -280,6 +517,26 @@ TEST_F(VerifyTests, VerifyValidSignatureUsingModulusExponent) {
     EXPECT_TRUE(verify(dataChunk, validSignature));
 }
 
+TEST_F(VerifyTests, UnusableModulusExponentRemovesPreviousKey) {
+    // Only the libcrypto backend, listed last, handles RSA keys, so
+    // configuring an RSA key with any other backend fails.
+    auto backendNames = CryptoSigning::GetBackendNames();
+    backendNames.pop_back();
+    if (backendNames.empty()) {
+        GTEST_SKIP() << "no backend other than libcrypto is built in";
+    }
+    for (const auto& backendName: backendNames) {
+        CryptoSigning::Verify otherVerify;
+        ASSERT_TRUE(otherVerify.Configure(key));
+        ASSERT_TRUE(otherVerify.SetBackend(backendName));
+        otherVerify.Configure(
+            modulus, sizeof(modulus),
+            exponent, sizeof(exponent)
+        );
+        EXPECT_FALSE(otherVerify(dataChunk, validSignature)) << backendName;
+    }
+}
+
 TEST_F(VerifyTests, VerifyValidSignatureNotConfigured) {
     EXPECT_FALSE(verify(dataChunk, validSignature));
 }
@@ -290,3 +547,456 @@ TEST_F(VerifyTests, VerifyInvalidSignatureWhenConfigured) {
     invalidSignature[8] ^= 0x55;
     EXPECT_FALSE(verify(dataChunk, invalidSignature));
 }
+
+TEST_F(VerifyTests, VerifyValidSignatureFromPointers) {
+    (void)verify.Configure(key);
+    EXPECT_TRUE(
+        verify(
+            dataChunk.data(), dataChunk.size(),
+            validSignature.data(), validSignature.size()
+        )
+    );
+}
+
+TEST_F(VerifyTests, VerifyValidJwsCompact) {
+    (void)verify.Configure(key);
+    const auto token = MakeJws("{\"sub\":\"1234567890\"}");
+    EXPECT_TRUE(verify.VerifyJwsCompact(token));
+    EXPECT_TRUE(verify.VerifyJwsCompact(token.data(), token.size()));
+}
+
+TEST_F(VerifyTests, VerifyJwsCompactNotConfigured) {
+    const auto token = MakeJws("{\"sub\":\"1234567890\"}");
+    EXPECT_FALSE(verify.VerifyJwsCompact(token));
+}
+
+TEST_F(VerifyTests, VerifyJwsCompactTamperedPayload) {
+    (void)verify.Configure(key);
+    auto token = MakeJws("{\"sub\":\"1234567890\"}");
+    const auto firstPeriod = token.find('.');
+    token[firstPeriod + 2] = ((token[firstPeriod + 2] == 'A') ? 'B' : 'A');
+    EXPECT_FALSE(verify.VerifyJwsCompact(token));
+}
+
+TEST_F(VerifyTests, VerifyJwsCompactTamperedSignature) {
+    (void)verify.Configure(key);
+    auto token = MakeJws("{\"sub\":\"1234567890\"}");
+    const auto secondPeriod = token.rfind('.');
+    token[secondPeriod + 2] = ((token[secondPeriod + 2] == 'A') ? 'B' : 'A');
+    EXPECT_FALSE(verify.VerifyJwsCompact(token));
+}
+
+TEST_F(VerifyTests, VerifyJwsCompactMalformed) {
+    (void)verify.Configure(key);
+    const auto token = MakeJws("{\"sub\":\"1234567890\"}");
+    const auto firstPeriod = token.find('.');
+    const auto secondPeriod = token.rfind('.');
+    const std::vector< std::string > malformedTokens{
+        "",
+        "..",
+        token.substr(0, secondPeriod),
+        token.substr(firstPeriod),
+        token + ".",
+        token + "=",
+        token.substr(0, token.size() - 1),
+        token + "A",
+        token.substr(0, firstPeriod) + "=" + token.substr(firstPeriod),
+        token.substr(0, firstPeriod) + "+" + token.substr(firstPeriod + 1),
+        token.substr(0, secondPeriod + 1) + "/" + token.substr(secondPeriod + 2),
+    };
+    for (const auto& malformedToken: malformedTokens) {
+        EXPECT_FALSE(verify.VerifyJwsCompact(malformedToken)) << malformedToken;
+    }
+}
+
+TEST_F(VerifyTests, VerifyBatchMatchesSingleVerify) {
+    const std::vector< std::string > keys{privateKey, TestKeys::unencryptedKey};
+    for (const auto& keyPem: keys) {
+        CryptoSigning::Sign sign;
+        ASSERT_TRUE(sign.Configure(keyPem));
+        ASSERT_TRUE(verify.Configure(keyPem));
+        std::vector< std::vector< uint8_t > > dataChunks;
+        std::vector< std::vector< uint8_t > > signatures;
+        std::vector< bool > expectedResults;
+        for (size_t i = 0; i < 21; ++i) {
+            std::vector< uint8_t > data(dataChunk);
+            data.push_back((uint8_t)i);
+            auto signature = sign(data);
+            bool valid = true;
+            switch (i % 7) {
+                case 1: {
+                    signature[signature.size() / 2] ^= 0x01;
+                    valid = false;
+                } break;
+
+                case 3: {
+                    data[0] ^= 0x01;
+                    valid = false;
+                } break;
+
+                case 4: {
+                    signature.pop_back();
+                    valid = false;
+                } break;
+
+                case 5: {
+                    signature.assign(signature.size(), 0xff);
+                    valid = false;
+                } break;
+
+                default: break;
+            }
+            dataChunks.push_back(data);
+            signatures.push_back(signature);
+            expectedResults.push_back(valid);
+        }
+        const auto results = verify.VerifyBatch(dataChunks, signatures);
+        ASSERT_EQ(expectedResults.size(), results.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            EXPECT_EQ(expectedResults[i], results[i]) << i;
+            EXPECT_EQ(verify(dataChunks[i], signatures[i]), results[i]) << i;
+        }
+    }
+}
+
+TEST_F(VerifyTests, VerifyBatchRejectsSignatureAboveLimbRange) {
+    // A 2130-bit modulus is held in 41 limbs of 52 bits (2132 bits), while
+    // its signatures are 267 bytes (2136 bits) long, so a signature can
+    // have bits set beyond the limbs.
+    CryptoSigning::KeySpec spec;
+    spec.bits = 2130;
+    auto generatedKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(generatedKey.success);
+    ASSERT_TRUE(verify.Configure(generatedKey.publicKeyPem));
+    const auto signature = generatedKey.sign(dataChunk);
+    ASSERT_EQ(267, signature.size());
+    auto oversized = signature;
+    oversized[0] |= 0x10;
+    EXPECT_FALSE(verify(dataChunk, oversized));
+    EXPECT_EQ(
+        std::vector< bool >({true, false}),
+        verify.VerifyBatch({dataChunk, dataChunk}, {signature, oversized})
+    );
+}
+
+TEST_F(VerifyTests, VerifyBatchMissingSignatures) {
+    (void)verify.Configure(key);
+    const auto results = verify.VerifyBatch(
+        {dataChunk, dataChunk, dataChunk},
+        {validSignature}
+    );
+    EXPECT_EQ(
+        std::vector< bool >({true, false, false}),
+        results
+    );
+}
+
+TEST_F(VerifyTests, VerifyBatchNotConfigured) {
+    EXPECT_EQ(
+        std::vector< bool >({false, false}),
+        verify.VerifyBatch({dataChunk, dataChunk}, {validSignature, validSignature})
+    );
+}
+
+TEST_F(VerifyTests, VerifyBatchUsingModulusExponent) {
+    (void)verify.Configure(
+        modulus, sizeof(modulus),
+        exponent, sizeof(exponent)
+    );
+    auto invalidSignature(validSignature);
+    invalidSignature[0] ^= 0x01;
+    EXPECT_EQ(
+        std::vector< bool >({true, false, true}),
+        verify.VerifyBatch(
+            {dataChunk, dataChunk, dataChunk},
+            {validSignature, invalidSignature, validSignature}
+        )
+    );
+}
+
+TEST_F(VerifyTests, VerifyBatchNonRsaKey) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    auto generatedKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(generatedKey.success);
+    ASSERT_TRUE(verify.Configure(generatedKey.publicKeyPem));
+    const auto signature = generatedKey.sign(dataChunk);
+    auto otherData(dataChunk);
+    otherData.push_back('!');
+    EXPECT_EQ(
+        std::vector< bool >({true, false}),
+        verify.VerifyBatch({dataChunk, otherData}, {signature, signature})
+    );
+}
+
+TEST_F(VerifyTests, RotationGracePeriodAcceptsPreviousKey) {
+    CryptoSigning::KeySpec spec;
+    auto newKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(newKey.success);
+    const auto oldSignature = validSignature;
+    const auto newSignature = newKey.sign(dataChunk);
+    const auto oldToken = MakeJws("{\"sub\":\"1234567890\"}");
+    verify.SetRotationGracePeriod(std::chrono::hours(1));
+    ASSERT_TRUE(verify.Configure(key));
+    ASSERT_TRUE(verify.Configure(newKey.publicKeyPem));
+    EXPECT_TRUE(verify(dataChunk, newSignature));
+    EXPECT_TRUE(verify(dataChunk, oldSignature));
+    EXPECT_TRUE(verify.VerifyJwsCompact(oldToken));
+    EXPECT_EQ(
+        std::vector< bool >({true, true, false}),
+        verify.VerifyBatch(
+            {dataChunk, dataChunk, dataChunk},
+            {newSignature, oldSignature, {}}
+        )
+    );
+}
+
+TEST_F(VerifyTests, RotationWithoutGracePeriodRejectsPreviousKey) {
+    CryptoSigning::KeySpec spec;
+    auto newKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(newKey.success);
+    ASSERT_TRUE(verify.Configure(key));
+    ASSERT_TRUE(verify.Configure(newKey.publicKeyPem));
+    EXPECT_TRUE(verify(dataChunk, newKey.sign(dataChunk)));
+    EXPECT_FALSE(verify(dataChunk, validSignature));
+    EXPECT_FALSE(verify.VerifyJwsCompact(MakeJws("{\"sub\":\"1234567890\"}")));
+}
+
+TEST_F(VerifyTests, RotationGracePeriodExpires) {
+    CryptoSigning::KeySpec spec;
+    auto newKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(newKey.success);
+    verify.SetRotationGracePeriod(std::chrono::milliseconds(10));
+    ASSERT_TRUE(verify.Configure(key));
+    ASSERT_TRUE(verify.Configure(newKey.publicKeyPem));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(verify(dataChunk, newKey.sign(dataChunk)));
+    EXPECT_FALSE(verify(dataChunk, validSignature));
+}
+
+TEST_F(VerifyTests, RotateKeysWhileVerifying) {
+    CryptoSigning::KeySpec spec;
+    auto newKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(newKey.success);
+    const auto newSignature = newKey.sign(dataChunk);
+    verify.SetRotationGracePeriod(std::chrono::hours(1));
+    ASSERT_TRUE(verify.Configure(key));
+    ASSERT_TRUE(verify.Configure(newKey.publicKeyPem));
+    std::atomic< bool > stop(false);
+    std::atomic< size_t > failures(0);
+    std::vector< std::thread > verifiers;
+    for (size_t i = 0; i < 2; ++i) {
+        verifiers.emplace_back(
+            [&]{
+                while (!stop) {
+                    if (
+                        !verify(dataChunk, validSignature)
+                        || !verify(dataChunk, newSignature)
+                    ) {
+                        ++failures;
+                    }
+                }
+            }
+        );
+    }
+    for (size_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(verify.Configure((i % 2 == 0) ? key : newKey.publicKeyPem));
+    }
+    stop = true;
+    for (auto& verifier: verifiers) {
+        verifier.join();
+    }
+    EXPECT_EQ(0, failures);
+}
+
+TEST_F(VerifyTests, ChangeSettingsWhileConfiguring) {
+    std::atomic< bool > stop(false);
+    std::thread changer(
+        [&]{
+            for (size_t i = 0; !stop; ++i) {
+                (void)verify.SetBackend("");
+                verify.SetRotationGracePeriod(std::chrono::milliseconds(i % 2));
+            }
+        }
+    );
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_TRUE(verify.Configure(key));
+    }
+    stop = true;
+    changer.join();
+    EXPECT_TRUE(verify(dataChunk, validSignature));
+}
+
+TEST_F(VerifyTests, VerifyDigest) {
+    (void)verify.Configure(key);
+    std::vector< uint8_t > digest(SHA256_DIGEST_LENGTH);
+    (void)SHA256(dataChunk.data(), dataChunk.size(), digest.data());
+    EXPECT_TRUE(verify.VerifyDigest(digest, validSignature));
+    auto badSignature = validSignature;
+    badSignature[0] ^= 0x01;
+    EXPECT_FALSE(verify.VerifyDigest(digest, badSignature));
+    digest[0] ^= 0x01;
+    EXPECT_FALSE(verify.VerifyDigest(digest, validSignature));
+}
+
+TEST_F(VerifyTests, VerifyDigestNotSupportedByEd25519) {
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::Ed25519;
+    auto edKey = CryptoSigning::GenerateKey(spec);
+    if (!edKey.success) {
+        GTEST_SKIP() << "Ed25519 keys are not supported by this build";
+    }
+    std::vector< uint8_t > digest(SHA256_DIGEST_LENGTH);
+    (void)SHA256(dataChunk.data(), dataChunk.size(), digest.data());
+    EXPECT_FALSE(edKey.verify.VerifyDigest(digest, edKey.sign(dataChunk)));
+}
+
+TEST_F(VerifyTests, VerifyWithEach) {
+    (void)verify.Configure(key);
+    CryptoSigning::KeySpec spec;
+    spec.type = CryptoSigning::KeyType::EcP256;
+    auto ecKey = CryptoSigning::GenerateKey(spec);
+    ASSERT_TRUE(ecKey.success);
+    spec.type = CryptoSigning::KeyType::Ed25519;
+    auto edKey = CryptoSigning::GenerateKey(spec);
+    if (!edKey.success) {
+        GTEST_SKIP() << "Ed25519 keys are not supported by this build";
+    }
+    CryptoSigning::Verify unconfigured;
+    const auto ecSignature = ecKey.sign(dataChunk);
+    const auto edSignature = edKey.sign(dataChunk);
+    EXPECT_EQ(
+        std::vector< bool >({true, true, true, false}),
+        CryptoSigning::Verify::VerifyWithEach(
+            {&verify, &ecKey.verify, &edKey.verify, &unconfigured},
+            dataChunk,
+            {validSignature, ecSignature, edSignature, validSignature},
+            2
+        )
+    );
+    EXPECT_EQ(
+        std::vector< bool >({false, false, false}),
+        CryptoSigning::Verify::VerifyWithEach(
+            {&verify, &ecKey.verify, &edKey.verify},
+            dataChunk,
+            {ecSignature, validSignature}
+        )
+    );
+}
+
+TEST_F(VerifyTests, RsaPublicKeyOperationMatchesLibcrypto) {
+    const std::vector< uint8_t > sha256Info{
+        0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+        0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20
+    };
+    const std::vector< uint8_t > sha256InfoWithoutNull{
+        0x30, 0x2f, 0x30, 0x0b, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+        0x65, 0x03, 0x04, 0x02, 0x01, 0x04, 0x20
+    };
+    const std::vector< uint8_t > sha512Info{
+        0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+        0x65, 0x03, 0x04, 0x02, 0x03, 0x05, 0x00, 0x04, 0x20
+    };
+    for (const auto bits: {2048, 3072}) {
+        CryptoSigning::KeySpec spec;
+        spec.bits = bits;
+        auto generatedKey = CryptoSigning::GenerateKey(spec);
+        ASSERT_TRUE(generatedKey.success);
+        const auto publicKey = ReadKey(generatedKey.publicKeyPem, false);
+        const auto privateKey = ReadKey(generatedKey.privateKeyPem, true);
+        ASSERT_TRUE(publicKey != nullptr);
+        ASSERT_TRUE(privateKey != nullptr);
+        const auto length = (size_t)EVP_PKEY_size(publicKey.get());
+        ASSERT_TRUE(verify.Configure(generatedKey.publicKeyPem));
+        std::vector< std::vector< uint8_t > > dataChunks;
+        std::vector< std::vector< uint8_t > > signatures;
+        const auto addCase = [&](
+            const std::vector< uint8_t >& data,
+            const std::vector< uint8_t >& signature
+        ){
+            dataChunks.push_back(data);
+            signatures.push_back(signature);
+        };
+        for (const auto size: {0, 1, 64, 300, 4096}) {
+            const std::vector< uint8_t > data((size_t)size, (uint8_t)size);
+            const auto signature = generatedKey.sign(data);
+            addCase(data, signature);
+            for (const auto position: {(size_t)0, length / 2, length - 1}) {
+                auto badSignature = signature;
+                badSignature[position] ^= 0x01;
+                addCase(data, badSignature);
+            }
+            auto otherData = data;
+            otherData.push_back(0x00);
+            addCase(otherData, signature);
+            addCase(data, std::vector< uint8_t >(signature.begin() + 1, signature.end()));
+            auto longSignature = signature;
+            longSignature.insert(longSignature.begin(), 0x00);
+            addCase(data, longSignature);
+        }
+        const auto data = dataChunk;
+        std::vector< uint8_t > digest(SHA256_DIGEST_LENGTH);
+        (void)SHA256(data.data(), data.size(), digest.data());
+        addCase(data, {});
+        addCase(data, std::vector< uint8_t >(length, 0x00));
+        addCase(data, std::vector< uint8_t >(length, 0xff));
+        std::vector< uint8_t > one(length, 0x00);
+        one.back() = 0x01;
+        addCase(data, one);
+        addCase(
+            data,
+            SignRaw(
+                privateKey.get(),
+                MakeMessageRepresentative(length, 0x01, sha256Info, digest)
+            )
+        );
+        addCase(
+            data,
+            SignRaw(
+                privateKey.get(),
+                MakeMessageRepresentative(length, 0x02, sha256Info, digest)
+            )
+        );
+        addCase(
+            data,
+            SignRaw(
+                privateKey.get(),
+                MakeMessageRepresentative(length, 0x01, sha256InfoWithoutNull, digest)
+            )
+        );
+        addCase(
+            data,
+            SignRaw(
+                privateKey.get(),
+                MakeMessageRepresentative(length, 0x01, sha512Info, digest)
+            )
+        );
+        auto shortPadding = MakeMessageRepresentative(
+            length,
+            0x01,
+            sha256Info,
+            digest
+        );
+        shortPadding.erase(shortPadding.begin() + 2, shortPadding.begin() + 10);
+        shortPadding.insert(shortPadding.end(), 8, 0x00);
+        addCase(data, SignRaw(privateKey.get(), shortPadding));
+        for (size_t i = 0; i < dataChunks.size(); ++i) {
+            const auto expected = VerifyWithLibcrypto(
+                publicKey.get(),
+                dataChunks[i],
+                signatures[i]
+            );
+            EXPECT_EQ(expected, verify(dataChunks[i], signatures[i]))
+                << bits << " bits, case " << i;
+            std::vector< uint8_t > caseDigest(SHA256_DIGEST_LENGTH);
+            (void)SHA256(
+                dataChunks[i].data(),
+                dataChunks[i].size(),
+                caseDigest.data()
+            );
+            EXPECT_EQ(expected, verify.VerifyDigest(caseDigest, signatures[i]))
+                << bits << " bits, case " << i;
+        }
+        EXPECT_TRUE(VerifyWithLibcrypto(publicKey.get(), dataChunks[0], signatures[0]));
+    }
+}